@@ -47,7 +47,7 @@ string(TOLOWER ${YODA_PLATFORM_STRING} platform)
 string(TOLOWER ${CMAKE_CXX_COMPILER_ID} compiler)
 set(compiler "${compiler}-${CMAKE_CXX_COMPILER_VERSION}")
 set(DAWN_FULL_VERSION_STR 
-    "${DAWN_VERSION}-${SDAWN_GIT_HASH}-${architecture}-${platform}-${compiler}"
+    "${DAWN_VERSION}-${DAWN_GIT_HASH}-${architecture}-${platform}-${compiler}"
     CACHE STRING "Full version string of Dawn" FORCE)
 
 mark_as_advanced(DAWN_FULL_VERSION_STR)
@@ -26,6 +26,7 @@ option(DAWN_PYTHON "Build and install the Python module" ON)
 
 # Testing
 option(DAWN_TESTING "Enable testing" ON)
+option(DAWN_BENCHMARKS "Build the micro-benchmarks (requires DAWN_TESTING)" OFF)
 
 # Documentation
 option(DAWN_DOCUMENTATION "Enable documentation" OFF)
@@ -35,5 +36,6 @@ yoda_export_options(DAWN
   DAWN_ASSERTS 
   DAWN_USE_CCACHE
   DAWN_TESTING
+  DAWN_BENCHMARKS
   DAWN_DOCUMENTATION
 )
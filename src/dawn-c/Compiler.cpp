@@ -16,26 +16,39 @@
 #include "dawn-c/ErrorHandling.h"
 #include "dawn-c/util/Allocate.h"
 #include "dawn-c/util/CompilerWrapper.h"
+#include "dawn-c/util/DiagnosticsWrapper.h"
 #include "dawn-c/util/OptionsWrapper.h"
+#include "dawn/Compiler/CompilationCache.h"
 #include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/Logging.h"
 #include "dawn/Support/STLExtras.h"
+#include "dawn/Support/UIDGenerator.h"
 #include "dawn/Support/Unreachable.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <memory>
-using namespace dawn::util;
+#include <thread>
+#include <vector>
 
-static DawnDiagnosticsKind getDawnDiagnosticsKind(dawn::DiagnosticsKind diag) {
-  switch(diag) {
-  case dawn::DiagnosticsKind::Note:
-    return DD_Note;
-  case dawn::DiagnosticsKind::Warning:
-    return DD_Warning;
-  case dawn::DiagnosticsKind::Error:
-    return DD_Error;
-  default:
-    dawn_unreachable("invalid dawn::DiagnosticsKind");
-  }
-}
+namespace dawn {
+
+namespace util {
+
+/// @brief Compilation running on a separate thread (see `dawnCompileAsync`)
+/// @ingroup dawn_c_util
+struct AsyncCompilation {
+  std::future<std::unique_ptr<codegen::TranslationUnit>> Result;
+  std::unique_ptr<DiagnosticsQueue> Diagnostics;
+};
+
+} // namespace util
+
+} // namespace dawn
+
+using namespace dawn::util;
 
 static void dawnDefaultDiagnosticsHandler(DawnDiagnosticsKind diag, int line, int column,
                                           const char* filename, const char* msg) {
@@ -67,38 +80,109 @@ void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler) {
   DiagnosticsHandler = handler ? handler : dawnDefaultDiagnosticsHandler;
 }
 
-dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size, const dawnOptions_t* options) {
-  dawnTranslationUnit_t* translationUnit = nullptr;
+static dawnTranslationUnit_t* makeTranslationUnit(dawn::codegen::TranslationUnit&& TU) {
+  dawnTranslationUnit_t* translationUnit = allocate<dawnTranslationUnit_t>();
+  translationUnit->Impl = new dawn::codegen::TranslationUnit(std::move(TU));
+  translationUnit->OwnsData = 1;
+  return translationUnit;
+}
+
+static dawnDiagnostics_t* makeDiagnostics(std::unique_ptr<dawn::DiagnosticsQueue> queue) {
+  dawnDiagnostics_t* diagnostics = allocate<dawnDiagnostics_t>();
+  diagnostics->Impl = queue.release();
+  diagnostics->OwnsData = 1;
+  return diagnostics;
+}
+
+static dawn::Options makeOptions(const dawnOptions_t* options) {
+  dawn::Options compileOptions;
+  if(options)
+    toConstOptionsWrapper(options)->setDawnOptions(&compileOptions);
+  return compileOptions;
+}
+
+/// @brief Compile the SIR and append the diagnostics to `diagnostics`
+///
+/// @returns the translation unit or `NULL` if the compiler reported errors, exceptions (e.g if the
+/// SIR cannot be deserialized) are propagated
+static std::unique_ptr<dawn::codegen::TranslationUnit>
+compile(const std::string& sirStr, dawn::Options compileOptions,
+        dawn::DiagnosticsQueue& diagnostics) {
+  // Every compilation draws its identifiers from the same range, starting from the deserialization
+  // of the SIR, hence the code does not depend on the compilations which ran before or run
+  // concurrently (e.g in a batch). The identifiers of different compilations never meet.
+  dawn::UIDScope uidScope(1, std::numeric_limits<int>::max() / 2);
+
+  // Consult the compilation cache (a hit skips the whole compilation and replays its diagnostics)
+  std::unique_ptr<dawn::CompilationCache> cache;
+  std::string cacheKey;
+  if(!compileOptions.CacheDir.empty() && dawn::CompilationCache::isCacheable(compileOptions)) {
+    cache = dawn::make_unique<dawn::CompilationCache>(compileOptions.CacheDir);
+    cacheKey = dawn::CompilationCache::computeKey(sirStr, compileOptions);
+
+    if(auto TU = cache->lookup(sirStr, compileOptions, diagnostics)) {
+      DAWN_LOG(INFO) << "compilation cache hit: " << cache->getEntryPath(cacheKey);
+      return TU;
+    }
+  }
 
   // Deserialize the SIR
+  auto inMemorySIR =
+      dawn::SIRSerializer::deserializeFromString(sirStr, dawn::SIRSerializer::SK_Byte);
+
+  // Run the compiler
+  dawn::DawnCompiler compiler(&compileOptions);
+  auto TU = compiler.compile(inMemorySIR);
+
+  for(const auto& diag : compiler.getDiagnostics().getQueue())
+    diagnostics.push_back(*diag);
+
+  if(!TU || compiler.getDiagnostics().hasErrors())
+    return nullptr;
+
+  // Only successful compilations are cached, a failure to do so is not fatal
+  if(cache && !cache->insert(sirStr, compileOptions, *TU, compiler.getDiagnostics().getQueue()))
+    DAWN_LOG(WARNING) << "failed to write compilation cache entry: "
+                      << cache->getEntryPath(cacheKey);
+
+  return TU;
+}
+
+/// @brief Compile the SIR and report all diagnostics, including failures, to `diagnostics`
+static std::unique_ptr<dawn::codegen::TranslationUnit>
+compileIsolated(const std::string& sirStr, const dawn::Options& compileOptions,
+                dawn::DiagnosticsQueue& diagnostics) {
+  std::unique_ptr<dawn::codegen::TranslationUnit> TU;
+  std::string failure = "compilation failed";
   try {
-    std::string sirStr(SIR, size);
-    auto inMemorySIR =
-        dawn::SIRSerializer::deserializeFromString(sirStr, dawn::SIRSerializer::SK_Byte);
+    TU = compile(sirStr, compileOptions, diagnostics);
+  } catch(std::exception& e) {
+    failure = e.what();
+  }
 
-    // Prepare options
-    std::unique_ptr<dawn::Options> compileOptions = dawn::make_unique<dawn::Options>();
-    if(options)
-      toConstOptionsWrapper(options)->setDawnOptions(compileOptions.get());
+  if(!TU && !diagnostics.hasErrors())
+    diagnostics.push_back(
+        dawn::DiagnosticsMessage(dawn::DiagnosticsKind::Error, dawn::SourceLocation(), "", failure));
+  return TU;
+}
 
-    // Run the compiler
-    dawn::DawnCompiler compiler(compileOptions.get());
-    auto TU = compiler.compile(inMemorySIR);
+dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size, const dawnOptions_t* options) {
+  dawnTranslationUnit_t* translationUnit = nullptr;
+
+  try {
+    dawn::DiagnosticsQueue diagnostics;
+    auto TU = compile(std::string(SIR, size), makeOptions(options), diagnostics);
 
     // Report diganostics
-    if(compiler.getDiagnostics().hasDiags()) {
-      for(const auto& diag : compiler.getDiagnostics().getQueue())
-        dawnReportDiagnostic(getDawnDiagnosticsKind(diag->getDiagKind()),
-                             diag->getSourceLocation().Line, diag->getSourceLocation().Column,
-                             diag->getFilename().c_str(), diag->getMessage().c_str());
-    }
+    for(const auto& diag : diagnostics)
+      dawnReportDiagnostic(toDawnDiagnosticsKind(diag->getDiagKind()),
+                           diag->getSourceLocation().Line, diag->getSourceLocation().Column,
+                           diag->getFilename().c_str(), diag->getMessage().c_str());
 
-    if(!TU || compiler.getDiagnostics().hasErrors())
+    if(!TU)
       throw std::runtime_error("compilation failed");
 
-    translationUnit = allocate<dawnTranslationUnit_t>();
-    translationUnit->Impl = new dawn::codegen::TranslationUnit(std::move(*TU.get()));
-    translationUnit->OwnsData = 1;
+    translationUnit = makeTranslationUnit(std::move(*TU.get()));
 
   } catch(std::exception& e) {
     dawnFatalError(e.what());
@@ -106,3 +190,103 @@ dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size, const dawnOptio
 
   return translationUnit;
 }
+
+int dawnCompileBatch(int numSIRs, const char* const* SIRs, const size_t* sizes,
+                     const dawnOptions_t* options, dawnTranslationUnit_t** translationUnits,
+                     dawnDiagnostics_t** diagnostics) {
+  if(numSIRs <= 0)
+    return 0;
+
+  dawn::Options compileOptions = makeOptions(options);
+
+  // The SIRs are distributed among the jobs, every compilation then runs single-threaded
+  int numJobs = compileOptions.Jobs > 0 ? compileOptions.Jobs
+                                        : static_cast<int>(std::thread::hardware_concurrency());
+  numJobs = std::max(1, std::min(numJobs, numSIRs));
+  if(numJobs > 1)
+    compileOptions.Jobs = 1;
+
+  std::vector<std::unique_ptr<dawn::codegen::TranslationUnit>> TUs(numSIRs);
+  std::vector<std::unique_ptr<dawn::DiagnosticsQueue>> queues(numSIRs);
+  std::atomic<int> nextSIR(0);
+
+  auto worker = [&]() {
+    for(int i = nextSIR++; i < numSIRs; i = nextSIR++) {
+      queues[i] = dawn::make_unique<dawn::DiagnosticsQueue>();
+      TUs[i] = compileIsolated(std::string(SIRs[i], sizes[i]), compileOptions, *queues[i]);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(int job = 1; job < numJobs; ++job)
+    workers.emplace_back(worker);
+  worker();
+  for(auto& thread : workers)
+    thread.join();
+
+  int numFailures = 0;
+  for(int i = 0; i < numSIRs; ++i) {
+    if(TUs[i]) {
+      translationUnits[i] = makeTranslationUnit(std::move(*TUs[i].get()));
+    } else {
+      translationUnits[i] = nullptr;
+      numFailures++;
+    }
+    if(diagnostics)
+      diagnostics[i] = makeDiagnostics(std::move(queues[i]));
+  }
+  return numFailures;
+}
+
+dawnCompilation_t* dawnCompileAsync(const char* SIR, size_t size, const dawnOptions_t* options) {
+  auto asyncCompilation = dawn::make_unique<AsyncCompilation>();
+  asyncCompilation->Diagnostics = dawn::make_unique<dawn::DiagnosticsQueue>();
+
+  // The thread only accesses its own copies and the diagnostics owned by the compilation
+  asyncCompilation->Result =
+      std::async(std::launch::async, compileIsolated, std::string(SIR, size), makeOptions(options),
+                 std::ref(*asyncCompilation->Diagnostics));
+
+  dawnCompilation_t* compilation = allocate<dawnCompilation_t>();
+  compilation->Impl = asyncCompilation.release();
+  compilation->OwnsData = 1;
+  return compilation;
+}
+
+static AsyncCompilation* toAsyncCompilation(const dawnCompilation_t* compilation) {
+  if(!compilation->Impl)
+    dawnFatalError("uninitialized Compilation");
+  return reinterpret_cast<AsyncCompilation*>(compilation->Impl);
+}
+
+int dawnCompilationIsReady(const dawnCompilation_t* compilation) {
+  const AsyncCompilation* asyncCompilation = toAsyncCompilation(compilation);
+  return !asyncCompilation->Result.valid() ||
+         asyncCompilation->Result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+dawnTranslationUnit_t* dawnCompilationGet(dawnCompilation_t* compilation,
+                                          dawnDiagnostics_t** diagnostics) {
+  AsyncCompilation* asyncCompilation = toAsyncCompilation(compilation);
+  if(!asyncCompilation->Result.valid()) {
+    dawnFatalError("result of the Compilation has already been retrieved");
+    return nullptr;
+  }
+
+  auto TU = asyncCompilation->Result.get();
+  if(diagnostics)
+    *diagnostics = makeDiagnostics(std::move(asyncCompilation->Diagnostics));
+  return TU ? makeTranslationUnit(std::move(*TU.get())) : nullptr;
+}
+
+void dawnCompilationDestroy(dawnCompilation_t* compilation) {
+  if(compilation) {
+    AsyncCompilation* asyncCompilation = toAsyncCompilation(compilation);
+    if(compilation->OwnsData) {
+      if(asyncCompilation->Result.valid())
+        asyncCompilation->Result.wait();
+      delete asyncCompilation;
+    }
+    std::free(compilation);
+  }
+}
@@ -55,6 +55,10 @@ extern void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler);
 /**
  * @brief Run the compiler on the byte-string serialized SIR and return the generated code
  *
+ * If the option `CacheDir` is set, the generated code is looked up in (and stored to) the
+ * compilation cache located in that directory, skipping the compilation on a cache hit. Tuned
+ * compilations (options `Autotune` or `TuningDB`) bypass the cache.
+ *
  * @param SIR         Byte string serialized data of the SIR
  * @param size        Size of the serialized SIR data
  * @param options     Options of the compilation (if `NULL` is passed the default options are used)
@@ -64,6 +68,66 @@ extern void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler);
 extern dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size,
                                           const dawnOptions_t* options);
 
+/**
+ * @brief Run the compiler on a batch of byte-string serialized SIRs
+ *
+ * The SIRs are compiled concurrently by up to `Jobs` threads (see option `Jobs`). Contrary to
+ * `dawnCompile`, every compilation reports its diagnostics, including the reason of a failure, to
+ * its own diagnostics instead of the installed DiagnosticsHandler and FatalErrorHandler, which
+ * makes it safe to call this function from multiple threads.
+ *
+ * @param[in]   numSIRs           Number of SIRs to compile
+ * @param[in]   SIRs              Array of length `numSIRs` of byte string serialized SIRs
+ * @param[in]   sizes             Array of length `numSIRs` of the sizes of the serialized SIRs
+ * @param[in]   options           Options of all compilations (if `NULL` is passed the default
+ *                                options are used)
+ * @param[out]  translationUnits  Array of length `numSIRs` which receives the translation units
+ *                                of the generated code (`NULL` for failed compilations)
+ * @param[out]  diagnostics       Array of length `numSIRs` which receives the diagnostics of each
+ *                                compilation (may be `NULL` if the diagnostics are not needed)
+ * @return Number of failed compilations
+ */
+extern int dawnCompileBatch(int numSIRs, const char* const* SIRs, const size_t* sizes,
+                            const dawnOptions_t* options, dawnTranslationUnit_t** translationUnits,
+                            dawnDiagnostics_t** diagnostics);
+
+/**
+ * @brief Start the compilation of the byte-string serialized SIR on a separate thread
+ *
+ * The SIR and the options are copied before this function returns. As in `dawnCompileBatch`, the
+ * diagnostics are reported to the diagnostics of the compilation.
+ *
+ * @param SIR         Byte string serialized data of the SIR
+ * @param size        Size of the serialized SIR data
+ * @param options     Options of the compilation (if `NULL` is passed the default options are used)
+ * @return Handle to the running compilation
+ */
+extern dawnCompilation_t* dawnCompileAsync(const char* SIR, size_t size,
+                                           const dawnOptions_t* options);
+
+/**
+ * @brief Check if the compilation has finished (without blocking)
+ */
+extern int dawnCompilationIsReady(const dawnCompilation_t* compilation);
+
+/**
+ * @brief Wait for the compilation to finish and get its result
+ *
+ * This function may only be called once per compilation.
+ *
+ * @param[in]   compilation   Compilation to wait for
+ * @param[out]  diagnostics   Receives the diagnostics of the compilation (may be `NULL` if the
+ *                            diagnostics are not needed)
+ * @return Translation unit of the generated code or `NULL` on failure
+ */
+extern dawnTranslationUnit_t* dawnCompilationGet(dawnCompilation_t* compilation,
+                                                 dawnDiagnostics_t** diagnostics);
+
+/**
+ * @brief Destroy the compilation (waits for it to finish if it is still running)
+ */
+extern void dawnCompilationDestroy(dawnCompilation_t* compilation);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -27,6 +27,7 @@
  */
 
 #include "dawn-c/DawnCompiler.h"
+#include "dawn-c/Diagnostics.h"
 #include "dawn-c/ErrorHandling.h"
 #include "dawn-c/Options.h"
 
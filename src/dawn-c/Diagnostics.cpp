@@ -0,0 +1,70 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn-c/Diagnostics.h"
+#include "dawn-c/util/Allocate.h"
+#include "dawn-c/util/DiagnosticsWrapper.h"
+
+using namespace dawn::util;
+
+void dawnDiagnosticsDestroy(dawnDiagnostics_t* diagnostics) {
+  if(diagnostics) {
+    dawn::DiagnosticsQueue* queue = toDiagnostics(diagnostics);
+    if(diagnostics->OwnsData)
+      delete queue;
+    std::free(diagnostics);
+  }
+}
+
+int dawnDiagnosticsGetNumDiagnostics(const dawnDiagnostics_t* diagnostics) {
+  return toConstDiagnostics(diagnostics)->queue().size();
+}
+
+int dawnDiagnosticsHasErrors(const dawnDiagnostics_t* diagnostics) {
+  return toConstDiagnostics(diagnostics)->hasErrors();
+}
+
+void dawnDiagnosticsGet(const dawnDiagnostics_t* diagnostics, int index,
+                        DawnDiagnosticsKind* diag, int* line, int* column, char** filename,
+                        char** msg) {
+  const auto& queue = toConstDiagnostics(diagnostics)->queue();
+  if(index < 0 || index >= static_cast<int>(queue.size()))
+    dawnFatalError("diagnostic index out of bounds");
+
+  const dawn::DiagnosticsMessage& message = *queue[index];
+  if(diag)
+    *diag = toDawnDiagnosticsKind(message.getDiagKind());
+  if(line)
+    *line = message.getSourceLocation().Line;
+  if(column)
+    *column = message.getSourceLocation().Column;
+  if(filename)
+    *filename = allocateAndCopyString(message.getFilename());
+  if(msg)
+    *msg = allocateAndCopyString(message.getMessage());
+}
+
+void dawnDiagnosticsReport(const dawnDiagnostics_t* diagnostics,
+                           dawnDiagnosticsHandler_t handler) {
+  for(const auto& message : *toConstDiagnostics(diagnostics)) {
+    DawnDiagnosticsKind diag = toDawnDiagnosticsKind(message->getDiagKind());
+    int line = message->getSourceLocation().Line;
+    int column = message->getSourceLocation().Column;
+    if(handler)
+      handler(diag, line, column, message->getFilename().c_str(), message->getMessage().c_str());
+    else
+      dawnReportDiagnostic(diag, line, column, message->getFilename().c_str(),
+                           message->getMessage().c_str());
+  }
+}
@@ -0,0 +1,79 @@
+/*===----------------------------------------------------------------------------------*- C -*-===*\
+ *                          _
+ *                         | |
+ *                       __| | __ ___      ___ ___
+ *                      / _` |/ _` \ \ /\ / / '_  |
+ *                     | (_| | (_| |\ V  V /| | | |
+ *                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+ *
+ *
+ *  This file is distributed under the MIT License (MIT).
+ *  See LICENSE.txt for details.
+ *
+\*===------------------------------------------------------------------------------------------===*/
+
+#ifndef DAWN_C_DIAGNOSTICS_H
+#define DAWN_C_DIAGNOSTICS_H
+
+#include "dawn-c/Compiler.h"
+#include "dawn-c/Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup dawn_c
+ * @{
+ */
+
+/**
+ * @brief Destroy the diagnostics
+ */
+extern void dawnDiagnosticsDestroy(dawnDiagnostics_t* diagnostics);
+
+/**
+ * @brief Get the number of diagnostics (in the order they were reported)
+ */
+extern int dawnDiagnosticsGetNumDiagnostics(const dawnDiagnostics_t* diagnostics);
+
+/**
+ * @brief Check if any of the diagnostics is an error
+ */
+extern int dawnDiagnosticsHasErrors(const dawnDiagnostics_t* diagnostics);
+
+/**
+ * @brief Get the diagnostic at position `index`
+ *
+ * Each of the output arguments may be `NULL` if the value is not needed.
+ *
+ * @param[in]   diagnostics   Diagnostics to use
+ * @param[in]   index         Index of the diagnostic in `[0, dawnDiagnosticsGetNumDiagnostics)`
+ * @param[out]  diag          Kind of the diagnostic
+ * @param[out]  line          Line in the source
+ * @param[out]  column        Column in the source
+ * @param[out]  filename      Newly allocated '\0' terminated string of the file
+ * @param[out]  msg           Newly allocated '\0' terminated string of the message
+ */
+extern void dawnDiagnosticsGet(const dawnDiagnostics_t* diagnostics, int index,
+                               DawnDiagnosticsKind* diag, int* line, int* column, char** filename,
+                               char** msg);
+
+/**
+ * @brief Pass all diagnostics (in the order they were reported) to `handler`
+ *
+ * @param diagnostics   Diagnostics to report
+ * @param handler       Diagnostics handler to invoke (if `NULL` is passed the installed
+ *                      DiagnosticsHandler is used)
+ * @see dawnInstallDiagnosticsHandler
+ */
+extern void dawnDiagnosticsReport(const dawnDiagnostics_t* diagnostics,
+                                  dawnDiagnosticsHandler_t handler);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -43,7 +43,7 @@ enum DawnTypeKind {
 enum DawnDiagnosticsKind { DD_Note, DD_Warning, DD_Error };
 
 /**
- * @brief Refrence to the Options
+ * @brief Reference to the Options
  */
 typedef struct {
   void* Impl;   /**< Pointer to the allocated dawn::Options */
@@ -51,7 +51,7 @@ typedef struct {
 } dawnOptions_t;
 
 /**
- * @brief Refrence to an entry in the Options map
+ * @brief Reference to an entry in the Options map
  */
 typedef struct {
   DawnTypeKind Type;  /**< Type of the option */
@@ -60,7 +60,7 @@ typedef struct {
 } dawnOptionsEntry_t;
 
 /**
- * @brief Refrence to the Compiler
+ * @brief Reference to the Compiler
  */
 typedef struct {
   void* Impl;   /**< Pointer to the allocated dawn::DawnCompiler */
@@ -68,13 +68,29 @@ typedef struct {
 } dawnCompiler_t;
 
 /**
- * @brief Refrence to a TranslationUnit
+ * @brief Reference to a TranslationUnit
  */
 typedef struct {
   void* Impl;   /**< Pointer to the allocated dawn::TranslationUnit */
   int OwnsData; /**< Ownership flag */
 } dawnTranslationUnit_t;
 
+/**
+ * @brief Reference to the diagnostics of a single compilation
+ */
+typedef struct {
+  void* Impl;   /**< Pointer to the allocated dawn::DiagnosticsQueue */
+  int OwnsData; /**< Ownership flag */
+} dawnDiagnostics_t;
+
+/**
+ * @brief Reference to an asynchronously running compilation
+ */
+typedef struct {
+  void* Impl;   /**< Pointer to the allocated dawn::util::AsyncCompilation */
+  int OwnsData; /**< Ownership flag */
+} dawnCompilation_t;
+
 /** @} */
 
 #ifdef __cplusplus
@@ -0,0 +1,62 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_C_UTIL_DIAGNOSTICSWRAPPER_H
+#define DAWN_C_UTIL_DIAGNOSTICSWRAPPER_H
+
+#include "dawn-c/ErrorHandling.h"
+#include "dawn-c/Types.h"
+#include "dawn/Compiler/DiagnosticsQueue.h"
+#include "dawn/Support/Unreachable.h"
+
+namespace dawn {
+
+namespace util {
+
+/// @brief Convert `dawnDiagnostics_t` to `DiagnosticsQueue`
+/// @ingroup dawn_c_util
+/// @{
+inline const DiagnosticsQueue* toConstDiagnostics(const dawnDiagnostics_t* diagnostics) {
+  if(!diagnostics->Impl)
+    dawnFatalError("uninitialized Diagnostics");
+  return reinterpret_cast<const DiagnosticsQueue*>(diagnostics->Impl);
+}
+
+inline DiagnosticsQueue* toDiagnostics(dawnDiagnostics_t* diagnostics) {
+  if(!diagnostics->Impl)
+    dawnFatalError("uninitialized Diagnostics");
+  return reinterpret_cast<DiagnosticsQueue*>(diagnostics->Impl);
+}
+/// @}
+
+/// @brief Convert `dawn::DiagnosticsKind` to `DawnDiagnosticsKind`
+/// @ingroup dawn_c_util
+inline DawnDiagnosticsKind toDawnDiagnosticsKind(DiagnosticsKind diag) {
+  switch(diag) {
+  case DiagnosticsKind::Note:
+    return DD_Note;
+  case DiagnosticsKind::Warning:
+    return DD_Warning;
+  case DiagnosticsKind::Error:
+    return DD_Error;
+  default:
+    dawn_unreachable("invalid dawn::DiagnosticsKind");
+  }
+}
+
+} // namespace util
+
+} // namespace dawn
+
+#endif
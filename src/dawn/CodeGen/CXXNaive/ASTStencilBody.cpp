@@ -18,6 +18,7 @@
 #include "dawn/IIR/StencilFunctionInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTVisitor.h"
 #include "dawn/Support/Unreachable.h"
 
 namespace dawn {
@@ -27,7 +28,8 @@ namespace cxxnaive {
 ASTStencilBody::ASTStencilBody(const iir::StencilMetaInformation& metadata,
                                StencilContext stencilContext)
     : ASTCodeGenCXX(), metadata_(metadata), offsetPrinter_(",", "(", ")"),
-      currentFunction_(nullptr), nestingOfStencilFunArgLists_(0), stencilContext_(stencilContext) {}
+      currentFunction_(nullptr), nestingOfStencilFunArgLists_(0), stencilContext_(stencilContext),
+      vectorize_(false), numMasks_(0) {}
 
 ASTStencilBody::~ASTStencilBody() {}
 
@@ -84,7 +86,118 @@ void ASTStencilBody::visit(const std::shared_ptr<BoundaryConditionDeclStmt>& stm
   DAWN_ASSERT_MSG(0, "BoundaryConditionDeclStmt not allowed in this context");
 }
 
-void ASTStencilBody::visit(const std::shared_ptr<IfStmt>& stmt) { Base::visit(stmt); }
+void ASTStencilBody::visit(const std::shared_ptr<IfStmt>& stmt) {
+  if(!vectorize_ || currentFunction_ || !isIfConvertible(stmt)) {
+    Base::visit(stmt);
+    return;
+  }
+
+  // Branches prevent the vectorization of the loop, we thus evaluate both branches and select the
+  // results. The conditions are evaluated in the order of the original statements. Every converted
+  // assignment stores to its left-hand side, the previous value if its mask is not set, and the
+  // vectorized code may load the operands of both branches at every point. This is valid as the
+  // branches are free of side-effects and the field accesses of a stage are within the halo of the
+  // storages at every point of the stage.
+  if(scopeDepth_ == 0)
+    ss_ << std::string(indent_, ' ');
+  ss_ << "{\n";
+  indent_ += DAWN_PRINT_INDENT;
+  generateMaskedStmt(stmt, "");
+  indent_ -= DAWN_PRINT_INDENT;
+  ss_ << std::string(indent_, ' ') << "}\n";
+}
+
+namespace {
+
+/// @brief Check if an expression has side-effects (assignments, increments and decrements) or calls
+/// stencil functions, whose side-effects are not known here
+class SideEffectsFinder : public ASTVisitorForwarding {
+  bool hasSideEffects_;
+
+public:
+  SideEffectsFinder() : hasSideEffects_(false) {}
+
+  virtual void visit(const std::shared_ptr<AssignmentExpr>& expr) override {
+    hasSideEffects_ = true;
+  }
+
+  virtual void visit(const std::shared_ptr<StencilFunCallExpr>& expr) override {
+    hasSideEffects_ = true;
+  }
+
+  virtual void visit(const std::shared_ptr<UnaryOperator>& expr) override {
+    const std::string op = expr->getOp();
+    if(op == "++" || op == "--")
+      hasSideEffects_ = true;
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  bool hasSideEffects() const { return hasSideEffects_; }
+};
+
+bool hasSideEffects(const std::shared_ptr<Expr>& expr) {
+  SideEffectsFinder finder;
+  expr->accept(finder);
+  return finder.hasSideEffects();
+}
+
+} // anonymous namespace
+
+bool ASTStencilBody::isIfConvertible(const std::shared_ptr<Stmt>& stmt) {
+  if(BlockStmt* blockStmt = dyn_cast<BlockStmt>(stmt.get())) {
+    for(const auto& s : blockStmt->getStatements())
+      if(!isIfConvertible(s))
+        return false;
+    return true;
+  }
+  if(IfStmt* ifStmt = dyn_cast<IfStmt>(stmt.get()))
+    return !hasSideEffects(ifStmt->getCondExpr()) && isIfConvertible(ifStmt->getThenStmt()) &&
+           (!ifStmt->hasElse() || isIfConvertible(ifStmt->getElseStmt()));
+  if(ExprStmt* exprStmt = dyn_cast<ExprStmt>(stmt.get())) {
+    const AssignmentExpr* expr = dyn_cast<AssignmentExpr>(exprStmt->getExpr().get());
+    return expr && !hasSideEffects(expr->getLeft()) && !hasSideEffects(expr->getRight());
+  }
+  return false;
+}
+
+void ASTStencilBody::generateMaskedStmt(const std::shared_ptr<Stmt>& stmt,
+                                        const std::string& mask) {
+  const std::string indent(indent_, ' ');
+
+  if(BlockStmt* blockStmt = dyn_cast<BlockStmt>(stmt.get())) {
+    for(const auto& s : blockStmt->getStatements())
+      generateMaskedStmt(s, mask);
+
+  } else if(IfStmt* ifStmt = dyn_cast<IfStmt>(stmt.get())) {
+    const std::string maskName = "mask_" + std::to_string(numMasks_++);
+    ss_ << indent << "const bool " << maskName << " = ";
+    ifStmt->getCondExpr()->accept(*this);
+    ss_ << ";\n";
+
+    const std::string parentMask = mask.empty() ? "" : mask + " && ";
+    generateMaskedStmt(ifStmt->getThenStmt(), parentMask + maskName);
+    if(ifStmt->hasElse())
+      generateMaskedStmt(ifStmt->getElseStmt(), parentMask + "!" + maskName);
+
+  } else {
+    // lhs op= rhs  ->  lhs = mask ? (lhs op rhs) : lhs
+    const AssignmentExpr& expr =
+        *dyn_cast<AssignmentExpr>(dyn_cast<ExprStmt>(stmt.get())->getExpr().get());
+    const std::string op = expr.getOp();
+
+    ss_ << indent;
+    expr.getLeft()->accept(*this);
+    ss_ << " = (" << mask << ") ? (";
+    if(op != "=") {
+      expr.getLeft()->accept(*this);
+      ss_ << " " << op.substr(0, op.size() - 1) << " ";
+    }
+    expr.getRight()->accept(*this);
+    ss_ << ") : ";
+    expr.getLeft()->accept(*this);
+    ss_ << ";\n";
+  }
+}
 
 //===------------------------------------------------------------------------------------------===//
 //     Expr
@@ -211,10 +324,68 @@ void ASTStencilBody::visit(const std::shared_ptr<FieldAccessExpr>& expr) {
     }
   } else {
     std::string accessName = getName(expr);
-    ss_ << accessName << offsetPrinter_(ijkfyOffset(expr->getOffset(), accessName));
+    auto windowIt = columnBufferWindows_.find(getAccessID(expr));
+    if(windowIt != columnBufferWindows_.end())
+      ss_ << makeColumnBufferAccess(accessName, windowIt->second, expr->getOffset());
+    else {
+      auto indices = ijkfyOffset(expr->getOffset(), accessName);
+      indices[2] = makeScratchBufferKIndex(getAccessID(expr), indices[2]);
+      ss_ << makeFieldAccess(accessName, indices);
+    }
   }
 }
 
+std::string ASTStencilBody::makeFieldAccess(const std::string& accessName,
+                                            const std::array<std::string, 3>& indices) {
+  if(!vectorize_)
+    return accessName + offsetPrinter_(indices);
+
+  return accessName + "_ptr[(" + indices[0] + ")*" + accessName + "_istride + (" + indices[1] +
+         ")*" + accessName + "_jstride + (" + indices[2] + ")*" + accessName + "_kstride]";
+}
+
+std::string ASTStencilBody::makeColumnBufferAccess(const std::string& accessName,
+                                                   const iir::Extents& window,
+                                                   const Array3i& offset) const {
+  if(window.isHorizontalPointwise())
+    return accessName + "_reg";
+
+  // The buffer stores the positions of the window around the current column
+  std::string access = accessName + "_buf";
+  for(int dim = 0; dim < 2; ++dim) {
+    const std::string index = dim == 0 ? "i" : "j";
+    if(window[dim].Minus == 0 && window[dim].Plus == 0)
+      access += "[0]";
+    else
+      access += "[" + index + "+" + std::to_string(offset[dim]) + "-" + index + "_col+" +
+                std::to_string(-window[dim].Minus) + "]";
+  }
+  return access;
+}
+
+std::string ASTStencilBody::makeScratchBufferKIndex(int AccessID,
+                                                    const std::string& kIndex) const {
+  auto it = scratchBufferWindows_.find(AccessID);
+  if(it == scratchBufferWindows_.end())
+    return kIndex;
+  if(it->second == 1)
+    return "0";
+
+  const std::string window = std::to_string(it->second);
+  return "((" + kIndex + ")%" + window + "+" + window + ")%" + window;
+}
+
+void ASTStencilBody::setVectorize(bool vectorize) { vectorize_ = vectorize; }
+
+void ASTStencilBody::setColumnBufferWindows(
+    const std::map<int, iir::Extents>& columnBufferWindows) {
+  columnBufferWindows_ = columnBufferWindows;
+}
+
+void ASTStencilBody::setScratchBufferWindows(const std::map<int, int>& scratchBufferWindows) {
+  scratchBufferWindows_ = scratchBufferWindows;
+}
+
 void ASTStencilBody::setCurrentStencilFunction(
     const std::shared_ptr<iir::StencilFunctionInstantiation>& currentFunction) {
   currentFunction_ = currentFunction;
@@ -17,8 +17,11 @@
 
 #include "dawn/CodeGen/ASTCodeGenCXX.h"
 #include "dawn/CodeGen/CodeGenProperties.h"
+#include "dawn/IIR/Extents.h"
 #include "dawn/IIR/Interval.h"
 #include "dawn/Support/StringUtil.h"
+#include <map>
+#include <set>
 #include <stack>
 #include <unordered_map>
 
@@ -47,6 +50,20 @@ protected:
 
   StencilContext stencilContext_;
 
+  /// Access the fields through raw pointers and convert if-statements to selects
+  bool vectorize_;
+
+  /// Number of masks declared by the if-conversion
+  int numMasks_;
+
+  /// AccessIDs of the temporaries which are stored in per-column buffers, mapped to the window of
+  /// the buffer (temporaries of an empty window are stored in local variables)
+  std::map<int, iir::Extents> columnBufferWindows_;
+
+  /// AccessIDs of the temporaries which are stored in ring buffers of IJ-planes, mapped to the
+  /// number of planes
+  std::map<int, int> scratchBufferWindows_;
+
   ///
   /// @brief produces a string of (i,j,k) accesses for the C++ generated naive code,
   /// from an array of offseted accesses
@@ -68,6 +85,26 @@ protected:
     return res;
   }
 
+  /// @brief produces the access to the field `accessName` at the position `indices`
+  std::string makeFieldAccess(const std::string& accessName,
+                              const std::array<std::string, 3>& indices);
+
+  /// @brief produces the access to the per-column buffer of the field `accessName` at the offset
+  /// `offset` from the current position
+  std::string makeColumnBufferAccess(const std::string& accessName, const iir::Extents& window,
+                                     const Array3i& offset) const;
+
+  /// @brief produces the index of the IJ-plane of the ring buffer at the vertical position `kIndex`
+  /// if the field `AccessID` is stored in a scratch buffer, `kIndex` otherwise
+  std::string makeScratchBufferKIndex(int AccessID, const std::string& kIndex) const;
+
+  /// @brief Check if all the statements nested in `stmt` are assignments or if-statements and if
+  /// the conditions and the assignments are free of side-effects (only the assignment itself)
+  static bool isIfConvertible(const std::shared_ptr<Stmt>& stmt);
+
+  /// @brief Generate the assignments nested in `stmt` as selects on `mask`
+  void generateMaskedStmt(const std::shared_ptr<Stmt>& stmt, const std::string& mask);
+
 public:
   using Base = ASTCodeGenCXX;
 
@@ -106,6 +143,18 @@ public:
   void setCurrentStencilFunction(
       const std::shared_ptr<iir::StencilFunctionInstantiation>& currentFunction);
 
+  /// @brief Generate field accesses through the raw pointers declared by
+  /// `CXXNaiveCodeGen::addRawPointerDeclarations` and if-statements as selects
+  void setVectorize(bool vectorize);
+
+  /// @brief Generate the accesses to the temporaries of `columnBufferWindows` as accesses to the
+  /// per-column buffers declared by `CXXNaiveCodeGen::generateMultiStage`
+  void setColumnBufferWindows(const std::map<int, iir::Extents>& columnBufferWindows);
+
+  /// @brief Generate the accesses to the temporaries stored in ring buffers of IJ-planes (see
+  /// `CXXNaiveCodeGen::computeScratchBufferWindows`)
+  void setScratchBufferWindows(const std::map<int, int>& scratchBufferWindows);
+
   /// @brief Mapping of VarDeclStmt and Var/FieldAccessExpr to their name
   std::string getName(const std::shared_ptr<Expr>& expr) const override;
   std::string getName(const std::shared_ptr<Stmt>& stmt) const override;
@@ -19,11 +19,15 @@
 #include "dawn/CodeGen/CodeGenProperties.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/Optimizer/PerformanceModel.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Logging.h"
 #include "dawn/Support/StringUtil.h"
 #include <algorithm>
+#include <functional>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn {
@@ -45,6 +49,49 @@ static std::string makeIJLoop(const iir::Extent extent, const std::string dom,
                       dom + "." + dim + "size() - " + dom + "." + dim + "plus() - 1", " <= ", "++");
 }
 
+static std::string makeIJGuard(const iir::Extents& extents, const iir::Extents& loopExtents,
+                               const std::string dom) {
+  std::vector<std::string> conditions;
+  for(int dim = 0; dim < 2; ++dim) {
+    const std::string index = dim == 0 ? "i" : "j";
+    if(extents[dim].Minus != loopExtents[dim].Minus)
+      conditions.push_back(index + " >= " + dom + "." + index + "minus()+" +
+                           std::to_string(extents[dim].Minus));
+    if(extents[dim].Plus != loopExtents[dim].Plus)
+      conditions.push_back(index + " <= " + dom + "." + index + "size() - " + dom + "." + index +
+                           "plus() - 1+" + std::to_string(extents[dim].Plus));
+  }
+  return conditions.empty() ? "" : "if(" + RangeToString(" && ", "", "")(conditions) + ")";
+}
+
+namespace {
+
+/// @brief Collect the AccessIDs of the fields passed as arguments to stencil functions
+class StencilFunArgFieldsCollector : public ASTVisitorForwarding {
+  const iir::StencilMetaInformation& metadata_;
+  int nestingOfStencilFunCalls_;
+  std::set<int> accessIDs_;
+
+public:
+  StencilFunArgFieldsCollector(const iir::StencilMetaInformation& metadata)
+      : metadata_(metadata), nestingOfStencilFunCalls_(0) {}
+
+  virtual void visit(const std::shared_ptr<StencilFunCallExpr>& expr) override {
+    nestingOfStencilFunCalls_++;
+    ASTVisitorForwarding::visit(expr);
+    nestingOfStencilFunCalls_--;
+  }
+
+  virtual void visit(const std::shared_ptr<FieldAccessExpr>& expr) override {
+    if(nestingOfStencilFunCalls_)
+      accessIDs_.insert(metadata_.getAccessIDFromExpr(expr));
+  }
+
+  const std::set<int>& getAccessIDs() const { return accessIDs_; }
+};
+
+} // anonymous namespace
+
 static std::string makeIntervalBound(const std::string dom, iir::Interval const& interval,
                                      iir::Interval::Bound bound) {
   return interval.levelIsEnd(bound)
@@ -53,8 +100,8 @@ static std::string makeIntervalBound(const std::string dom, iir::Interval const&
              : std::to_string(interval.bound(bound));
 }
 
-static std::string makeKLoop(const std::string dom, bool isBackward,
-                             iir::Interval const& interval) {
+std::string CXXNaiveCodeGen::makeKLoop(const std::string dom, bool isBackward,
+                                       iir::Interval const& interval) {
 
   const std::string lower = makeIntervalBound(dom, interval, iir::Interval::Bound::lower);
   const std::string upper = makeIntervalBound(dom, interval, iir::Interval::Bound::upper);
@@ -63,6 +110,297 @@ static std::string makeKLoop(const std::string dom, bool isBackward,
                     : makeLoopImpl(iir::Extent{}, "k", lower, upper, "<=", "++");
 }
 
+std::vector<iir::Interval>
+CXXNaiveCodeGen::computePartitionIntervals(const iir::MultiStage& multiStage) {
+  auto intervals_set = multiStage.getIntervals();
+  std::vector<iir::Interval> intervals_v;
+  std::copy(intervals_set.begin(), intervals_set.end(), std::back_inserter(intervals_v));
+
+  // compute the partition of the intervals
+  auto partitionIntervals = iir::Interval::computePartition(intervals_v);
+  if((multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward))
+    std::reverse(partitionIntervals.begin(), partitionIntervals.end());
+  return partitionIntervals;
+}
+
+std::vector<CXXNaiveCodeGen::FusedStageGroup>
+CXXNaiveCodeGen::computeFusedStageGroups(const iir::StencilMetaInformation& metadata,
+                                         const iir::Stencil& stencil,
+                                         const iir::MultiStage& multiStage) {
+  std::vector<FusedStageGroup> stageGroups;
+  for(const auto& stagePtr : multiStage.getChildren()) {
+    if(!stageGroups.empty()) {
+      FusedStageGroup stageGroup = stageGroups.back();
+      stageGroup.Stages.push_back(stagePtr.get());
+      if(computeColumnEvaluation(metadata, stencil, stageGroup)) {
+        stageGroups.back() = std::move(stageGroup);
+        continue;
+      }
+    }
+
+    // A single stage is always evaluated at the current column only
+    stageGroups.emplace_back();
+    stageGroups.back().Stages.push_back(stagePtr.get());
+    computeColumnEvaluation(metadata, stencil, stageGroups.back());
+  }
+  return stageGroups;
+}
+
+bool CXXNaiveCodeGen::computeColumnEvaluation(const iir::StencilMetaInformation& metadata,
+                                              const iir::Stencil& stencil,
+                                              FusedStageGroup& group) {
+  const std::vector<const iir::Stage*>& stages = group.Stages;
+  auto isInGroup = [&](const iir::Stage* stage) {
+    return std::find(stages.begin(), stages.end(), stage) != stages.end();
+  };
+
+  // Stencil functions take their arguments as data views
+  StencilFunArgFieldsCollector stencilFunArgFieldsCollector(metadata);
+  for(const iir::Stage* stage : stages)
+    for(const auto& doMethodPtr : stage->getChildren())
+      for(const auto& statementAccessesPair : doMethodPtr->getChildren())
+        statementAccessesPair->getStatement()->ASTStmt->accept(stencilFunArgFieldsCollector);
+
+  // The local temporaries are written by the first stage accessing them only, are not accessed by
+  // stages outside of the group and are accessed without vertical offsets. They are mapped to the
+  // index of their writer
+  std::map<int, std::size_t> writerOfLocalAccessIDs;
+  std::unordered_set<int> visitedAccessIDs;
+  for(std::size_t stageIdx = 0; stageIdx < stages.size(); ++stageIdx) {
+    for(const auto& AccessIDFieldPair : stages[stageIdx]->getFields()) {
+      const int AccessID = AccessIDFieldPair.first;
+      const iir::Field& field = AccessIDFieldPair.second;
+      if(!visitedAccessIDs.insert(AccessID).second) {
+        if(field.getIntend() != iir::Field::IK_Input || !field.getExtents().isVerticalPointwise())
+          writerOfLocalAccessIDs.erase(AccessID);
+        continue;
+      }
+
+      auto fieldIt = stencil.getFields().find(AccessID);
+      if(fieldIt == stencil.getFields().end() || !fieldIt->second.IsTemporary ||
+         field.getIntend() != iir::Field::IK_Output || !field.getExtents().isVerticalPointwise() ||
+         stencilFunArgFieldsCollector.getAccessIDs().count(AccessID))
+        continue;
+
+      bool isLocal = true;
+      for(const auto& multiStagePtr : stencil.getChildren())
+        for(const auto& stagePtr : multiStagePtr->getChildren())
+          if(stagePtr->getFields().count(AccessID) && !isInGroup(stagePtr.get()))
+            isLocal = false;
+      if(isLocal)
+        writerOfLocalAccessIDs.emplace(AccessID, stageIdx);
+    }
+  }
+
+  // The writer of a local temporary is evaluated at all the positions read by the later stages,
+  // hence the windows are computed backwards
+  group.Windows.assign(stages.size(), iir::Extents(0, 0, 0, 0, 0, 0));
+  for(std::size_t stageIdx = stages.size(); stageIdx-- > 0;) {
+    for(const auto& AccessIDFieldPair : stages[stageIdx]->getFields()) {
+      auto writerIt = writerOfLocalAccessIDs.find(AccessIDFieldPair.first);
+      if(writerIt == writerOfLocalAccessIDs.end() || writerIt->second == stageIdx)
+        continue;
+      iir::Extents window = group.Windows[stageIdx];
+      window.expand(AccessIDFieldPair.second.getExtents());
+      group.Windows[writerIt->second].merge(window);
+    }
+  }
+
+  group.LocalAccessIDs.clear();
+  for(const auto& AccessIDWriterPair : writerOfLocalAccessIDs)
+    group.LocalAccessIDs.emplace(AccessIDWriterPair.first,
+                                 group.Windows[AccessIDWriterPair.second]);
+
+  // The other fields written by the group are only accessed at the current column
+  std::unordered_set<int> writtenAccessIDs;
+  for(const iir::Stage* stage : stages)
+    for(const auto& AccessIDFieldPair : stage->getFields())
+      if(AccessIDFieldPair.second.getIntend() != iir::Field::IK_Input)
+        writtenAccessIDs.insert(AccessIDFieldPair.first);
+
+  for(std::size_t stageIdx = 0; stageIdx < stages.size(); ++stageIdx) {
+    for(const auto& AccessIDFieldPair : stages[stageIdx]->getFields()) {
+      const int AccessID = AccessIDFieldPair.first;
+      if(writerOfLocalAccessIDs.count(AccessID) || !writtenAccessIDs.count(AccessID))
+        continue;
+      if(!AccessIDFieldPair.second.getExtents().isHorizontalPointwise() ||
+         !group.Windows[stageIdx].isHorizontalPointwise())
+        return false;
+    }
+  }
+  return true;
+}
+
+std::map<int, int>
+CXXNaiveCodeGen::computeScratchBufferWindows(const iir::StencilMetaInformation& metadata,
+                                             const iir::Stencil& stencil) {
+  // Stencil functions access their arguments at the vertical level of the call
+  StencilFunArgFieldsCollector stencilFunArgFieldsCollector(metadata);
+  for(const auto& multiStagePtr : stencil.getChildren())
+    for(const auto& stagePtr : multiStagePtr->getChildren())
+      for(const auto& doMethodPtr : stagePtr->getChildren())
+        for(const auto& statementAccessesPair : doMethodPtr->getChildren())
+          statementAccessesPair->getStatement()->ASTStmt->accept(stencilFunArgFieldsCollector);
+
+  std::map<int, int> windows;
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    for(const auto& AccessIDCachePair : multiStagePtr->getCaches()) {
+      const int AccessID = AccessIDCachePair.first;
+      const iir::Cache& cache = AccessIDCachePair.second;
+      if(cache.getCacheType() != iir::Cache::IJ && cache.getCacheType() != iir::Cache::K)
+        continue;
+
+      auto fieldIt = stencil.getFields().find(AccessID);
+      if(fieldIt == stencil.getFields().end() || !fieldIt->second.IsTemporary ||
+         stencilFunArgFieldsCollector.getAccessIDs().count(AccessID))
+        continue;
+
+      bool isAccessedByOtherMultiStages = false;
+      for(const auto& otherMultiStagePtr : stencil.getChildren())
+        if(otherMultiStagePtr != multiStagePtr && otherMultiStagePtr->getFields().count(AccessID))
+          isAccessedByOtherMultiStages = true;
+      // Without other multi-stages accessing the temporary, the values filled from (or flushed to)
+      // the storage are never written (or read) outside of the cache
+      if(isAccessedByOtherMultiStages)
+        continue;
+
+      // The vertical loop is the outermost one: an IJ-cached temporary only lives within a level,
+      // a K-cached one within the window of levels it is accessed at
+      if(cache.getCacheType() == iir::Cache::IJ) {
+        windows.emplace(AccessID, 1);
+      } else {
+        const iir::Extent vertExtent = multiStagePtr->getKCacheVertExtent(AccessID);
+        windows.emplace(AccessID, std::max(vertExtent.Plus, 0) - std::min(vertExtent.Minus, 0) + 1);
+      }
+    }
+  }
+  return windows;
+}
+
+void CXXNaiveCodeGen::addScratchBufferDeclaration(
+    Structure& stencilClass, const iir::StencilMetaInformation& metadata,
+    const std::map<int, int>& scratchBufferWindows, const std::set<int>& localAccessIDs) const {
+  if(scratchBufferWindows.empty())
+    return;
+
+  stencilClass.addTypeDef(scratchMetadataTypename_)
+      .addType("storage_traits_t::storage_info_t< 1, 3, gridtools::halo< "
+               "GRIDTOOLS_CLANG_HALO_EXTEND, GRIDTOOLS_CLANG_HALO_EXTEND, 0 > >");
+  stencilClass.addTypeDef(scratchStorageTypename_)
+      .addType("storage_traits_t::data_store_t< float_type, " + scratchMetadataTypename_ + ">");
+
+  std::set<int> windows;
+  for(const auto& AccessIDWindowPair : scratchBufferWindows)
+    if(!localAccessIDs.count(AccessIDWindowPair.first))
+      windows.insert(AccessIDWindowPair.second);
+  for(int window : windows)
+    stencilClass.addMember(scratchMetadataTypename_,
+                           "m_scratch_meta_data_" + std::to_string(window));
+
+  for(const auto& AccessIDWindowPair : scratchBufferWindows)
+    if(!localAccessIDs.count(AccessIDWindowPair.first))
+      stencilClass.addMember(scratchStorageTypename_,
+                             "m_" + metadata.getFieldNameFromAccessID(AccessIDWindowPair.first));
+}
+
+void CXXNaiveCodeGen::addScratchBufferInit(MemberFunction& ctr,
+                                           const iir::StencilMetaInformation& metadata,
+                                           const std::map<int, int>& scratchBufferWindows,
+                                           const std::set<int>& localAccessIDs) const {
+  std::set<int> windows;
+  for(const auto& AccessIDWindowPair : scratchBufferWindows)
+    if(!localAccessIDs.count(AccessIDWindowPair.first))
+      windows.insert(AccessIDWindowPair.second);
+  for(int window : windows)
+    ctr.addInit("m_scratch_meta_data_" + std::to_string(window) + "(dom_.isize(), dom_.jsize(), " +
+                std::to_string(window) + ")");
+
+  for(const auto& AccessIDWindowPair : scratchBufferWindows)
+    if(!localAccessIDs.count(AccessIDWindowPair.first))
+      ctr.addInit("m_" + metadata.getFieldNameFromAccessID(AccessIDWindowPair.first) +
+                  "(m_scratch_meta_data_" + std::to_string(AccessIDWindowPair.second) + ")");
+}
+
+void CXXNaiveCodeGen::addRawPointerDeclarations(MemberFunction& stencilRunMethod,
+                                                const std::string& fieldName,
+                                                const std::string& storageName) {
+  const std::string storageInfo = storageName + ".get_storage_info_ptr()";
+  stencilRunMethod.addStatement("auto* const " + fieldName + "_ptr = " + fieldName + ".data() + " +
+                                storageInfo + "->index(0, 0, 0)");
+  stencilRunMethod.addStatement("const int " + fieldName + "_istride = " + storageInfo +
+                                "->template stride<0>()");
+  stencilRunMethod.addStatement("const int " + fieldName + "_jstride = " + storageInfo +
+                                "->template stride<1>()");
+  stencilRunMethod.addStatement("const int " + fieldName + "_kstride = " + storageInfo +
+                                "->template stride<2>()");
+}
+
+void CXXNaiveCodeGen::addUnitStrideDimDeclaration(MemberFunction& stencilRunMethod,
+                                                  const std::vector<std::string>& fieldNames) {
+  std::array<std::vector<std::string>, 3> conditions;
+  for(const std::string& fieldName : fieldNames)
+    for(int dim = 0; dim < 3; ++dim)
+      conditions[dim].push_back(fieldName + "_" + std::string(1, "ijk"[dim]) + "stride == 1");
+
+  if(fieldNames.empty()) {
+    stencilRunMethod.addStatement("const int unit_stride_dim = 1");
+    return;
+  }
+  auto makeCondition = RangeToString(" && ", "(", ")");
+  stencilRunMethod.addStatement("const int unit_stride_dim = " + makeCondition(conditions[0]) +
+                                " ? 0 : " + makeCondition(conditions[2]) + " ? 2 : 1");
+}
+
+void CXXNaiveCodeGen::addSimdPragma(MemberFunction& stencilRunMethod) const {
+  if(context_->getOptions().Vectorize)
+    stencilRunMethod.ss() << "\n#pragma omp simd\n";
+}
+
+void CXXNaiveCodeGen::addHorizontalLoops(MemberFunction& stencilRunMethod,
+                                         const std::string& iLoop, const std::string& jLoop,
+                                         const std::function<void()>& body,
+                                         const std::string& outerPragma) const {
+  auto generateLoops = [&](const std::string& outerLoop, const std::string& innerLoop) {
+    stencilRunMethod.ss() << outerPragma;
+    stencilRunMethod.addBlockStatement(outerLoop, [&]() {
+      addSimdPragma(stencilRunMethod);
+      stencilRunMethod.addBlockStatement(innerLoop, body);
+    });
+  };
+
+  if(!context_->getOptions().Vectorize) {
+    generateLoops(iLoop, jLoop);
+    return;
+  }
+  stencilRunMethod.addBlockStatement("if(unit_stride_dim == 0)",
+                                     [&]() { generateLoops(jLoop, iLoop); });
+  stencilRunMethod.addBlockStatement("else", [&]() { generateLoops(iLoop, jLoop); });
+}
+
+void CXXNaiveCodeGen::addVerticalInnermostLoops(MemberFunction& stencilRunMethod,
+                                                const std::string& iLoop, const std::string& jLoop,
+                                                const std::string& kLoop,
+                                                const std::function<void()>& body,
+                                                const std::string& outerPragma) const {
+  stencilRunMethod.ss() << outerPragma;
+  stencilRunMethod.addBlockStatement(iLoop, [&]() {
+    stencilRunMethod.addBlockStatement(jLoop, [&]() {
+      addSimdPragma(stencilRunMethod);
+      stencilRunMethod.addBlockStatement(kLoop, body);
+    });
+  });
+}
+
+bool CXXNaiveCodeGen::isVerticalLoopInnermostCapable(
+    const iir::MultiStage& multiStage, const std::map<int, int>& scratchBufferWindows) {
+  if(multiStage.getLoopOrder() != iir::LoopOrderKind::LK_Parallel)
+    return false;
+  for(const auto& AccessIDFieldPair : multiStage.getFields())
+    if(scratchBufferWindows.count(AccessIDFieldPair.first))
+      return false;
+  return true;
+}
+
 CXXNaiveCodeGen::CXXNaiveCodeGen(OptimizerContext* context) : CodeGen(context) {}
 
 CXXNaiveCodeGen::~CXXNaiveCodeGen() {}
@@ -108,9 +446,190 @@ std::string CXXNaiveCodeGen::generateStencilInstantiation(
 
   cxxnaiveNamespace.commit();
 
+  if(isBenchmarked())
+    generateBenchmarkDriver(ssSW, stencilInstantiation, codeGenProperties);
+
   return ssSW.str();
 }
 
+std::string CXXNaiveCodeGen::generateBenchmarkRuntime() const {
+  if(!isBenchmarked())
+    return "";
+
+  // The runtime is shared by all the generated stencils of a program, hence the include guard
+  return R"(#ifndef DAWN_BENCHMARK_RUNTIME
+#define DAWN_BENCHMARK_RUNTIME
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace dawn_benchmark {
+
+/// Size of the compute domain (without halos) and number of runs of each stencil
+struct config {
+  int isize = 128;
+  int jsize = 128;
+  int ksize = 80;
+  int warmup = 3;
+  int iterations = 10;
+};
+
+using driver = void (*)(const config&);
+
+inline std::vector<std::pair<const char*, driver>>& drivers() {
+  static std::vector<std::pair<const char*, driver>> d;
+  return d;
+}
+
+/// Registers the driver of a stencil during static initialization
+struct registrar {
+  registrar(const char* stencil, driver d) { drivers().emplace_back(stencil, d); }
+};
+
+/// Deterministic initial value of the field with index `field` at (i, j, k)
+inline double value(int field, int i, int j, int k) {
+  return 1.0 + 0.5 * std::sin(0.1 * i + 0.2 * j + 0.3 * k + 1.7 * field);
+}
+
+template <class Storage>
+void fill_field(Storage& storage, int field, int isize, int jsize, int ksize) {
+  auto view = gridtools::make_host_view(storage);
+  for(int i = 0; i < isize; ++i)
+    for(int j = 0; j < jsize; ++j)
+      for(int k = 0; k < ksize; ++k)
+        view(i, j, k) = value(field, i, j, k);
+}
+
+/// Time `iterations` runs of `stencil` after `warmup` runs
+/// @returns the mean runtime of a run in seconds
+template <class Stencil>
+double measure(Stencil& stencil, const config& c) {
+  for(int n = 0; n < c.warmup; ++n)
+    stencil.run();
+  const auto start = std::chrono::steady_clock::now();
+  for(int n = 0; n < c.iterations; ++n)
+    stencil.run();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return c.iterations > 0 ? elapsed.count() / c.iterations : 0.0;
+}
+
+/// Print the measurement of a stencil as a single line of JSON
+inline void report(const char* stencil, const config& c, double seconds, double bytesPerPoint,
+                   double flopsPerPoint) {
+  const double points = static_cast<double>(c.isize) * c.jsize * c.ksize;
+  const double gbs = seconds > 0 ? bytesPerPoint * points / seconds * 1e-9 : 0.0;
+  const double gflops = seconds > 0 ? flopsPerPoint * points / seconds * 1e-9 : 0.0;
+  std::printf("{\"stencil\": \"%s\", \"domain\": [%d, %d, %d], \"iterations\": %d, "
+              "\"time\": %.9g, \"bandwidth\": %.6g, \"gflops\": %.6g}\n",
+              stencil, c.isize, c.jsize, c.ksize, c.iterations, seconds, gbs, gflops);
+  std::fflush(stdout);
+}
+
+/// Usage: <program> [isize jsize ksize [warmup [iterations [stencil]]]]
+///
+/// Runs the drivers of all stencils (or only of `stencil`)
+/// @returns 0 on success, 1 if no stencil was run
+inline int run(int argc, char** argv) {
+  config c;
+  if(argc > 3) {
+    c.isize = std::atoi(argv[1]);
+    c.jsize = std::atoi(argv[2]);
+    c.ksize = std::atoi(argv[3]);
+  }
+  if(argc > 4)
+    c.warmup = std::atoi(argv[4]);
+  if(argc > 5)
+    c.iterations = std::atoi(argv[5]);
+  const char* filter = argc > 6 ? argv[6] : nullptr;
+
+  int numRuns = 0;
+  for(const auto& d : drivers()) {
+    if(filter && std::strcmp(filter, d.first) != 0)
+      continue;
+    d.second(c);
+    ++numRuns;
+  }
+  return numRuns > 0 ? 0 : 1;
+}
+
+} // namespace dawn_benchmark
+
+#ifdef DAWN_BENCHMARK_MAIN
+int main(int argc, char** argv) { return dawn_benchmark::run(argc, argv); }
+#endif
+#endif
+)";
+}
+
+void CXXNaiveCodeGen::generateBenchmarkDriver(
+    std::stringstream& ss, const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    const CodeGenProperties& codeGenProperties) const {
+  const auto& metadata = stencilInstantiation->getMetaData();
+  const std::string& name = stencilInstantiation->getName();
+
+  // The halos of the domain cover the (redundant) accesses of the stencils to the fields
+  iir::Extent iHalo, jHalo;
+  // Bytes accessed and floating point operations per grid point
+  std::size_t numAccesses = 0, numFlops = 0;
+  for(const auto& stencil : stencilInstantiation->getStencils()) {
+    for(const auto& fieldPair : stencil->getFields()) {
+      if(fieldPair.second.IsTemporary)
+        continue;
+      const iir::Extents& extents = fieldPair.second.field.getExtentsRB();
+      iHalo.merge(extents[0]);
+      jHalo.merge(extents[1]);
+    }
+    for(const auto& multiStage : stencil->getChildren()) {
+      auto readAndWrite = computeReadWriteAccessesMetric(*stencilInstantiation, *multiStage);
+      numAccesses += readAndWrite.first + readAndWrite.second;
+      numFlops += computeFlopsPerGridPoint(*stencilInstantiation, *multiStage);
+    }
+  }
+
+  Namespace benchmarkNamespace("dawn_benchmark", ss);
+
+  MemberFunction driver("inline void", "benchmark_" + name, ss);
+  driver.addArg("const config& cfg");
+  driver.startBody();
+
+  driver.addStatement(c_gtc().str() + "domain dom(cfg.isize + " +
+                      std::to_string(iHalo.Plus - iHalo.Minus) + ", cfg.jsize + " +
+                      std::to_string(jHalo.Plus - jHalo.Minus) + ", cfg.ksize)");
+  driver.addStatement("dom.set_halos(" + std::to_string(-iHalo.Minus) + ", " +
+                      std::to_string(iHalo.Plus) + ", " + std::to_string(-jHalo.Minus) + ", " +
+                      std::to_string(jHalo.Plus) + ", 0, 0)");
+
+  std::string ctrArgs = "dom";
+  int fieldIdx = 0;
+  for(int APIFieldID : metadata.getAccessesOfType<iir::FieldAccessType::FAT_APIField>()) {
+    const std::string fieldName = metadata.getFieldNameFromAccessID(APIFieldID);
+    const std::string storageType = codeGenProperties.getParamType(fieldName);
+    driver.addStatement(storageType + "::storage_info_t " + fieldName +
+                        "_info(dom.isize(), dom.jsize(), dom.ksize())");
+    driver.addStatement(storageType + " " + fieldName + "(" + fieldName + "_info, \"" +
+                        fieldName + "\")");
+    driver.addStatement("fill_field(" + fieldName + ", " + std::to_string(fieldIdx++) +
+                        ", dom.isize(), dom.jsize(), dom.ksize())");
+    ctrArgs += ", " + fieldName;
+  }
+
+  driver.addStatement("cxxnaive::" + name + " stencil(" + ctrArgs + ")");
+  driver.addStatement("const double seconds = measure(stencil, cfg)");
+  driver.addStatement("report(\"" + name + "\", cfg, seconds, " + std::to_string(numAccesses) +
+                      " * sizeof(" + c_gtc().str() + "float_type), " + std::to_string(numFlops) +
+                      ")");
+  driver.commit();
+
+  ss << "static registrar register_" << name << "(\"" << name << "\", benchmark_" << name
+     << ");\n";
+
+  benchmarkNamespace.commit();
+}
+
 void CXXNaiveCodeGen::generateStencilWrapperRun(
     Class& stencilWrapperClass,
     const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
@@ -251,6 +770,7 @@ void CXXNaiveCodeGen::generateStencilClasses(
     Class& stencilWrapperClass, const CodeGenProperties& codeGenProperties) const {
 
   const auto& stencils = stencilInstantiation->getStencils();
+  const auto& metadata = stencilInstantiation->getMetaData();
   const auto& globalsMap = stencilInstantiation->getIIR()->getGlobalVariableMap();
 
   // Stencil members:
@@ -277,6 +797,17 @@ void CXXNaiveCodeGen::generateStencilClasses(
         std::function<bool(std::pair<int, iir::Stencil::FieldInfo> const&)>(
             [](std::pair<int, iir::Stencil::FieldInfo> const& p) { return p.second.IsTemporary; }));
 
+    // temporaries which are not stored in scratch buffers are allocated for the whole domain,
+    // unless the multi-stages allocate them themselves
+    const std::map<int, int> scratchBufferWindows = computeScratchBufferWindows(metadata, stencil);
+    const std::set<int> localAccessIDs = computeMultiStageLocalAccessIDs(stencil);
+    auto fullTempFields = makeRange(
+        stencilFields, std::function<bool(std::pair<int, iir::Stencil::FieldInfo> const&)>(
+                           [&](std::pair<int, iir::Stencil::FieldInfo> const& p) {
+                             return p.second.IsTemporary && !scratchBufferWindows.count(p.first) &&
+                                    !localAccessIDs.count(p.first);
+                           }));
+
     // list of template for storages used in the stencil class
     std::vector<std::string> StencilTemplates(nonTempFields.size());
     int cnt = 0;
@@ -289,9 +820,6 @@ void CXXNaiveCodeGen::generateStencilClasses(
                                     [](const std::string& str) { return "class " + str; }),
         "sbase");
 
-    ASTStencilBody stencilBodyCXXVisitor(stencilInstantiation->getMetaData(),
-                                         StencilContext::SC_Stencil);
-
     StencilClass.addComment("Members");
     StencilClass.addComment("Temporary storages");
     addTempStorageTypedef(StencilClass, stencil);
@@ -306,7 +834,8 @@ void CXXNaiveCodeGen::generateStencilClasses(
       StencilClass.addMember(StencilTemplates[fieldIt.idx()] + "&", "m_" + (*fieldIt).second.Name);
     }
 
-    addTmpStorageDeclaration(StencilClass, tempFields);
+    addTmpStorageDeclaration(StencilClass, fullTempFields);
+    addScratchBufferDeclaration(StencilClass, metadata, scratchBufferWindows, localAccessIDs);
 
     StencilClass.changeAccessibility("public");
 
@@ -329,7 +858,8 @@ void CXXNaiveCodeGen::generateStencilClasses(
       stencilClassCtr.addInit("m_" + (*fieldIt).second.Name + "(" + (*fieldIt).second.Name + "_)");
     }
 
-    addTmpStorageInit(stencilClassCtr, stencil, tempFields);
+    addTmpStorageInit(stencilClassCtr, stencil, fullTempFields);
+    addScratchBufferInit(stencilClassCtr, metadata, scratchBufferWindows, localAccessIDs);
     stencilClassCtr.commit();
 
     // virtual dtor
@@ -353,6 +883,9 @@ void CXXNaiveCodeGen::generateStencilClasses(
     MemberFunction StencilRunMethod = StencilClass.addMemberFunction("virtual void", "run", "");
     StencilRunMethod.startBody();
 
+    if(isInstrumented())
+      addInstrumentationBegin(StencilRunMethod, "stencil_probe", *stencilInstantiation, stencil,
+                              nullptr, "m_dom");
     StencilRunMethod.addStatement("sync_storages()");
     for(const auto& multiStagePtr : stencil.getChildren()) {
 
@@ -367,61 +900,196 @@ void CXXNaiveCodeGen::generateStencilClasses(
                                       "> " + fieldName + "= " + c_gt() + "make_host_view(m_" +
                                       fieldName + ")");
         StencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+        if(context_->getOptions().Vectorize)
+          addRawPointerDeclarations(StencilRunMethod, fieldName, "m_" + fieldName);
       }
       for(auto fieldIt : tempFields) {
+        if(localAccessIDs.count((*fieldIt).first))
+          continue;
         const auto fieldName = (*fieldIt).second.Name;
+        const std::string& storageTypename = scratchBufferWindows.count((*fieldIt).first)
+                                                 ? scratchStorageTypename_
+                                                 : tmpStorageTypename_;
 
-        StencilRunMethod.addStatement(c_gt() + "data_view<tmp_storage_t> " + fieldName + "= " +
-                                      c_gt() + "make_host_view(m_" + fieldName + ")");
+        StencilRunMethod.addStatement(c_gt() + "data_view<" + storageTypename + "> " + fieldName +
+                                      "= " + c_gt() + "make_host_view(m_" + fieldName + ")");
         StencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+        if(context_->getOptions().Vectorize)
+          addRawPointerDeclarations(StencilRunMethod, fieldName, "m_" + fieldName);
       }
 
-      auto intervals_set = multiStage.getIntervals();
-      std::vector<iir::Interval> intervals_v;
-      std::copy(intervals_set.begin(), intervals_set.end(), std::back_inserter(intervals_v));
+      // The loop order of the vectorized code follows the layout of the storages of the stencil
+      if(context_->getOptions().Vectorize) {
+        std::vector<std::string> fieldNames;
+        for(auto fieldIt : nonTempFields)
+          fieldNames.push_back((*fieldIt).second.Name);
+        addUnitStrideDimDeclaration(StencilRunMethod, fieldNames);
+      }
 
-      // compute the partition of the intervals
-      auto partitionIntervals = iir::Interval::computePartition(intervals_v);
-      if((multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward))
-        std::reverse(partitionIntervals.begin(), partitionIntervals.end());
+      if(isInstrumented())
+        addInstrumentationBegin(StencilRunMethod, "multistage_probe", *stencilInstantiation,
+                                stencil, &multiStage, "m_dom");
 
-      for(auto interval : partitionIntervals) {
+      generateMultiStage(StencilRunMethod, stencilInstantiation, stencil, multiStage);
+
+      if(isInstrumented())
+        addInstrumentationEnd(StencilRunMethod, "multistage_probe");
 
-        // for each interval, we generate naive nested loops
-        StencilRunMethod.addBlockStatement(
-            makeKLoop("m_dom", (multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward),
-                      interval),
-            [&]() {
-              for(const auto& stagePtr : multiStage.getChildren()) {
-                const iir::Stage& stage = *stagePtr;
-
-                StencilRunMethod.addBlockStatement(
-                    makeIJLoop(stage.getExtents()[0], "m_dom", "i"), [&]() {
-                      StencilRunMethod.addBlockStatement(
-                          makeIJLoop(stage.getExtents()[1], "m_dom", "j"), [&]() {
-                            // Generate Do-Method
-                            for(const auto& doMethodPtr : stage.getChildren()) {
-                              const iir::DoMethod& doMethod = *doMethodPtr;
-                              if(!doMethod.getInterval().overlaps(interval))
-                                continue;
-                              for(const auto& statementAccessesPair : doMethod.getChildren()) {
-                                statementAccessesPair->getStatement()->ASTStmt->accept(
-                                    stencilBodyCXXVisitor);
-                                StencilRunMethod << stencilBodyCXXVisitor.getCodeAndResetStream();
-                              }
-                            }
-                          });
-                    });
-              }
-            });
-      }
       StencilRunMethod.ss() << "}";
     }
     StencilRunMethod.addStatement("sync_storages()");
+    if(isInstrumented())
+      addInstrumentationEnd(StencilRunMethod, "stencil_probe");
     StencilRunMethod.commit();
   }
 }
 
+void CXXNaiveCodeGen::generateMultiStage(
+    MemberFunction& stencilRunMethod,
+    const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    const iir::Stencil& stencil, const iir::MultiStage& multiStage) const {
+  const auto& metadata = stencilInstantiation->getMetaData();
+  ASTStencilBody stencilBodyCXXVisitor(metadata, StencilContext::SC_Stencil);
+  stencilBodyCXXVisitor.setVectorize(context_->getOptions().Vectorize);
+
+  // Each group of stages is computed within the same horizontal loops
+  std::vector<FusedStageGroup> stageGroups;
+  if(context_->getOptions().FuseHorizontalLoops) {
+    stageGroups = computeFusedStageGroups(metadata, stencil, multiStage);
+  } else {
+    for(const auto& stagePtr : multiStage.getChildren()) {
+      stageGroups.emplace_back();
+      stageGroups.back().Stages.push_back(stagePtr.get());
+      stageGroups.back().Windows.push_back(iir::Extents(0, 0, 0, 0, 0, 0));
+    }
+  }
+
+  const std::map<int, int> scratchBufferWindows = computeScratchBufferWindows(metadata, stencil);
+  stencilBodyCXXVisitor.setScratchBufferWindows(scratchBufferWindows);
+
+  // Generate the code of a group of stages at the current point
+  auto generateStageGroup = [&](const FusedStageGroup& stageGroup, const iir::Extents& loopExtents,
+                                const iir::Interval& interval) {
+    bool hasWindows = false;
+    for(const iir::Extents& window : stageGroup.Windows)
+      hasWindows |= !window.isHorizontalPointwise();
+    if(hasWindows) {
+      stencilRunMethod.addStatement("const int i_col = i");
+      stencilRunMethod.addStatement("const int j_col = j");
+    }
+    for(const auto& AccessIDWindowPair : stageGroup.LocalAccessIDs) {
+      const iir::Extents& window = AccessIDWindowPair.second;
+      const std::string name = metadata.getFieldNameFromAccessID(AccessIDWindowPair.first);
+      if(window.isHorizontalPointwise())
+        stencilRunMethod.addStatement(c_gtc() + "float_type " + name + "_reg");
+      else
+        stencilRunMethod.addStatement(c_gtc() + "float_type " + name + "_buf[" +
+                                      std::to_string(window[0].Plus - window[0].Minus + 1) +
+                                      "][" +
+                                      std::to_string(window[1].Plus - window[1].Minus + 1) + "]");
+    }
+
+    for(std::size_t stageIdx = 0; stageIdx < stageGroup.Stages.size(); ++stageIdx) {
+      const iir::Stage* stage = stageGroup.Stages[stageIdx];
+      const iir::Extents& window = stageGroup.Windows[stageIdx];
+
+      // Generate Do-Method
+      auto generateDoMethods = [&]() {
+        for(const auto& doMethodPtr : stage->getChildren()) {
+          const iir::DoMethod& doMethod = *doMethodPtr;
+          if(!doMethod.getInterval().overlaps(interval))
+            continue;
+          for(const auto& statementAccessesPair : doMethod.getChildren()) {
+            statementAccessesPair->getStatement()->ASTStmt->accept(stencilBodyCXXVisitor);
+            stencilRunMethod << stencilBodyCXXVisitor.getCodeAndResetStream();
+          }
+        }
+      };
+
+      // Restrict the stage to its extents within the positions covered by its window
+      iir::Extents evaluatedExtents = loopExtents;
+      evaluatedExtents.expand(window);
+      const std::string guard = makeIJGuard(stage->getExtents(), evaluatedExtents, "m_dom");
+      auto generateGuardedDoMethods = [&]() {
+        if(guard.empty())
+          generateDoMethods();
+        else
+          stencilRunMethod.addBlockStatement(guard, generateDoMethods);
+      };
+
+      // Evaluate the stage at all the positions of its window around the current column
+      std::function<void(int)> generateWindowLoops = [&](int dim) {
+        if(dim == 2) {
+          generateGuardedDoMethods();
+          return;
+        }
+        if(window[dim].Minus == 0 && window[dim].Plus == 0) {
+          generateWindowLoops(dim + 1);
+          return;
+        }
+        const std::string index = dim == 0 ? "i" : "j";
+        stencilRunMethod.addBlockStatement(
+            "for(int " + index + "_off = " + std::to_string(window[dim].Minus) + "; " + index +
+                "_off <= " + std::to_string(window[dim].Plus) + "; ++" + index + "_off)",
+            [&]() {
+              stencilRunMethod.addStatement("const int " + index + " = " + index + "_col + " +
+                                            index + "_off");
+              generateWindowLoops(dim + 1);
+            });
+      };
+      generateWindowLoops(0);
+    }
+  };
+
+  // The loops of a group cover the extents of the stages evaluated at the current column
+  auto computeLoopExtents = [&](const FusedStageGroup& stageGroup) {
+    iir::Extents loopExtents = stageGroup.Stages.back()->getExtents();
+    for(std::size_t stageIdx = 0; stageIdx < stageGroup.Stages.size(); ++stageIdx)
+      if(stageGroup.Windows[stageIdx].isHorizontalPointwise())
+        loopExtents.merge(stageGroup.Stages[stageIdx]->getExtents());
+    return loopExtents;
+  };
+
+  const bool isBackward = multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward;
+  auto generateVerticalLoopOutermost = [&]() {
+    for(auto interval : computePartitionIntervals(multiStage)) {
+
+      // for each interval, we generate naive nested loops
+      stencilRunMethod.addBlockStatement(makeKLoop("m_dom", isBackward, interval), [&]() {
+        for(const FusedStageGroup& stageGroup : stageGroups) {
+          stencilBodyCXXVisitor.setColumnBufferWindows(stageGroup.LocalAccessIDs);
+          const iir::Extents loopExtents = computeLoopExtents(stageGroup);
+          addHorizontalLoops(stencilRunMethod, makeIJLoop(loopExtents[0], "m_dom", "i"),
+                             makeIJLoop(loopExtents[1], "m_dom", "j"),
+                             [&]() { generateStageGroup(stageGroup, loopExtents, interval); });
+        }
+      });
+    }
+  };
+
+  if(!context_->getOptions().Vectorize ||
+     !isVerticalLoopInnermostCapable(multiStage, scratchBufferWindows)) {
+    generateVerticalLoopOutermost();
+    return;
+  }
+
+  // The groups of a parallel multi-stage can also be computed one after the other over the whole
+  // interval, with the vertical loop as the innermost loop if the fields have a unit stride in k
+  stencilRunMethod.addBlockStatement("if(unit_stride_dim == 2)", [&]() {
+    for(auto interval : computePartitionIntervals(multiStage)) {
+      for(const FusedStageGroup& stageGroup : stageGroups) {
+        stencilBodyCXXVisitor.setColumnBufferWindows(stageGroup.LocalAccessIDs);
+        const iir::Extents loopExtents = computeLoopExtents(stageGroup);
+        addVerticalInnermostLoops(stencilRunMethod, makeIJLoop(loopExtents[0], "m_dom", "i"),
+                                  makeIJLoop(loopExtents[1], "m_dom", "j"),
+                                  makeKLoop("m_dom", isBackward, interval),
+                                  [&]() { generateStageGroup(stageGroup, loopExtents, interval); });
+      }
+    }
+  });
+  stencilRunMethod.addBlockStatement("else", generateVerticalLoopOutermost);
+}
+
 void CXXNaiveCodeGen::generateStencilFunctions(
     Class& stencilWrapperClass,
     const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
@@ -538,7 +1206,9 @@ std::unique_ptr<TranslationUnit> CXXNaiveCodeGen::generateCode() {
     stencils.emplace(nameStencilCtxPair.first, std::move(code));
   }
 
-  std::string globals = generateGlobals(context_->getSIR(), "cxxnaive");
+  std::string globals =
+      generateInstrumentationHooks() + generateBenchmarkRuntime() +
+      generateGlobals(context_->getSIR(), "cxxnaive");
 
   std::vector<std::string> ppDefines;
   auto makeDefine = [](std::string define, int value) {
@@ -17,8 +17,11 @@
 
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/CodeGenProperties.h"
+#include "dawn/IIR/Extents.h"
 #include "dawn/IIR/Interval.h"
 #include "dawn/Support/IndexRange.h"
+#include <functional>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -26,8 +29,12 @@
 
 namespace dawn {
 namespace iir {
+class MultiStage;
+class Stage;
+class Stencil;
 class StencilInstantiation;
-}
+class StencilMetaInformation;
+} // namespace iir
 
 class OptimizerContext;
 
@@ -43,10 +50,129 @@ public:
   virtual ~CXXNaiveCodeGen();
   virtual std::unique_ptr<TranslationUnit> generateCode() override;
 
-private:
+protected:
+  /// @brief Generate the header of the vertical loop over `interval`
+  static std::string makeKLoop(const std::string dom, bool isBackward,
+                               iir::Interval const& interval);
+
+  /// @brief Compute the partition of the intervals of the multi-stage, ordered in the loop order
+  static std::vector<iir::Interval> computePartitionIntervals(const iir::MultiStage& multiStage);
+
+  /// @brief Group of consecutive stages of a multi-stage computed within the same horizontal loops
+  ///
+  /// The loops run over the extents of the stages evaluated at the current column only. The stages
+  /// producing temporaries which are read with horizontal offsets by later stages of the group are
+  /// re-evaluated around the current column (the redundant halo is recomputed for every column) and
+  /// store these temporaries in per-column buffers.
+  struct FusedStageGroup {
+    std::vector<const iir::Stage*> Stages;
+
+    /// Column offsets, relative to the current column, at which each stage is evaluated
+    std::vector<iir::Extents> Windows;
+
+    /// Temporaries which are only accessed by the stages of the group, mapped to the window of
+    /// their writer (the size of their buffer). Temporaries of an empty window are kept in local
+    /// variables
+    std::map<int, iir::Extents> LocalAccessIDs;
+  };
+
+  /// @brief Partition the stages of the multi-stage into groups of consecutive stages whose
+  /// horizontal loops can be fused (see `computeColumnEvaluation`)
+  static std::vector<FusedStageGroup>
+  computeFusedStageGroups(const iir::StencilMetaInformation& metadata, const iir::Stencil& stencil,
+                          const iir::MultiStage& multiStage);
+
+  /// @brief Compute the windows and the local temporaries of the stages of `group`
+  ///
+  /// @returns false if the stages cannot be evaluated column by column, i.e a field written by the
+  /// group (other than a local temporary) is accessed with horizontal offsets or by a stage which
+  /// is evaluated around the current column
+  static bool computeColumnEvaluation(const iir::StencilMetaInformation& metadata,
+                                      const iir::Stencil& stencil, FusedStageGroup& group);
+
+  /// @brief Compute the temporaries of the stencil which are IJ- or K-cached by the only multi-stage
+  /// accessing them, mapped to the number of IJ-planes of their ring buffer (one for IJ-caches, the
+  /// vertical window of the accesses for K-caches)
+  static std::map<int, int>
+  computeScratchBufferWindows(const iir::StencilMetaInformation& metadata,
+                              const iir::Stencil& stencil);
+
+  /// @brief Declare the typedefs, meta-data and storages of the scratch buffers (except for the
+  /// storages of `localAccessIDs`)
+  void addScratchBufferDeclaration(Structure& stencilClass,
+                                   const iir::StencilMetaInformation& metadata,
+                                   const std::map<int, int>& scratchBufferWindows,
+                                   const std::set<int>& localAccessIDs) const;
+
+  /// @brief Initialize the meta-data and storages of the scratch buffers in the stencil constructor
+  /// (except for the storages of `localAccessIDs`)
+  void addScratchBufferInit(MemberFunction& ctr, const iir::StencilMetaInformation& metadata,
+                            const std::map<int, int>& scratchBufferWindows,
+                            const std::set<int>& localAccessIDs) const;
+
+  /// @brief Compute the temporaries of the stencil which the multi-stages allocate themselves,
+  /// hence without a storage in the stencil class (none in the naive backend)
+  virtual std::set<int> computeMultiStageLocalAccessIDs(const iir::Stencil& stencil) const {
+    return std::set<int>();
+  }
+
+  /// @brief Declare the raw pointer and the strides of the data view `fieldName` of `storageName`,
+  /// used by the field accesses of the vectorized code
+  static void addRawPointerDeclarations(MemberFunction& stencilRunMethod,
+                                        const std::string& fieldName,
+                                        const std::string& storageName);
+
+  /// @brief Declare `unit_stride_dim`, the dimension in which the data views `fieldNames` all have
+  /// a unit stride (1 if there is none), used to order the loops of the vectorized code
+  static void addUnitStrideDimDeclaration(MemberFunction& stencilRunMethod,
+                                          const std::vector<std::string>& fieldNames);
+
+  /// @brief Generate the `#pragma omp simd` of the innermost loop if vectorization is enabled
+  void addSimdPragma(MemberFunction& stencilRunMethod) const;
+
+  /// @brief Generate the horizontal loops `iLoop` and `jLoop` around `body`, preceded by
+  /// `outerPragma`
+  ///
+  /// If vectorization is enabled, the code dispatches on `unit_stride_dim` at runtime: the loop
+  /// over i is the innermost (vectorized) loop if the fields have a unit stride in i, otherwise the
+  /// loop over j is. The body is generated for both orders.
+  void addHorizontalLoops(MemberFunction& stencilRunMethod, const std::string& iLoop,
+                          const std::string& jLoop, const std::function<void()>& body,
+                          const std::string& outerPragma = "") const;
+
+  /// @brief Generate the loops `iLoop`, `jLoop` and the vectorized vertical loop `kLoop`, the
+  /// innermost one, around `body`, preceded by `outerPragma`
+  void addVerticalInnermostLoops(MemberFunction& stencilRunMethod, const std::string& iLoop,
+                                 const std::string& jLoop, const std::string& kLoop,
+                                 const std::function<void()>& body,
+                                 const std::string& outerPragma = "") const;
+
+  /// @brief Check if the vectorized code of `multiStage` can make the vertical loop the innermost
+  /// one, i.e if the multi-stage is parallel and none of its fields is stored in ring buffers of
+  /// IJ-planes (the stages are then computed one after the other over the whole interval)
+  static bool isVerticalLoopInnermostCapable(const iir::MultiStage& multiStage,
+                                             const std::map<int, int>& scratchBufferWindows);
+
   std::string generateStencilInstantiation(
       const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation);
 
+  /// @brief Check if a benchmark driver is generated next to each stencil
+  bool isBenchmarked() const { return context_->getOptions().Benchmark; }
+
+  /// @brief Generate the runtime of the benchmark drivers shared by all stencils (empty if no
+  /// benchmark driver is generated)
+  std::string generateBenchmarkRuntime() const;
+
+  /// @brief Generate the benchmark driver of the stencil wrapper of `stencilInstantiation`
+  ///
+  /// The driver allocates the API fields on a domain with the halos accessed by the stencils,
+  /// fills them with deterministic data and times the `run` method. The driver registers itself in
+  /// the benchmark runtime, which reports the bandwidth and the flop rate of each stencil.
+  void
+  generateBenchmarkDriver(std::stringstream& ss,
+                          const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                          const CodeGenProperties& codeGenProperties) const;
+
   void
   generateStencilFunctions(Class& stencilWrapperClass,
                            const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
@@ -55,6 +181,13 @@ private:
   void generateStencilClasses(const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
                               Class& stencilWrapperClass,
                               const CodeGenProperties& codeGenProperties) const;
+
+  /// @brief Generate the loops of the multi-stage into the run method of the stencil (the data
+  /// views of all fields of the stencil are already declared)
+  virtual void
+  generateMultiStage(MemberFunction& stencilRunMethod,
+                     const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                     const iir::Stencil& stencil, const iir::MultiStage& multiStage) const;
   void generateStencilWrapperMembers(
       Class& stencilWrapperClass,
       const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
@@ -69,6 +202,9 @@ private:
   generateStencilWrapperRun(Class& stencilWrapperClass,
                             const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
                             const CodeGenProperties& codeGenProperties) const;
+
+  const std::string scratchMetadataTypename_ = "scratch_meta_data_t";
+  const std::string scratchStorageTypename_ = "scratch_storage_t";
 };
 } // namespace cxxnaive
 } // namespace codegen
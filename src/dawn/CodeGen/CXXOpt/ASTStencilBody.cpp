@@ -0,0 +1,46 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/ASTStencilBody.h"
+#include "dawn/SIR/AST.h"
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+ASTStencilBody::ASTStencilBody(const iir::StencilMetaInformation& metadata,
+                               const std::set<int>& tileLocalAccessIDs)
+    : Base(metadata, StencilContext::SC_Stencil), tileLocalAccessIDs_(tileLocalAccessIDs) {}
+
+ASTStencilBody::~ASTStencilBody() {}
+
+void ASTStencilBody::visit(const std::shared_ptr<FieldAccessExpr>& expr) {
+  if(currentFunction_ || !tileLocalAccessIDs_.count(getAccessID(expr))) {
+    Base::visit(expr);
+    return;
+  }
+
+  std::string accessName = getName(expr);
+  const auto& offset = expr->getOffset();
+  std::array<std::string, 3> indices{"i", "j", "k"};
+  for(int dim = 0; dim < 3; ++dim)
+    indices[dim] += "+" + std::to_string(offset[dim]) + "+" + accessName + "_offsets[" +
+                    std::to_string(dim) + "]";
+  indices[2] = makeScratchBufferKIndex(getAccessID(expr), indices[2]);
+  ss_ << makeFieldAccess(accessName, indices);
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
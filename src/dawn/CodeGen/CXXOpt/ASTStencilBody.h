@@ -0,0 +1,55 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_ASTSTENCILBODY_H
+#define DAWN_CODEGEN_CXXOPT_ASTSTENCILBODY_H
+
+#include "dawn/CodeGen/CXXNaive/ASTStencilBody.h"
+#include <set>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+/// @brief ASTVisitor to generate the optimized C++ code for the stencil bodies
+///
+/// Identical to the naive C++ code generation except for the accesses to tile-local temporaries,
+/// which are indexed relative to the origin of the current tile (given by `<field>_offsets`).
+/// @ingroup cxxopt
+class ASTStencilBody : public cxxnaive::ASTStencilBody {
+  /// AccessIDs of the temporaries which are stored per tile
+  const std::set<int>& tileLocalAccessIDs_;
+
+public:
+  using Base = cxxnaive::ASTStencilBody;
+
+  /// @brief constructor
+  ASTStencilBody(const iir::StencilMetaInformation& metadata,
+                 const std::set<int>& tileLocalAccessIDs);
+
+  virtual ~ASTStencilBody();
+
+  using Base::visit;
+
+  /// @name Expression implementation
+  /// @{
+  virtual void visit(const std::shared_ptr<FieldAccessExpr>& expr) override;
+  /// @}
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
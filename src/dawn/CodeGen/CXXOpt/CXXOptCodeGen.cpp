@@ -0,0 +1,364 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/CXXOptCodeGen.h"
+#include "dawn/CodeGen/CXXOpt/ASTStencilBody.h"
+#include "dawn/CodeGen/CXXUtil.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Support/Logging.h"
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+namespace {
+
+const std::string iEnd = "m_dom.isize() - m_dom.iplus() - 1";
+const std::string jEnd = "m_dom.jsize() - m_dom.jplus() - 1";
+
+/// Default size of the tiles in i- and j-direction if no block size is given. The block size set by
+/// `PassSetBlockSize` is tailored to the thread blocks of GPUs, tiles on CPUs should instead keep
+/// their temporaries in the cache while leaving long stride-one loops in i-direction.
+const std::array<unsigned int, 2> defaultTileSize{{64, 4}};
+
+std::string makeLoop(const std::string& dim, const std::string& lower, const std::string& upper,
+                     const std::string& increment) {
+  return "for(int " + dim + " = " + lower + "; " + dim + " <= " + upper + "; " + increment + ")";
+}
+
+std::string makeExtendedBound(const std::string& bound, int extent) {
+  return bound + "+" + std::to_string(extent);
+}
+
+/// @brief Temporaries of the stencil which are only accessed within the multi-stage
+std::set<int> computeTileLocalAccessIDs(const iir::Stencil& stencil,
+                                        const iir::MultiStage& multiStage) {
+  std::set<int> accessIDs;
+  const auto& stencilFields = stencil.getFields();
+  for(const auto& AccessIDFieldPair : multiStage.getFields()) {
+    const int AccessID = AccessIDFieldPair.first;
+    auto fieldIt = stencilFields.find(AccessID);
+    if(fieldIt == stencilFields.end() || !fieldIt->second.IsTemporary)
+      continue;
+
+    bool isAccessedByOtherMultiStages = false;
+    for(const auto& multiStagePtr : stencil.getChildren())
+      if(multiStagePtr.get() != &multiStage && multiStagePtr->getFields().count(AccessID))
+        isAccessedByOtherMultiStages = true;
+
+    if(!isAccessedByOtherMultiStages)
+      accessIDs.insert(AccessID);
+  }
+  return accessIDs;
+}
+
+/// @brief Check if the stages of the multi-stage can be fused within a tile
+///
+/// Points outside of a tile are computed redundantly by the neighbouring tiles. This is only safe
+/// if the fields which are shared between the tiles and written by the multi-stage are exclusively
+/// accessed at the points of the tile itself.
+bool isFusableInTiles(const iir::MultiStage& multiStage, const std::set<int>& tileLocalAccessIDs) {
+  std::unordered_set<int> writtenAccessIDs;
+  for(const auto& stagePtr : multiStage.getChildren())
+    for(const auto& AccessIDFieldPair : stagePtr->getFields())
+      if(AccessIDFieldPair.second.getIntend() != iir::Field::IK_Input)
+        writtenAccessIDs.insert(AccessIDFieldPair.first);
+
+  for(const auto& stagePtr : multiStage.getChildren()) {
+    for(const auto& AccessIDFieldPair : stagePtr->getFields()) {
+      const int AccessID = AccessIDFieldPair.first;
+      if(tileLocalAccessIDs.count(AccessID) || !writtenAccessIDs.count(AccessID))
+        continue;
+
+      if(!stagePtr->getExtents().isHorizontalPointwise() ||
+         !AccessIDFieldPair.second.getExtents().isHorizontalPointwise())
+        return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Generate the statements of the Do-Methods of the stage which overlap with `interval`
+void generateStageBody(MemberFunction& stencilRunMethod, const iir::Stage& stage,
+                       const iir::Interval& interval, ASTStencilBody& stencilBodyCXXVisitor) {
+  for(const auto& doMethodPtr : stage.getChildren()) {
+    const iir::DoMethod& doMethod = *doMethodPtr;
+    if(!doMethod.getInterval().overlaps(interval))
+      continue;
+    for(const auto& statementAccessesPair : doMethod.getChildren()) {
+      statementAccessesPair->getStatement()->ASTStmt->accept(stencilBodyCXXVisitor);
+      stencilRunMethod << stencilBodyCXXVisitor.getCodeAndResetStream();
+    }
+  }
+}
+
+} // anonymous namespace
+
+CXXOptCodeGen::CXXOptCodeGen(OptimizerContext* context) : CXXNaiveCodeGen(context) {}
+
+CXXOptCodeGen::~CXXOptCodeGen() {}
+
+void CXXOptCodeGen::generateMultiStage(
+    MemberFunction& stencilRunMethod,
+    const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    const iir::Stencil& stencil, const iir::MultiStage& multiStage) const {
+  std::set<int> tileLocalAccessIDs = computeTileLocalAccessIDs(stencil, multiStage);
+  std::map<int, int> scratchBufferWindows =
+      computeScratchBufferWindows(stencilInstantiation->getMetaData(), stencil);
+
+  if(isFusableInTiles(multiStage, tileLocalAccessIDs)) {
+    generateTiledMultiStage(stencilRunMethod, stencilInstantiation, stencil, multiStage,
+                            tileLocalAccessIDs, scratchBufferWindows);
+  } else {
+    DAWN_LOG(INFO) << stencilInstantiation->getName() << ": multi-stage "
+                   << multiStage.getID()
+                   << " writes fields which are accessed outside of the tiles, "
+                      "generating stage-wise parallel loops";
+    generateStagewiseMultiStage(stencilRunMethod, stencilInstantiation, multiStage,
+                                scratchBufferWindows);
+  }
+}
+
+std::set<int> CXXOptCodeGen::computeMultiStageLocalAccessIDs(const iir::Stencil& stencil) const {
+  std::set<int> localAccessIDs;
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    std::set<int> tileLocalAccessIDs = computeTileLocalAccessIDs(stencil, *multiStagePtr);
+    if(isFusableInTiles(*multiStagePtr, tileLocalAccessIDs))
+      localAccessIDs.insert(tileLocalAccessIDs.begin(), tileLocalAccessIDs.end());
+  }
+  return localAccessIDs;
+}
+
+void CXXOptCodeGen::generateTiledMultiStage(
+    MemberFunction& stencilRunMethod,
+    const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    const iir::Stencil& stencil, const iir::MultiStage& multiStage,
+    const std::set<int>& tileLocalAccessIDs, const std::map<int, int>& scratchBufferWindows) const {
+  const auto& metadata = stencilInstantiation->getMetaData();
+  std::array<unsigned int, 2> tileSize = defaultTileSize;
+  if(!context_->getOptions().block_size.empty()) {
+    const auto& blockSize = stencilInstantiation->getIIR()->getBlockSize();
+    tileSize = {{std::max(blockSize[0], 1u), std::max(blockSize[1], 1u)}};
+  }
+  const bool isBackward = multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward;
+
+  ASTStencilBody stencilBodyCXXVisitor(metadata, tileLocalAccessIDs);
+  stencilBodyCXXVisitor.setVectorize(context_->getOptions().Vectorize);
+  stencilBodyCXXVisitor.setScratchBufferWindows(scratchBufferWindows);
+
+  // The halo of the tiles is the union of the extents of all stages
+  iir::Extent iHalo, jHalo;
+  for(const auto& stagePtr : multiStage.getChildren()) {
+    iHalo.merge(stagePtr->getExtents()[0]);
+    jHalo.merge(stagePtr->getExtents()[1]);
+  }
+
+  stencilRunMethod.addStatement("const int tile_isize = " + std::to_string(tileSize[0]));
+  stencilRunMethod.addStatement("const int tile_jsize = " + std::to_string(tileSize[1]));
+
+  stencilRunMethod.ss() << "\n#pragma omp parallel\n";
+  stencilRunMethod.addBlockStatement("", [&]() {
+    // Each thread owns the storages of the tile-local temporaries, the stencil does not allocate
+    // them (see `computeMultiStageLocalAccessIDs`). Cached temporaries only keep the IJ-planes of
+    // their window.
+    const std::string tileSizes = "tile_isize+" + std::to_string(iHalo.Plus - iHalo.Minus) +
+                                  ", tile_jsize+" + std::to_string(jHalo.Plus - jHalo.Minus);
+    std::set<int> windows;
+    bool hasFullTemporaries = false;
+    for(int AccessID : tileLocalAccessIDs) {
+      auto windowIt = scratchBufferWindows.find(AccessID);
+      if(windowIt != scratchBufferWindows.end())
+        windows.insert(windowIt->second);
+      else
+        hasFullTemporaries = true;
+    }
+    if(hasFullTemporaries)
+      stencilRunMethod.addStatement(tmpMetadataTypename_ + " m_tile_meta_data(" + tileSizes +
+                                    ", m_dom.ksize() + 2*" +
+                                    std::to_string(getVerticalTmpHaloSize(stencil)) + ")");
+    for(int window : windows)
+      stencilRunMethod.addStatement(scratchMetadataTypename_ + " m_tile_scratch_meta_data_" +
+                                    std::to_string(window) + "(" + tileSizes + ", " +
+                                    std::to_string(window) + ")");
+
+    for(int AccessID : tileLocalAccessIDs) {
+      const std::string fieldName = metadata.getFieldNameFromAccessID(AccessID);
+      auto windowIt = scratchBufferWindows.find(AccessID);
+      const std::string& storageTypename =
+          windowIt != scratchBufferWindows.end() ? scratchStorageTypename_ : tmpStorageTypename_;
+      const std::string tileMetadataName =
+          windowIt != scratchBufferWindows.end()
+              ? "m_tile_scratch_meta_data_" + std::to_string(windowIt->second)
+              : "m_tile_meta_data";
+      stencilRunMethod.addStatement(storageTypename + " m_tile_" + fieldName + "(" +
+                                    tileMetadataName + ")");
+      stencilRunMethod.addStatement(c_gt() + "data_view<" + storageTypename + "> " + fieldName +
+                                    "= " + c_gt() + "make_host_view(m_tile_" + fieldName + ")");
+      stencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+      if(context_->getOptions().Vectorize)
+        addRawPointerDeclarations(stencilRunMethod, fieldName, "m_tile_" + fieldName);
+    }
+
+    stencilRunMethod.ss() << "\n#pragma omp for collapse(2) schedule(static)\n";
+    stencilRunMethod.addBlockStatement(
+        makeLoop("tile_i", "m_dom.iminus()", iEnd, "tile_i += tile_isize"), [&]() {
+          stencilRunMethod.addBlockStatement(
+              makeLoop("tile_j", "m_dom.jminus()", jEnd, "tile_j += tile_jsize"), [&]() {
+                stencilRunMethod.addStatement("const int tile_iend = std::min(tile_i + "
+                                              "tile_isize - 1, " +
+                                              iEnd + ")");
+                stencilRunMethod.addStatement("const int tile_jend = std::min(tile_j + "
+                                              "tile_jsize - 1, " +
+                                              jEnd + ")");
+
+                // Move the origin of the tile-local temporaries to the origin of the tile
+                for(int AccessID : tileLocalAccessIDs)
+                  stencilRunMethod.addStatement(
+                      metadata.getFieldNameFromAccessID(AccessID) +
+                      "_offsets = std::array<int,3>{{" + std::to_string(-iHalo.Minus) +
+                      " - tile_i, " + std::to_string(-jHalo.Minus) + " - tile_j, 0}}");
+
+                auto generateVerticalLoopOutermost = [&]() {
+                  for(auto interval : computePartitionIntervals(multiStage)) {
+                    stencilRunMethod.addBlockStatement(
+                        makeKLoop("m_dom", isBackward, interval), [&]() {
+                          for(const auto& stagePtr : multiStage.getChildren()) {
+                            const iir::Stage& stage = *stagePtr;
+                            const iir::Extents& extents = stage.getExtents();
+                            addHorizontalLoops(
+                                stencilRunMethod,
+                                makeLoop("i", makeExtendedBound("tile_i", extents[0].Minus),
+                                         makeExtendedBound("tile_iend", extents[0].Plus), "++i"),
+                                makeLoop("j", makeExtendedBound("tile_j", extents[1].Minus),
+                                         makeExtendedBound("tile_jend", extents[1].Plus), "++j"),
+                                [&]() {
+                                  generateStageBody(stencilRunMethod, stage, interval,
+                                                    stencilBodyCXXVisitor);
+                                });
+                          }
+                        });
+                  }
+                };
+
+                if(!context_->getOptions().Vectorize ||
+                   !isVerticalLoopInnermostCapable(multiStage, scratchBufferWindows)) {
+                  generateVerticalLoopOutermost();
+                  return;
+                }
+
+                // The stages are computed one after the other over the whole interval, with the
+                // vertical loop as the innermost loop if the fields have a unit stride in k
+                stencilRunMethod.addBlockStatement("if(unit_stride_dim == 2)", [&]() {
+                  for(auto interval : computePartitionIntervals(multiStage)) {
+                    for(const auto& stagePtr : multiStage.getChildren()) {
+                      const iir::Stage& stage = *stagePtr;
+                      const iir::Extents& extents = stage.getExtents();
+                      addVerticalInnermostLoops(
+                          stencilRunMethod,
+                          makeLoop("i", makeExtendedBound("tile_i", extents[0].Minus),
+                                   makeExtendedBound("tile_iend", extents[0].Plus), "++i"),
+                          makeLoop("j", makeExtendedBound("tile_j", extents[1].Minus),
+                                   makeExtendedBound("tile_jend", extents[1].Plus), "++j"),
+                          makeKLoop("m_dom", isBackward, interval), [&]() {
+                            generateStageBody(stencilRunMethod, stage, interval,
+                                              stencilBodyCXXVisitor);
+                          });
+                    }
+                  }
+                });
+                stencilRunMethod.addBlockStatement("else", generateVerticalLoopOutermost);
+              });
+        });
+  });
+}
+
+void CXXOptCodeGen::generateStagewiseMultiStage(
+    MemberFunction& stencilRunMethod,
+    const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    const iir::MultiStage& multiStage, const std::map<int, int>& scratchBufferWindows) const {
+  const bool isBackward = multiStage.getLoopOrder() == iir::LoopOrderKind::LK_Backward;
+
+  std::set<int> tileLocalAccessIDs;
+  ASTStencilBody stencilBodyCXXVisitor(stencilInstantiation->getMetaData(), tileLocalAccessIDs);
+  stencilBodyCXXVisitor.setVectorize(context_->getOptions().Vectorize);
+  stencilBodyCXXVisitor.setScratchBufferWindows(scratchBufferWindows);
+
+  // The threads are created once for the multistage and each stage is distributed among them, the
+  // implicit barrier at the end of the work-sharing loops orders the stages. If the innermost loop
+  // is vectorized, only the outer loop is distributed among the threads.
+  const std::string parallelFor = context_->getOptions().Vectorize
+                                      ? "\n#pragma omp for schedule(static)\n"
+                                      : "\n#pragma omp for collapse(2) schedule(static)\n";
+
+  auto generateVerticalLoopOutermost = [&]() {
+    for(auto interval : computePartitionIntervals(multiStage)) {
+      stencilRunMethod.addBlockStatement(makeKLoop("m_dom", isBackward, interval), [&]() {
+        for(const auto& stagePtr : multiStage.getChildren()) {
+          const iir::Stage& stage = *stagePtr;
+          const iir::Extents& extents = stage.getExtents();
+          addHorizontalLoops(
+              stencilRunMethod,
+              makeLoop("i", makeExtendedBound("m_dom.iminus()", extents[0].Minus),
+                       makeExtendedBound(iEnd, extents[0].Plus), "++i"),
+              makeLoop("j", makeExtendedBound("m_dom.jminus()", extents[1].Minus),
+                       makeExtendedBound(jEnd, extents[1].Plus), "++j"),
+              [&]() {
+                generateStageBody(stencilRunMethod, stage, interval, stencilBodyCXXVisitor);
+              },
+              parallelFor);
+        }
+      });
+    }
+  };
+
+  stencilRunMethod.ss() << "\n#pragma omp parallel\n";
+  stencilRunMethod.addBlockStatement("", [&]() {
+    if(!context_->getOptions().Vectorize ||
+       !isVerticalLoopInnermostCapable(multiStage, scratchBufferWindows)) {
+      generateVerticalLoopOutermost();
+      return;
+    }
+
+    // The stages are computed one after the other over the whole interval, with the vertical loop
+    // as the innermost loop if the fields have a unit stride in k
+    stencilRunMethod.addBlockStatement("if(unit_stride_dim == 2)", [&]() {
+      for(auto interval : computePartitionIntervals(multiStage)) {
+        for(const auto& stagePtr : multiStage.getChildren()) {
+          const iir::Stage& stage = *stagePtr;
+          const iir::Extents& extents = stage.getExtents();
+          addVerticalInnermostLoops(
+              stencilRunMethod,
+              makeLoop("i", makeExtendedBound("m_dom.iminus()", extents[0].Minus),
+                       makeExtendedBound(iEnd, extents[0].Plus), "++i"),
+              makeLoop("j", makeExtendedBound("m_dom.jminus()", extents[1].Minus),
+                       makeExtendedBound(jEnd, extents[1].Plus), "++j"),
+              makeKLoop("m_dom", isBackward, interval),
+              [&]() {
+                generateStageBody(stencilRunMethod, stage, interval, stencilBodyCXXVisitor);
+              },
+              parallelFor);
+        }
+      }
+    });
+    stencilRunMethod.addBlockStatement("else", generateVerticalLoopOutermost);
+  });
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
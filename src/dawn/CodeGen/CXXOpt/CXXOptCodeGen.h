@@ -0,0 +1,74 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_CXXOPTCODEGEN_H
+#define DAWN_CODEGEN_CXXOPT_CXXOPTCODEGEN_H
+
+#include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+#include <set>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+/// @brief Optimized C++ code generation for CPUs
+///
+/// The horizontal plane is cut into tiles (of 64x4 points, unless `-block-size` is given). Each
+/// tile executes all stages of a multi-stage (for all vertical levels, in the loop order of the
+/// multi-stage) and computes the extents of the stages redundantly. Temporaries which do not
+/// outlive the multi-stage are stored per tile, in ring buffers of IJ-planes if they are cached.
+/// The tiles are processed concurrently with OpenMP, which, for forward and backward multi-stages,
+/// amounts to parallelizing over blocks of (i,j) columns.
+///
+/// If redundant computations would write to (or read from) fields shared between the tiles, the
+/// stages of the multi-stage are executed one after another, each parallelized over the horizontal
+/// plane.
+///
+/// The generated code is compatible with the runtime of the naive C++ backend.
+/// @ingroup cxxopt
+class CXXOptCodeGen : public cxxnaive::CXXNaiveCodeGen {
+public:
+  ///@brief constructor
+  CXXOptCodeGen(OptimizerContext* context);
+  virtual ~CXXOptCodeGen();
+
+protected:
+  virtual void
+  generateMultiStage(MemberFunction& stencilRunMethod,
+                     const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                     const iir::Stencil& stencil, const iir::MultiStage& multiStage) const override;
+
+  /// @brief The tile-local temporaries of the multi-stages fused within tiles are allocated per
+  /// tile
+  virtual std::set<int>
+  computeMultiStageLocalAccessIDs(const iir::Stencil& stencil) const override;
+
+private:
+  void generateTiledMultiStage(MemberFunction& stencilRunMethod,
+                               const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                               const iir::Stencil& stencil, const iir::MultiStage& multiStage,
+                               const std::set<int>& tileLocalAccessIDs,
+                               const std::map<int, int>& scratchBufferWindows) const;
+
+  void generateStagewiseMultiStage(
+      MemberFunction& stencilRunMethod,
+      const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+      const iir::MultiStage& multiStage, const std::map<int, int>& scratchBufferWindows) const;
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
@@ -1,5 +1,6 @@
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/StencilFunctionAsBCGenerator.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
 
 namespace dawn {
 namespace codegen {
@@ -348,5 +349,96 @@ void CodeGen::addMplIfdefs(std::vector<std::string>& ppDefines, int mplContainer
       makeIfNotDefinedString("BOOST_MPL_LIMIT_VECTOR_SIZE", "GT_VECTOR_LIMIT_SIZE"));
 }
 
+std::string CodeGen::generateInstrumentationHooks() const {
+  if(!isInstrumented())
+    return "";
+
+  // The interface is shared by all the generated stencils of a program, hence the include guard
+  return R"(#ifndef DAWN_INSTRUMENTATION_HOOKS
+#define DAWN_INSTRUMENTATION_HOOKS
+#include <cstddef>
+
+namespace dawn_instrumentation {
+
+/// Execution of a stencil (multistage_id < 0) or of one of its multi-stages
+struct probe {
+  const char* stencil_instantiation;
+  int stencil_id;
+  int multistage_id;
+  std::size_t bytes_read;
+  std::size_t bytes_written;
+};
+
+/// Callbacks invoked before and after each probed execution
+struct hooks {
+  virtual ~hooks() {}
+  virtual void begin(const probe& p) = 0;
+  virtual void end(const probe& p) = 0;
+};
+
+inline hooks*& current_hooks() {
+  static hooks* h = nullptr;
+  return h;
+}
+
+/// Register the hooks called by the probes (nullptr disables them)
+inline void set_hooks(hooks* h) { current_hooks() = h; }
+
+#ifdef DAWN_DISABLE_INSTRUMENTATION
+inline bool enabled() { return false; }
+inline void begin(const probe&) {}
+inline void end(const probe&) {}
+#else
+inline bool enabled() { return current_hooks() != nullptr; }
+inline void begin(const probe& p) {
+  if(hooks* h = current_hooks())
+    h->begin(p);
+}
+inline void end(const probe& p) {
+  if(hooks* h = current_hooks())
+    h->end(p);
+}
+#endif
+
+} // namespace dawn_instrumentation
+#endif
+)";
+}
+
+void CodeGen::addInstrumentationBegin(MemberFunction& function, const std::string& probeName,
+                                      const iir::StencilInstantiation& stencilInstantiation,
+                                      const iir::Stencil& stencil,
+                                      const iir::MultiStage* multiStage,
+                                      const std::string& dom) const {
+  // Accesses per grid point
+  std::size_t numReads = 0, numWrites = 0;
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    if(multiStage && multiStagePtr.get() != multiStage)
+      continue;
+    auto readAndWrite = computeReadWriteAccessesMetric(stencilInstantiation, *multiStagePtr);
+    numReads += readAndWrite.first;
+    numWrites += readAndWrite.second;
+  }
+
+  std::string numGridPoints = "static_cast<std::size_t>(" + dom + ".isize() - " + dom +
+                              ".iminus() - " + dom + ".iplus()) * (" + dom + ".jsize() - " + dom +
+                              ".jminus() - " + dom + ".jplus()) * (" + dom + ".ksize() - " + dom +
+                              ".kminus() - " + dom + ".kplus())";
+  std::string bytesPerAccess = "sizeof(" + c_gtc().str() + "float_type)";
+
+  function.addStatement("const std::size_t " + probeName + "_points = " + numGridPoints);
+  function.addStatement(
+      "const dawn_instrumentation::probe " + probeName + "{\"" + stencilInstantiation.getName() +
+      "\", " + std::to_string(stencil.getStencilID()) + ", " +
+      std::to_string(multiStage ? multiStage->getID() : -1) + ", " + std::to_string(numReads) +
+      " * " + bytesPerAccess + " * " + probeName + "_points, " + std::to_string(numWrites) + " * " +
+      bytesPerAccess + " * " + probeName + "_points}");
+  function.addStatement("dawn_instrumentation::begin(" + probeName + ")");
+}
+
+void CodeGen::addInstrumentationEnd(MemberFunction& function, const std::string& probeName) const {
+  function.addStatement("dawn_instrumentation::end(" + probeName + ")");
+}
+
 } // namespace codegen
 } // namespace dawn
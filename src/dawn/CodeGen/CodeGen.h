@@ -20,6 +20,7 @@
 #include "dawn/CodeGen/TranslationUnit.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/IndexRange.h"
+#include "dawn/Support/SmallIntMap.h"
 #include <memory>
 
 namespace dawn {
@@ -34,6 +35,11 @@ extern std::map<Key, Value> orderMap(const std::unordered_map<Key, Value>& umap)
   return m;
 }
 
+template <typename Value, unsigned N>
+std::map<int, Value> orderMap(const SmallIntMap<Value, N>& map) {
+  return std::map<int, Value>(map.begin(), map.end());
+}
+
 /// @brief Interface of the backend code generation
 /// @ingroup codegen
 class CodeGen {
@@ -64,6 +70,26 @@ protected:
   void addMplIfdefs(std::vector<std::string>& ppDefines, int mplContainerMaxSize,
                     int MaxHaloPoints) const;
 
+  /// @brief Check if the stencils and multi-stages are wrapped in instrumentation probes
+  bool isInstrumented() const { return context_->getOptions().Instrument; }
+
+  /// @brief Generate the instrumentation interface the probes call into (empty if the code is not
+  /// instrumented)
+  std::string generateInstrumentationHooks() const;
+
+  /// @brief Declare the probe `probeName` and call its begin hook
+  ///
+  /// The probe carries the number of bytes read and written by the stencil (or by the multi-stage
+  /// if `multiStage` is given) estimated from the data-locality metric and the size of the compute
+  /// domain `dom`.
+  void addInstrumentationBegin(MemberFunction& function, const std::string& probeName,
+                               const iir::StencilInstantiation& stencilInstantiation,
+                               const iir::Stencil& stencil, const iir::MultiStage* multiStage,
+                               const std::string& dom) const;
+
+  /// @brief Call the end hook of the probe `probeName`
+  void addInstrumentationEnd(MemberFunction& function, const std::string& probeName) const;
+
   const std::string tmpStorageTypename_ = "tmp_storage_t";
   const std::string tmpMetadataTypename_ = "tmp_meta_data_t";
   const std::string tmpMetadataName_ = "m_tmp_meta_data";
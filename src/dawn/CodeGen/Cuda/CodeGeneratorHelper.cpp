@@ -112,10 +112,9 @@ iir::Extents CodeGeneratorHelper::computeTempMaxWriteExtent(iir::Stencil const&
   return maxExtents;
 }
 
-bool CodeGeneratorHelper::hasAccessIDMemAccess(const int accessID,
-                                               const std::unique_ptr<iir::Stencil>& stencil) {
+bool CodeGeneratorHelper::hasAccessIDMemAccess(const int accessID, const iir::Stencil& stencil) {
 
-  for(const auto& ms : stencil->getChildren()) {
+  for(const auto& ms : stencil.getChildren()) {
     if(!ms->hasField(accessID))
       continue;
     if(!ms->isCached(accessID))
@@ -130,10 +129,10 @@ bool CodeGeneratorHelper::hasAccessIDMemAccess(const int accessID,
   return false;
 }
 
-bool CodeGeneratorHelper::useTemporaries(const std::unique_ptr<iir::Stencil>& stencil,
+bool CodeGeneratorHelper::useTemporaries(const iir::Stencil& stencil,
                                          const iir::StencilMetaInformation& metadata) {
 
-  const auto& fields = stencil->getFields();
+  const auto& fields = stencil.getFields();
   const bool containsMemTemporary =
       (find_if(fields.begin(), fields.end(),
                [&](const std::pair<int, iir::Stencil::FieldInfo>& field) {
@@ -144,7 +143,7 @@ bool CodeGeneratorHelper::useTemporaries(const std::unique_ptr<iir::Stencil>& st
                  return hasAccessIDMemAccess(accessID, stencil);
                }) != fields.end());
 
-  return containsMemTemporary && stencil->containsRedundantComputations();
+  return containsMemTemporary && stencil.containsRedundantComputations();
 }
 
 void CodeGeneratorHelper::generateFieldAccessDeref(
@@ -155,7 +154,7 @@ void CodeGeneratorHelper::generateFieldAccessDeref(
   bool isTemporary = metadata.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, accessID);
   DAWN_ASSERT(fieldIndexMap.count(accessID) || isTemporary);
   const auto& field = ms->getField(accessID);
-  bool useTmpIndex = isTemporary && useTemporaries(ms->getParent(), metadata);
+  bool useTmpIndex = isTemporary && useTemporaries(*ms->getParent(), metadata);
   std::string index =
       useTmpIndex ? "idx_tmp"
                   : "idx" + CodeGeneratorHelper::indexIteratorName(fieldIndexMap.at(accessID));
@@ -50,8 +50,7 @@ public:
                                                 const Array3i iteratorDims);
 
   /// @brief determines wheter an accessID will perform an access to main memory
-  static bool hasAccessIDMemAccess(const int accessID,
-                                   const std::unique_ptr<iir::Stencil>& stencil);
+  static bool hasAccessIDMemAccess(const int accessID, const iir::Stencil& stencil);
 
   /// @brief return true if the ms can be solved in parallel (in the vertical dimension)
   static bool solveKLoopInParallel(const std::unique_ptr<iir::MultiStage>& ms);
@@ -64,7 +63,7 @@ public:
   /// Even if the stencil contains temporaries, in some cases, like when they are local cached, they
   /// are not required for code generation. Also in the case of no redundant computations,
   /// temporaries will become normal fields
-  static bool useTemporaries(const std::unique_ptr<iir::Stencil>& stencil,
+  static bool useTemporaries(const iir::Stencil& stencil,
                              const iir::StencilMetaInformation& metadata);
 
   /// @brief computes the maximum extent required by all temporaries, which will be used for proper
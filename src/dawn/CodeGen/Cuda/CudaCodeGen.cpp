@@ -462,6 +462,14 @@ void CudaCodeGen::generateStencilRunMethod(
   StencilRunMethod.addComment("starting timers");
   StencilRunMethod.addStatement("start()");
 
+  // The kernels are launched asynchronously, the probes wait for their completion if hooks are
+  // registered
+  if(isInstrumented()) {
+    StencilRunMethod.addStatement("if(dawn_instrumentation::enabled()) cudaDeviceSynchronize()");
+    addInstrumentationBegin(StencilRunMethod, "stencil_probe", *stencilInstantiation, stencil,
+                            nullptr, "m_dom");
+  }
+
   for(const auto& multiStagePtr : stencil.getChildren()) {
     StencilRunMethod.addStatement("{");
 
@@ -590,7 +598,7 @@ void CudaCodeGen::generateStencilRunMethod(
       // in some cases (where there are no horizontal extents) we dont use the special tmp index
       // iterator, but rather a normal 3d field index iterator. In that case we pass temporaries in
       // the same manner as normal fields
-      if(!CodeGeneratorHelper::useTemporaries(multiStagePtr->getParent(), metadata)) {
+      if(!CodeGeneratorHelper::useTemporaries(*multiStagePtr->getParent(), metadata)) {
         const auto fieldName = metadata.getFieldNameFromAccessID((*field).second.getAccessID());
 
         args = args + ", (" + fieldName + ".data()+" + "m_" + fieldName +
@@ -609,11 +617,23 @@ void CudaCodeGen::generateStencilRunMethod(
 
     kernelCall = kernelCall + "nx,ny,nz," + RangeToString(",", "", "")(strides) + "," + args + ")";
 
+    if(isInstrumented())
+      addInstrumentationBegin(StencilRunMethod, "multistage_probe", *stencilInstantiation, stencil,
+                              &multiStage, "m_dom");
+
     StencilRunMethod.addStatement(kernelCall);
 
+    if(isInstrumented()) {
+      StencilRunMethod.addStatement("if(dawn_instrumentation::enabled()) cudaDeviceSynchronize()");
+      addInstrumentationEnd(StencilRunMethod, "multistage_probe");
+    }
+
     StencilRunMethod.addStatement("}");
   }
 
+  if(isInstrumented())
+    addInstrumentationEnd(StencilRunMethod, "stencil_probe");
+
   StencilRunMethod.addComment("stopping timers");
   StencilRunMethod.addStatement("pause()");
 
@@ -679,7 +699,8 @@ std::unique_ptr<TranslationUnit> CudaCodeGen::generateCode() {
     stencils.emplace(nameStencilCtxPair.first, std::move(code));
   }
 
-  std::string globals = generateGlobals(context_->getSIR(), "cuda");
+  std::string globals =
+      generateInstrumentationHooks() + generateGlobals(context_->getSIR(), "cuda");
 
   std::vector<std::string> ppDefines;
   auto makeDefine = [](std::string define, int value) {
@@ -61,7 +61,10 @@ void ASTStencilDesc::visit(const std::shared_ptr<StencilCallDeclStmt>& stmt) {
 
   std::string stencilName =
       codeGenProperties_.getStencilName(StencilContext::SC_Stencil, StencilID);
-  ss_ << std::string(indent_, ' ') << "m_" << stencilName << ".get_stencil()->run();\n";
+  if(instrumented_)
+    ss_ << std::string(indent_, ' ') << "m_" << stencilName << ".run();\n";
+  else
+    ss_ << std::string(indent_, ' ') << "m_" << stencilName << ".get_stencil()->run();\n";
 }
 
 void ASTStencilDesc::visit(const std::shared_ptr<BoundaryConditionDeclStmt>& stmt) {
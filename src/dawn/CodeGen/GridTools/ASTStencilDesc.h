@@ -36,6 +36,9 @@ protected:
   const CodeGenProperties& codeGenProperties_;
   const std::unordered_map<int, std::string>& stencilIdToArguments_;
 
+  /// Call the instrumented run method of the stencils
+  bool instrumented_ = false;
+
 public:
   using Base = ASTCodeGenCXX;
 
@@ -45,6 +48,10 @@ public:
 
   virtual ~ASTStencilDesc();
 
+  /// @brief Call the instrumented `run` method of the stencils instead of running the gridtools
+  /// computation directly
+  void setInstrumented(bool instrumented) { instrumented_ = instrumented; }
+
   /// @name Statement implementation
   /// @{
   virtual void visit(const std::shared_ptr<BlockStmt>& stmt) override;
@@ -282,6 +282,7 @@ void GTCodeGen::generateStencilWrapperRun(
   ASTStencilDesc stencilDescCGVisitor(stencilInstantiation->getMetaData(), codeGenProperties,
                                       stencilIDToRunArguments);
   stencilDescCGVisitor.setIndent(RunMethod.getIndent());
+  stencilDescCGVisitor.setInstrumented(isInstrumented());
   for(const auto& statement :
       stencilInstantiation->getIIR()->getControlFlowDescriptor().getStatements()) {
     statement->ASTStmt->accept(stencilDescCGVisitor);
@@ -780,6 +781,8 @@ void GTCodeGen::generateStencilClasses(
       StencilConstructor.addInit("m_globals(globals)");
       StencilConstructor.addInit("m_globals_gp_(backend_t::make_global_parameter(m_globals))");
     }
+    if(isInstrumented())
+      StencilConstructor.addInit("m_dom(dom)");
     StencilConstructor.startBody();
 
     // Add static asserts to check halos against extents
@@ -906,6 +909,8 @@ void GTCodeGen::generateStencilClasses(
     StencilClass.addComment("Members");
     stencilType = "computation<void>";
     StencilClass.addMember(stencilType, "m_stencil");
+    if(isInstrumented())
+      StencilClass.addMember("const gridtools::clang::domain&", "m_dom");
 
     if(!globalsMap.empty()) {
 
@@ -917,6 +922,18 @@ void GTCodeGen::generateStencilClasses(
     // Generate stencil getter
     StencilClass.addMemberFunction(stencilType + "*", "get_stencil")
         .addStatement("return &m_stencil");
+
+    // Generate the instrumented run method (the multi-stages are executed by gridtools and can not
+    // be probed individually)
+    if(isInstrumented()) {
+      MemberFunction RunMethod = StencilClass.addMemberFunction("void", "run");
+      RunMethod.startBody();
+      addInstrumentationBegin(RunMethod, "stencil_probe", *stencilInstantiation, stencil, nullptr,
+                              "m_dom");
+      RunMethod.addStatement("m_stencil.run()");
+      addInstrumentationEnd(RunMethod, "stencil_probe");
+      RunMethod.commit();
+    }
   }
 }
 std::unique_ptr<TranslationUnit> GTCodeGen::generateCode() {
@@ -934,7 +951,8 @@ std::unique_ptr<TranslationUnit> GTCodeGen::generateCode() {
   }
 
   // Generate globals
-  std::string globals = generateGlobals(context_->getSIR(), "gridtools");
+  std::string globals =
+      generateInstrumentationHooks() + generateGlobals(context_->getSIR(), "gridtools");
 
   // If we need more than 20 elements in boost::mpl containers, we need to increment to the nearest
   // multiple of ten
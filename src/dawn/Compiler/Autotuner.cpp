@@ -0,0 +1,474 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/Autotuner.h"
+#include "dawn/Compiler/CompilationCache.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/FileUtil.h"
+#include "dawn/Support/Logging.h"
+#include "dawn/Support/STLExtras.h"
+#include "dawn/Support/SmallVector.h"
+#include "dawn/Support/StringRef.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#ifdef DAWN_ON_UNIX
+#include <unistd.h>
+#endif
+
+namespace dawn {
+
+namespace {
+
+/// Options which only influence the performance of the generated code
+const char* const TunableOptions[] = {"reorder",
+                                      "merge-stages",
+                                      "merge-do-methods",
+                                      "merge-temporaries",
+                                      "max-cut-mss",
+                                      "cache-non-temp-fields",
+                                      "disable-kcaches",
+                                      "use-parallel-ep",
+                                      "inline",
+                                      "pass-tmp-to-function",
+                                      "schedule-statements",
+                                      "fuse-horizontal-loops",
+                                      "vectorize",
+                                      "block-size"};
+
+bool isTunable(const std::string& flag) {
+  return std::find(std::begin(TunableOptions), std::end(TunableOptions), flag) !=
+         std::end(TunableOptions);
+}
+
+bool parseValue(const std::string& str, bool& value) {
+  if(str == "true" || str == "1")
+    value = true;
+  else if(str == "false" || str == "0")
+    value = false;
+  else
+    return false;
+  return true;
+}
+
+bool parseValue(const std::string& str, int& value) {
+  return !StringRef(str).getAsInteger(10, value);
+}
+
+bool parseValue(const std::string& str, std::string& value) {
+  value = str;
+  return true;
+}
+
+std::string configurationToString(const std::map<std::string, std::string>& configuration) {
+  std::string str;
+  for(const auto& option : configuration)
+    str += (str.empty() ? "" : " ") + option.first + "=" + option.second;
+  return str;
+}
+
+/// @brief Create a copy of `sir` in which only code for `stencil` is generated
+std::shared_ptr<SIR> makeStencilSIR(const SIR& sir, const std::shared_ptr<sir::Stencil>& stencil) {
+  // The ASTs are shared with `sir`, the other stencils can still be called by `stencil`
+  auto stencilSIR = std::make_shared<SIR>();
+  stencilSIR->Filename = sir.Filename;
+  stencilSIR->StencilFunctions = sir.StencilFunctions;
+  *stencilSIR->GlobalVariableMap = *sir.GlobalVariableMap;
+
+  for(const auto& otherStencil : sir.Stencils) {
+    if(otherStencil == stencil || otherStencil->Attributes.has(sir::Attr::AK_NoCodeGen)) {
+      stencilSIR->Stencils.push_back(otherStencil);
+      continue;
+    }
+    auto noCodeGenStencil = std::make_shared<sir::Stencil>();
+    noCodeGenStencil->Name = otherStencil->Name;
+    noCodeGenStencil->Loc = otherStencil->Loc;
+    noCodeGenStencil->StencilDescAst = otherStencil->StencilDescAst;
+    noCodeGenStencil->Fields = otherStencil->Fields;
+    noCodeGenStencil->Attributes = otherStencil->Attributes;
+    noCodeGenStencil->Attributes.set(sir::Attr::AK_NoCodeGen);
+    stencilSIR->Stencils.push_back(noCodeGenStencil);
+  }
+  return stencilSIR;
+}
+
+/// @brief Compile `SIR` with `options`
+/// @returns the translation unit or `nullptr` if the compiler reported errors, the diagnostics are
+/// forwarded to `diagnostics` (if not `nullptr`)
+std::unique_ptr<codegen::TranslationUnit> compileWithOptions(const std::shared_ptr<SIR>& SIR,
+                                                             Options options,
+                                                             DiagnosticsEngine* diagnostics) {
+  DawnCompiler compiler(&options);
+  auto translationUnit = compiler.compile(SIR);
+  if(diagnostics)
+    for(const auto& diag : compiler.getDiagnostics().getQueue())
+      diagnostics->report(*diag);
+  return compiler.getDiagnostics().hasErrors() ? nullptr : std::move(translationUnit);
+}
+
+/// @brief Disable the options which write files or print reports
+Options withoutSideEffects(Options options) {
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(std::strncmp(#NAME, "Report", 6) == 0 || std::strncmp(#NAME, "Dump", 4) == 0)                 \
+    options.NAME = DEFAULT_VALUE;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+
+  options.SerializeIIR = false;
+  options.PassVerbose = false;
+  options.PerformanceModel = "";
+  options.ProfilePasses = "";
+  return options;
+}
+
+/// @brief Combine the translation units of the individually compiled stencils
+std::unique_ptr<codegen::TranslationUnit>
+mergeTranslationUnits(const std::string& filename,
+                      const std::vector<std::unique_ptr<codegen::TranslationUnit>>& TUs) {
+  std::vector<std::string> ppDefines;
+  std::map<std::string, std::string> stencils;
+  for(const auto& TU : TUs) {
+    for(const std::string& ppDefine : TU->getPPDefines())
+      if(std::find(ppDefines.begin(), ppDefines.end(), ppDefine) == ppDefines.end())
+        ppDefines.push_back(ppDefine);
+    stencils.insert(TU->getStencils().begin(), TU->getStencils().end());
+  }
+
+  // The globals only depend on the global variables, which are the same for all stencils
+  std::string globals = TUs.front()->getGlobals();
+  return make_unique<codegen::TranslationUnit>(filename, std::move(ppDefines), std::move(stencils),
+                                               std::move(globals));
+}
+
+std::string getTemporaryDirectory() {
+  const char* tmpDir = std::getenv("TMPDIR");
+  return tmpDir && *tmpDir ? tmpDir : "/tmp";
+}
+
+} // anonymous namespace
+
+Autotuner::Autotuner(const Options& options, DiagnosticsEngine& diagnostics)
+    : options_(options), diagnostics_(diagnostics) {}
+
+bool Autotuner::setOption(Options& options, const std::string& flag, const std::string& value) {
+  if(!isTunable(flag))
+    return false;
+
+  if(flag == "reorder" && value != "none" && value != "greedy" && value != "scut")
+    return false;
+
+  if(flag == "block-size") {
+    SmallVector<StringRef, 3> sizes;
+    StringRef(value).split(sizes, ',', -1, false);
+    int size = 0;
+    if(sizes.size() != 3 || std::any_of(sizes.begin(), sizes.end(), [&](StringRef sizeStr) {
+         return sizeStr.getAsInteger(10, size) || size <= 0;
+       }))
+      return false;
+  }
+
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(flag == OPTION)                                                                               \
+    return parseValue(value, options.NAME);
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+
+  return false;
+}
+
+bool Autotuner::parseSearchSpace(const std::string& spec, SearchSpace& space,
+                                 std::string& error) {
+  space.clear();
+
+  SmallVector<StringRef, 8> parameters;
+  StringRef(spec).split(parameters, ';', -1, false);
+  for(StringRef parameter : parameters) {
+    std::pair<StringRef, StringRef> flagAndValues = parameter.split('=');
+    std::string flag = flagAndValues.first.trim().str();
+    if(!isTunable(flag)) {
+      error = "option '" + flag + "' cannot be tuned";
+      return false;
+    }
+
+    SmallVector<StringRef, 8> values;
+    flagAndValues.second.split(values, '|', -1, false);
+    if(values.empty()) {
+      error = "no values given for '" + flag + "'";
+      return false;
+    }
+
+    std::vector<std::string> candidates;
+    Options options;
+    for(StringRef value : values) {
+      std::string valueStr = value.trim().str();
+      if(!setOption(options, flag, valueStr)) {
+        error = "invalid value '" + valueStr + "' for '" + flag + "'";
+        return false;
+      }
+      candidates.push_back(valueStr);
+    }
+    space.emplace_back(flag, std::move(candidates));
+  }
+  return true;
+}
+
+std::string Autotuner::computeKey(const SIR& stencilSIR, const Options& options) {
+  // The tuned options (and the options of the autotuner) are not part of the key
+  Options keyOptions = options;
+  const Options defaultOptions;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(isTunable(OPTION))                                                                            \
+    keyOptions.NAME = defaultOptions.NAME;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  keyOptions.Autotune = defaultOptions.Autotune;
+  keyOptions.TuningSpace = defaultOptions.TuningSpace;
+  keyOptions.TuningDB = defaultOptions.TuningDB;
+
+  // The key is computed from the textual representation of the SIR which, contrary to its
+  // serialization, contains neither the IDs of the AST nodes nor the (unordered) global variables
+  std::ostringstream ss;
+  for(const auto& stencil : stencilSIR.Stencils) {
+    ss << "stencil:" << stencil->Name << ":" << stencil->Attributes.has(sir::Attr::AK_NoCodeGen);
+    for(const auto& field : stencil->Fields)
+      ss << ":" << field->Name << "=" << field->IsTemporary;
+    ss << "\n";
+  }
+
+  std::map<std::string, std::shared_ptr<sir::Value>> globals(
+      stencilSIR.GlobalVariableMap->begin(), stencilSIR.GlobalVariableMap->end());
+  for(const auto& globalPair : globals)
+    ss << "global:" << globalPair.first << ":"
+       << sir::Value::typeToString(globalPair.second->getType()) << ":"
+       << globalPair.second->isConstexpr() << ":" << globalPair.second->toString() << "\n";
+
+  SIR keySIR;
+  keySIR.Stencils = stencilSIR.Stencils;
+  keySIR.StencilFunctions = stencilSIR.StencilFunctions;
+  ss << keySIR;
+  return CompilationCache::computeKey(ss.str(), keyOptions);
+}
+
+std::unique_ptr<codegen::TranslationUnit>
+Autotuner::compile(const std::shared_ptr<SIR>& SIR) {
+  SearchSpace space;
+  if(!options_.Autotune.empty()) {
+#ifndef DAWN_ON_UNIX
+    DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+    diag << "option '-autotune' is only supported on UNIX platforms";
+    diagnostics_.report(diag);
+    return nullptr;
+#endif
+    std::string error;
+    if(!parseSearchSpace(options_.TuningSpace, space, error)) {
+      DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+      diag << "invalid value '" << options_.TuningSpace << "' of option '-tuning-space', " << error;
+      diagnostics_.report(diag);
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<TuningDatabase> database;
+  if(!options_.TuningDB.empty()) {
+    database = make_unique<TuningDatabase>(options_.TuningDB);
+    if(!database->load()) {
+      DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+      diag << "cannot read tuning database: " << options_.TuningDB;
+      diagnostics_.report(diag);
+      return nullptr;
+    }
+  }
+
+  Options untunedOptions = options_;
+  untunedOptions.Autotune = "";
+  untunedOptions.TuningDB = "";
+
+  std::vector<std::unique_ptr<codegen::TranslationUnit>> translationUnits;
+  for(const auto& stencil : SIR->Stencils) {
+    if(stencil->Attributes.has(sir::Attr::AK_NoCodeGen))
+      continue;
+
+    std::shared_ptr<dawn::SIR> stencilSIR = makeStencilSIR(*SIR, stencil);
+    const std::string key = computeKey(*stencilSIR, options_);
+
+    std::unique_ptr<codegen::TranslationUnit> translationUnit;
+    if(!options_.Autotune.empty()) {
+      TuningEntry entry;
+      translationUnit = tune(stencilSIR, stencil->Name, space, entry);
+      if(!translationUnit) {
+        DiagnosticsBuilder diag(DiagnosticsKind::Error, stencil->Loc);
+        diag << "autotuning of stencil '" << stencil->Name
+             << "' failed: no configuration could be compiled and benchmarked";
+        diagnostics_.report(diag);
+        return nullptr;
+      }
+      if(database)
+        database->insert(key, std::move(entry));
+
+    } else {
+      Options stencilOptions = untunedOptions;
+      if(const TuningEntry* entry = database->lookup(key)) {
+        bool isValid = true;
+        for(const auto& option : entry->Options)
+          isValid &= setOption(stencilOptions, option.first, option.second);
+
+        if(isValid) {
+          DAWN_LOG(INFO) << "using tuned configuration of `" << stencil->Name
+                         << "`: " << configurationToString(entry->Options);
+        } else {
+          DiagnosticsBuilder diag(DiagnosticsKind::Warning, stencil->Loc);
+          diag << "ignoring invalid configuration of stencil '" << stencil->Name
+               << "' in tuning database: " << configurationToString(entry->Options);
+          diagnostics_.report(diag);
+          stencilOptions = untunedOptions;
+        }
+      }
+
+      translationUnit = compileWithOptions(stencilSIR, stencilOptions, &diagnostics_);
+      if(!translationUnit)
+        return nullptr;
+    }
+    translationUnits.push_back(std::move(translationUnit));
+  }
+
+  if(database && !options_.Autotune.empty() && !database->save()) {
+    DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+    diag << "file system error: cannot write tuning database: " << options_.TuningDB;
+    diagnostics_.report(diag);
+    return nullptr;
+  }
+
+  // Without stencils there is nothing to tune
+  if(translationUnits.empty())
+    return compileWithOptions(SIR, untunedOptions, &diagnostics_);
+
+  return mergeTranslationUnits(SIR->Filename, translationUnits);
+}
+
+std::unique_ptr<codegen::TranslationUnit>
+Autotuner::tune(const std::shared_ptr<SIR>& stencilSIR, const std::string& stencilName,
+                const SearchSpace& space, TuningEntry& entry) {
+  Options untunedOptions = options_;
+  untunedOptions.Autotune = "";
+  untunedOptions.TuningDB = "";
+
+  entry.Stencil = stencilName;
+  entry.Backend = options_.Backend;
+
+  // The benchmarked configurations neither write files nor print reports, this is left to the
+  // final compilation of the fastest configuration
+  const Options benchmarkOptions = withoutSideEffects(untunedOptions);
+  bool hasBenchmarkedConfiguration = false;
+
+  // Enumerate all combinations of the candidate values
+  std::vector<std::size_t> indices(space.size(), 0);
+  while(true) {
+    Options configurationOptions = benchmarkOptions;
+    std::map<std::string, std::string> configuration;
+    for(std::size_t i = 0; i < space.size(); ++i) {
+      const std::string& value = space[i].second[indices[i]];
+      configuration[space[i].first] = value;
+      setOption(configurationOptions, space[i].first, value);
+    }
+
+    double runtime = 0;
+    auto translationUnit = compileWithOptions(stencilSIR, configurationOptions, nullptr);
+    if(!translationUnit) {
+      DAWN_LOG(INFO) << "autotuning `" << stencilName
+                     << "`: " << configurationToString(configuration) << ": compilation failed";
+    } else if(benchmark(*translationUnit, stencilName, runtime)) {
+      DAWN_LOG(INFO) << "autotuning `" << stencilName
+                     << "`: " << configurationToString(configuration) << ": " << runtime;
+      if(!hasBenchmarkedConfiguration || runtime < entry.Runtime) {
+        hasBenchmarkedConfiguration = true;
+        entry.Options = configuration;
+        entry.Runtime = runtime;
+      }
+    }
+
+    std::size_t i = 0;
+    for(; i < indices.size(); ++i) {
+      if(++indices[i] < space[i].second.size())
+        break;
+      indices[i] = 0;
+    }
+    if(i == indices.size())
+      break;
+  }
+
+  if(!hasBenchmarkedConfiguration)
+    return nullptr;
+
+  Options tunedOptions = untunedOptions;
+  for(const auto& option : entry.Options)
+    setOption(tunedOptions, option.first, option.second);
+  return compileWithOptions(stencilSIR, tunedOptions, &diagnostics_);
+}
+
+bool Autotuner::benchmark(const codegen::TranslationUnit& translationUnit,
+                          const std::string& stencilName, double& runtime) {
+#ifdef DAWN_ON_UNIX
+  static std::atomic<int> numBenchmarks(0);
+  const std::string file = getTemporaryDirectory() + "/dawn_autotune_" + stencilName + "_" +
+                           std::to_string(::getpid()) + "_" + std::to_string(numBenchmarks++) +
+                           (options_.Backend == "cuda" ? ".cu" : ".cpp");
+
+  std::string code;
+  for(const std::string& ppDefine : translationUnit.getPPDefines())
+    code += ppDefine + "\n";
+  code += translationUnit.getGlobals() + "\n" + translationUnit.getStencils().at(stencilName);
+  if(!writeFileAtomically(file, code)) {
+    DAWN_LOG(WARNING) << "autotuning `" << stencilName << "`: cannot write file: " << file;
+    return false;
+  }
+
+  std::string output;
+  int status = -1;
+  if(FILE* pipe = ::popen((options_.Autotune + " '" + file + "'").c_str(), "r")) {
+    char buffer[256];
+    while(std::fgets(buffer, sizeof(buffer), pipe))
+      output += buffer;
+    status = ::pclose(pipe);
+  }
+  std::remove(file.c_str());
+
+  if(status != 0) {
+    DAWN_LOG(INFO) << "autotuning `" << stencilName << "`: benchmark harness failed with status "
+                   << status;
+    return false;
+  }
+
+  // The runtime is printed on the last line
+  StringRef lines = StringRef(output).rtrim();
+  std::string lastLine = lines.substr(lines.rfind('\n') + 1).trim().str();
+  char* end = nullptr;
+  runtime = std::strtod(lastLine.c_str(), &end);
+  if(lastLine.empty() || *end != '\0' || !(runtime >= 0)) {
+    DAWN_LOG(INFO) << "autotuning `" << stencilName << "`: invalid runtime '" << lastLine
+                   << "' reported by the benchmark harness";
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace dawn
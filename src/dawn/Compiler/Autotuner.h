@@ -0,0 +1,94 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_AUTOTUNER_H
+#define DAWN_COMPILER_AUTOTUNER_H
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DiagnosticsEngine.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Compiler/TuningDatabase.h"
+#include "dawn/Support/NonCopyable.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+struct SIR;
+
+/// @brief Empirical tuning of the options and block sizes of the stencils
+///
+/// Every stencil of the SIR is compiled on its own (the other stencils are marked as
+/// `no_codegen`), which allows each stencil to use its own configuration. With `-autotune`, every
+/// configuration of the search space (`-tuning-space`) is compiled and the generated code is
+/// written to a temporary file, which is passed to the benchmark harness command. The harness is
+/// expected to build and run the code and to print the measured runtime on the last line of its
+/// output, a failing harness discards the configuration. The fastest configuration is used for the
+/// generated code and recorded in the tuning database (`-tuning-db`). Without `-autotune`, the
+/// configurations are only looked up in the tuning database. The benchmarked compilations do not
+/// write files or print reports (e.g `-performance-model`), the stencil is compiled once more with
+/// the fastest configuration to produce them.
+///
+/// Only options which do not change the semantics of the generated code can be tuned. The key of a
+/// stencil in the database is a hash of its SIR and of all the other options, a tuned
+/// configuration is hence only reused for the same stencil compiled for the same backend.
+///
+/// @ingroup compiler
+class Autotuner : NonCopyable {
+  const Options& options_;
+  DiagnosticsEngine& diagnostics_;
+
+public:
+  /// @brief Candidate values of each tuned option (by the flag of the option)
+  using SearchSpace = std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+  Autotuner(const Options& options, DiagnosticsEngine& diagnostics);
+
+  /// @brief Compile the SIR using the tuned configuration of each stencil (the stencils are tuned
+  /// first if `-autotune` is given)
+  /// @returns compiled TranslationUnit on success, `nullptr` otherwise
+  std::unique_ptr<codegen::TranslationUnit> compile(const std::shared_ptr<SIR>& SIR);
+
+  /// @brief Parse the search space `spec` (e.g `reorder=greedy|scut;block-size=32,1,4|32,4,4`)
+  /// @returns `false` and sets `error` if `spec` is malformed or contains an option which cannot be
+  /// tuned
+  static bool parseSearchSpace(const std::string& spec, SearchSpace& space, std::string& error);
+
+  /// @brief Set the tunable option of `flag` (e.g `merge-stages`) to `value`
+  /// @returns `false` if the option cannot be tuned or `value` is invalid
+  static bool setOption(Options& options, const std::string& flag, const std::string& value);
+
+  /// @brief Compute the key of `stencilSIR` (a SIR which generates code for a single stencil) in
+  /// the tuning database
+  static std::string computeKey(const SIR& stencilSIR, const Options& options);
+
+private:
+  /// @brief Benchmark all configurations of `space` for the single stencil of `stencilSIR`
+  /// @returns the translation unit of the fastest configuration or `nullptr` if no configuration
+  /// could be benchmarked
+  std::unique_ptr<codegen::TranslationUnit> tune(const std::shared_ptr<SIR>& stencilSIR,
+                                                 const std::string& stencilName,
+                                                 const SearchSpace& space, TuningEntry& entry);
+
+  /// @brief Run the benchmark harness on the code of `stencilName` in `translationUnit`
+  /// @returns `false` if the harness failed
+  bool benchmark(const codegen::TranslationUnit& translationUnit, const std::string& stencilName,
+                 double& runtime);
+};
+
+} // namespace dawn
+
+#endif
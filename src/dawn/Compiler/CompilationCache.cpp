@@ -0,0 +1,204 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#include "dawn/Compiler/CompilationCache.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/FileUtil.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/Logging.h"
+#include "dawn/Support/STLExtras.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Incremental 128-bit hash (two 64-bit FNV-1a hashes with different offset bases)
+///
+/// `std::hash` is not guaranteed to be stable across runs or standard libraries and can thus not be
+/// used for on-disk keys.
+class Hasher {
+  std::uint64_t h0_ = 0xcbf29ce484222325ULL;
+  std::uint64_t h1_ = 0x84222325cbf29ce4ULL;
+
+public:
+  void update(const char* data, std::size_t size) {
+    for(std::size_t i = 0; i < size; ++i) {
+      const std::uint64_t c = static_cast<unsigned char>(data[i]);
+      h0_ = (h0_ ^ c) * 0x100000001b3ULL;
+      h1_ = (h1_ ^ c) * 0x100000001b3ULL;
+      h1_ ^= h1_ >> 29;
+    }
+  }
+
+  std::string getDigest() const {
+    char digest[33];
+    std::snprintf(digest, sizeof(digest), "%016llx%016llx", static_cast<unsigned long long>(h0_),
+                  static_cast<unsigned long long>(h1_));
+    return digest;
+  }
+};
+
+/// @brief Hexadecimal representation of the (binary) `data` which can be stored in JSON strings
+std::string toHex(const std::string& data) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2 * data.size());
+  for(char c : data) {
+    hex.push_back(digits[static_cast<unsigned char>(c) >> 4]);
+    hex.push_back(digits[static_cast<unsigned char>(c) & 0xf]);
+  }
+  return hex;
+}
+
+template <class T>
+std::string toString(const T& value) {
+  std::ostringstream ss;
+  ss << value;
+  return ss.str();
+}
+
+} // anonymous namespace
+
+CompilationCache::CompilationCache(std::string directory) : directory_(std::move(directory)) {}
+
+bool CompilationCache::isCacheable(const Options& options) {
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if((std::strncmp(#NAME, "Report", 6) == 0 || std::strncmp(#NAME, "Dump", 4) == 0) &&             \
+     !(options.NAME == DEFAULT_VALUE))                                                             \
+    return false;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+
+  return !options.SerializeIIR && !options.PassVerbose && options.PerformanceModel.empty() &&
+         options.ProfilePasses.empty() && options.Autotune.empty() && options.TuningDB.empty();
+}
+
+std::string CompilationCache::computeInputs(const std::string& SIR, const Options& options) {
+  // Every part is prefixed with its length to avoid ambiguities between the concatenations
+  std::string inputs;
+  auto append = [&](const std::string& str) {
+    inputs += std::to_string(str.size()) + ":";
+    inputs += str;
+  };
+  append(DAWN_FULL_VERSION_STR);
+
+  // Neither the location of the cache nor the number of jobs influence the generated code
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(std::strcmp(#NAME, "CacheDir") != 0 && std::strcmp(#NAME, "Jobs") != 0) {                  \
+    append(#NAME);                                                                                 \
+    append(toString(options.NAME));                                                                \
+  }
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+
+  append(SIR);
+  return inputs;
+}
+
+std::string CompilationCache::computeKey(const std::string& SIR, const Options& options) {
+  const std::string inputs = computeInputs(SIR, options);
+  Hasher hasher;
+  hasher.update(inputs.data(), inputs.size());
+  return hasher.getDigest();
+}
+
+std::string CompilationCache::getEntryPath(const std::string& key) const {
+  return directory_ + "/" + key + ".json";
+}
+
+std::unique_ptr<codegen::TranslationUnit>
+CompilationCache::lookup(const std::string& SIR, const Options& options,
+                         DiagnosticsQueue& diagnostics) const {
+  const std::string key = computeKey(SIR, options);
+  std::ifstream ifs(getEntryPath(key));
+  if(!ifs.is_open())
+    return nullptr;
+
+  try {
+    json::json node;
+    ifs >> node;
+
+    // The key is only a hash, a hit is confirmed by the inputs of the entry
+    if(node.at("key").get<std::string>() != key ||
+       node.at("inputs").get<std::string>() != toHex(computeInputs(SIR, options))) {
+      DAWN_LOG(WARNING) << "ignoring cache entry '" << getEntryPath(key)
+                        << "' of different inputs";
+      return nullptr;
+    }
+
+    std::vector<std::string> ppDefines = node.at("ppDefines").get<std::vector<std::string>>();
+    std::map<std::string, std::string> stencils;
+    for(auto it = node.at("stencils").begin(); it != node.at("stencils").end(); ++it)
+      stencils.emplace(it.key(), it.value().get<std::string>());
+
+    // Diagnostics are only replayed once the whole entry has been read
+    std::vector<DiagnosticsMessage> messages;
+    for(const json::json& diag : node.at("diagnostics")) {
+      SourceLocation loc(diag.at("line").get<int>(), diag.at("column").get<int>());
+      messages.emplace_back(static_cast<DiagnosticsKind>(diag.at("kind").get<int>()), loc,
+                            diag.at("filename").get<std::string>(),
+                            diag.at("message").get<std::string>());
+    }
+
+    auto translationUnit = make_unique<codegen::TranslationUnit>(
+        node.at("filename").get<std::string>(), std::move(ppDefines), std::move(stencils),
+        node.at("globals").get<std::string>());
+    for(auto& message : messages)
+      diagnostics.push_back(std::move(message));
+    return translationUnit;
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << "ignoring corrupted cache entry '" << getEntryPath(key)
+                      << "': " << e.what();
+    return nullptr;
+  }
+}
+
+bool CompilationCache::insert(const std::string& SIR, const Options& options,
+                              const codegen::TranslationUnit& translationUnit,
+                              const DiagnosticsQueue& diagnostics) const {
+  if(!createDirectories(directory_))
+    return false;
+
+  const std::string key = computeKey(SIR, options);
+  json::json node;
+  node["key"] = key;
+  node["inputs"] = toHex(computeInputs(SIR, options));
+  node["version"] = DAWN_FULL_VERSION_STR;
+  node["filename"] = translationUnit.getFilename();
+  node["ppDefines"] = translationUnit.getPPDefines();
+  node["globals"] = translationUnit.getGlobals();
+  node["stencils"] = json::json::object();
+  for(const auto& stencil : translationUnit.getStencils())
+    node["stencils"][stencil.first] = stencil.second;
+  node["diagnostics"] = json::json::array();
+  for(const auto& diag : diagnostics) {
+    json::json diagNode;
+    diagNode["kind"] = static_cast<int>(diag->getDiagKind());
+    diagNode["line"] = diag->getSourceLocation().Line;
+    diagNode["column"] = diag->getSourceLocation().Column;
+    diagNode["filename"] = diag->getFilename();
+    diagNode["message"] = diag->getMessage();
+    node["diagnostics"].push_back(diagNode);
+  }
+
+  return writeFileAtomically(getEntryPath(key), node.dump(2));
+}
+
+} // namespace dawn
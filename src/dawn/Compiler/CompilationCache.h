@@ -0,0 +1,89 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#ifndef DAWN_COMPILER_COMPILATIONCACHE_H
+#define DAWN_COMPILER_COMPILATIONCACHE_H
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DiagnosticsQueue.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Support/NonCopyable.h"
+#include <memory>
+#include <string>
+
+namespace dawn {
+
+/// @brief Persistent, content-addressed cache of compiled translation units
+///
+/// Each entry is stored as a JSON file in the cache directory. The inputs of a compilation are the
+/// serialized SIR, the options of `Options.inc` (except `CacheDir` and `Jobs` which do not
+/// influence the generated code) and the dawn version. The name of an entry is a hash of the inputs
+/// and the entry stores the inputs themselves, which are compared on lookup to rule out hash
+/// collisions. A cache hit skips the deserialization of the SIR, the optimizer and the code
+/// generation entirely. The diagnostics of the compilation
+/// are stored with the entry and replayed on a hit. Options which produce side-effects (e.g dumping
+/// graphs, writing reports or serializing the IIR) cannot be replayed, compilations using them are
+/// not cached (see `isCacheable`).
+///
+/// @ingroup compiler
+class CompilationCache : NonCopyable {
+  std::string directory_;
+
+public:
+  /// @brief Open the cache located in `directory` (the directory is created on the first insert)
+  explicit CompilationCache(std::string directory);
+
+  /// @brief Check if compilations with `options` can be cached
+  ///
+  /// Compilations writing files or reports (e.g `-write-iir`, `-profile-passes` or any
+  /// `-report-*` and `-dump-*` option) have to run the compiler, as do tuned compilations whose
+  /// code depends on the benchmarks (resp. on the content of the tuning database).
+  static bool isCacheable(const Options& options);
+
+  /// @brief Compute the inputs of the compilation of `SIR` (serialized) with `options`
+  static std::string computeInputs(const std::string& SIR, const Options& options);
+
+  /// @brief Compute the key of the compilation of `SIR` (serialized) with `options`, i.e the hash
+  /// of its inputs
+  static std::string computeKey(const std::string& SIR, const Options& options);
+
+  /// @brief Get the translation unit of the compilation of `SIR` with `options` and append the
+  /// diagnostics of its compilation to `diagnostics`
+  /// @returns the cached translation unit or `nullptr` if the compilation is not in the cache (or
+  /// if the entry is unreadable or was stored for different inputs)
+  std::unique_ptr<codegen::TranslationUnit>
+  lookup(const std::string& SIR, const Options& options, DiagnosticsQueue& diagnostics) const;
+
+  /// @brief Store `translationUnit` and the `diagnostics` of the compilation of `SIR` with
+  /// `options`
+  ///
+  /// The entry is written to a temporary file and atomically renamed, making it safe to share the
+  /// cache between concurrent compilations.
+  ///
+  /// @returns `true` on success
+  bool insert(const std::string& SIR, const Options& options,
+              const codegen::TranslationUnit& translationUnit,
+              const DiagnosticsQueue& diagnostics) const;
+
+  /// @brief Get the file of the cache entry of `key`
+  std::string getEntryPath(const std::string& key) const;
+
+  /// @brief Get the cache directory
+  const std::string& getDirectory() const { return directory_; }
+};
+
+} // namespace dawn
+
+#endif
@@ -13,13 +13,20 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Autotuner.h"
 #include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+#include "dawn/CodeGen/CXXOpt/CXXOptCodeGen.h"
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/Cuda/CudaCodeGen.h"
 #include "dawn/CodeGen/GridTools/GTCodeGen.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassCommonSubexpressionElimination.h"
 #include "dawn/Optimizer/PassComputeStageExtents.h"
+#include "dawn/Optimizer/PassConstantFolding.h"
 #include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/Optimizer/PassDeadStoreElimination.h"
 #include "dawn/Optimizer/PassFieldVersioning.h"
 #include "dawn/Optimizer/PassInlining.h"
 #include "dawn/Optimizer/PassMultiStageSplitter.h"
@@ -35,18 +42,28 @@
 #include "dawn/Optimizer/PassStageMerger.h"
 #include "dawn/Optimizer/PassStageReordering.h"
 #include "dawn/Optimizer/PassStageSplitter.h"
+#include "dawn/Optimizer/PassStatementScheduling.h"
 #include "dawn/Optimizer/PassStencilSplitter.h"
 #include "dawn/Optimizer/PassTemporaryFirstAccess.h"
 #include "dawn/Optimizer/PassTemporaryMerger.h"
 #include "dawn/Optimizer/PassTemporaryToStencilFunction.h"
 #include "dawn/Optimizer/PassTemporaryType.h"
+#include "dawn/Optimizer/PerformanceModel.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/Serialization/IIRSerializer.h"
 #include "dawn/Support/EditDistance.h"
 #include "dawn/Support/Logging.h"
+#include "dawn/Support/SmallVector.h"
+#include "dawn/Support/StringRef.h"
 #include "dawn/Support/StringSwitch.h"
 #include "dawn/Support/StringUtil.h"
+#include "dawn/Support/UIDGenerator.h"
 #include "dawn/Support/Unreachable.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <thread>
 
 namespace dawn {
 
@@ -115,6 +132,189 @@ static std::string remove_fileextension(std::string fullName, std::string extens
   return truncation;
 }
 
+/// @brief Number of statements and accesses of `statementAccessesPair` (including its block
+/// statements)
+static int computeIIRSize(const iir::StatementAccessesPair& statementAccessesPair) {
+  int size = 1;
+  if(const auto& accesses = statementAccessesPair.getAccesses())
+    size += accesses->getReadAccesses().size() + accesses->getWriteAccesses().size();
+  for(const auto& child : statementAccessesPair.getBlockStatements())
+    size += computeIIRSize(*child);
+  return size;
+}
+
+/// @brief Number of statements and accesses of `instantiation` (including its stencil functions)
+static int computeIIRSize(const iir::StencilInstantiation& instantiation) {
+  int size = 0;
+  for(const auto& statementAccessesPair :
+      iterateIIROver<iir::StatementAccessesPair>(*instantiation.getIIR()))
+    size += computeIIRSize(*statementAccessesPair);
+  for(const auto& stencilFun : instantiation.getMetaData().getStencilFunctionInstantiations())
+    for(const auto& statementAccessesPair : stencilFun->getStatementAccessesPairs())
+      size += computeIIRSize(*statementAccessesPair);
+  return size;
+}
+
+/// @brief Create a copy of `sir` in which the global variables of `specialization` (a comma
+/// separated list of `name=value` pairs) are compile-time constants
+/// @returns `NULL` if the specialization is invalid
+static std::shared_ptr<SIR> specializeGlobals(const std::shared_ptr<SIR>& sir,
+                                              const std::string& specialization,
+                                              DiagnosticsEngine& diagnostics) {
+  // The stencils are shared with `sir`, only the values of the globals are replaced
+  auto specializedSIR = std::make_shared<SIR>();
+  specializedSIR->Filename = sir->Filename;
+  specializedSIR->Stencils = sir->Stencils;
+  specializedSIR->StencilFunctions = sir->StencilFunctions;
+  *specializedSIR->GlobalVariableMap = *sir->GlobalVariableMap;
+
+  SmallVector<StringRef, 8> assignments;
+  StringRef(specialization).split(assignments, ',', -1, false);
+  for(StringRef assignment : assignments) {
+    std::pair<StringRef, StringRef> nameAndValue = assignment.split('=');
+    std::string name = nameAndValue.first.trim().str();
+    StringRef valueStr = nameAndValue.second.trim();
+
+    auto it = specializedSIR->GlobalVariableMap->find(name);
+    if(it == specializedSIR->GlobalVariableMap->end()) {
+      diagnostics.report(buildDiag("-specialize-globals", assignment.str(),
+                                   "no global variable named '" + name + "'"));
+      return nullptr;
+    }
+
+    auto value = std::make_shared<sir::Value>();
+    bool isValid = false;
+    switch(it->second->getType()) {
+    case sir::Value::Boolean:
+      isValid = (valueStr == "true" || valueStr == "false");
+      value->setValue(valueStr == "true");
+      break;
+    case sir::Value::Integer: {
+      int integer = 0;
+      isValid = !valueStr.getAsInteger(10, integer);
+      value->setValue(integer);
+      break;
+    }
+    case sir::Value::Double: {
+      std::string doubleStr = valueStr.str();
+      char* end = nullptr;
+      double floatingPoint = std::strtod(doubleStr.c_str(), &end);
+      isValid = !doubleStr.empty() && *end == '\0';
+      value->setValue(floatingPoint);
+      break;
+    }
+    default:
+      break;
+    }
+
+    if(!isValid) {
+      diagnostics.report(buildDiag(
+          "-specialize-globals", assignment.str(),
+          std::string("expected a value of type '") +
+              sir::Value::typeToString(it->second->getType()) + "' for '" + name + "'"));
+      return nullptr;
+    }
+
+    value->setIsConstexpr(true);
+    it->second = value;
+  }
+  return specializedSIR;
+}
+
+/// @brief Parse the machine description of `-machine` into `machine`
+static bool parseMachine(const std::string& description, HardwareConfig& machine,
+                         DiagnosticsEngine& diagnostics) {
+  SmallVector<StringRef, 8> assignments;
+  StringRef(description).split(assignments, ',', -1, false);
+  for(StringRef assignment : assignments) {
+    std::pair<StringRef, StringRef> nameAndValue = assignment.split('=');
+    std::string name = nameAndValue.first.trim().str();
+    std::string valueStr = nameAndValue.second.trim().str();
+
+    char* end = nullptr;
+    double value = std::strtod(valueStr.c_str(), &end);
+    if(valueStr.empty() || *end != '\0' || value <= 0) {
+      diagnostics.report(buildDiag("-machine", assignment.str(),
+                                   "expected a positive number for '" + name + "'"));
+      return false;
+    }
+
+    if(name == "bandwidth")
+      machine.Bandwidth = value;
+    else if(name == "peak-flops")
+      machine.PeakFlops = value;
+    else if(name == "cache-size")
+      machine.CacheSize = static_cast<int>(value);
+    else if(name == "smem-fields")
+      machine.SMemMaxFields = static_cast<int>(value);
+    else if(name == "tex-cache-fields")
+      machine.TexCacheMaxFields = static_cast<int>(value);
+    else {
+      diagnostics.report(buildDiag("-machine", name, "",
+                                   std::vector<std::string>{"bandwidth", "peak-flops", "cache-size",
+                                                            "smem-fields", "tex-cache-fields"}));
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Parse the domain size of `-performance-model-domain` into `domain`
+static bool parseDomain(const std::string& domainStr, Array3i& domain,
+                        DiagnosticsEngine& diagnostics) {
+  SmallVector<StringRef, 3> sizes;
+  StringRef(domainStr).split(sizes, ',', -1, false);
+
+  bool isValid = sizes.size() == 3;
+  for(int i = 0; isValid && i < 3; ++i)
+    isValid = !sizes[i].trim().getAsInteger(10, domain[i]) && domain[i] > 0;
+
+  if(!isValid)
+    diagnostics.report(buildDiag("-performance-model-domain", domainStr,
+                                 "expected three positive integers"));
+  return isValid;
+}
+
+/// @brief Register the optimizer passes in `passManager` in the order they are run
+static void registerPasses(OptimizerContext& optimizer, PassManager& passManager,
+                           ReorderStrategy::ReorderStrategyKind reorderStrategy,
+                           PassMultiStageSplitter::MultiStageSplittingStrategy mssSplitStrategy,
+                           int maxFields) {
+  const Options& options = optimizer.getOptions();
+
+  optimizer.checkAndPushBackTo<PassInlining>(passManager, true, PassInlining::IK_InlineProcedures);
+  optimizer.checkAndPushBackTo<PassConstantFolding>(passManager);
+  // This pass is currently broken and needs to be redesigned before it can be enabled
+  //  optimizer.checkAndPushBackTo<PassTemporaryFirstAccss>(passManager);
+  optimizer.checkAndPushBackTo<PassFieldVersioning>(passManager);
+  optimizer.checkAndPushBackTo<PassSSA>(passManager);
+  optimizer.checkAndPushBackTo<PassMultiStageSplitter>(passManager, mssSplitStrategy);
+  optimizer.checkAndPushBackTo<PassStageSplitter>(passManager);
+  optimizer.checkAndPushBackTo<PassPrintStencilGraph>(passManager);
+  optimizer.checkAndPushBackTo<PassTemporaryType>(passManager);
+  optimizer.checkAndPushBackTo<PassSetStageName>(passManager);
+  optimizer.checkAndPushBackTo<PassSetStageGraph>(passManager);
+  optimizer.checkAndPushBackTo<PassStageReordering>(passManager, reorderStrategy);
+  optimizer.checkAndPushBackTo<PassStageMerger>(passManager);
+  optimizer.checkAndPushBackTo<PassStencilSplitter>(passManager, maxFields);
+  optimizer.checkAndPushBackTo<PassTemporaryType>(passManager);
+  optimizer.checkAndPushBackTo<PassTemporaryMerger>(passManager);
+  optimizer.checkAndPushBackTo<PassInlining>(passManager,
+                                             (options.InlineSF || options.PassTmpToFunction),
+                                             PassInlining::IK_ComputationsOnTheFly);
+  optimizer.checkAndPushBackTo<PassTemporaryToStencilFunction>(passManager);
+  optimizer.checkAndPushBackTo<PassDeadStoreElimination>(passManager);
+  optimizer.checkAndPushBackTo<PassCommonSubexpressionElimination>(passManager);
+  optimizer.checkAndPushBackTo<PassStatementScheduling>(passManager);
+  optimizer.checkAndPushBackTo<PassSetNonTempCaches>(passManager);
+  optimizer.checkAndPushBackTo<PassSetCaches>(passManager);
+  optimizer.checkAndPushBackTo<PassComputeStageExtents>(passManager);
+  optimizer.checkAndPushBackTo<PassSetBoundaryCondition>(passManager);
+  optimizer.checkAndPushBackTo<PassSetBlockSize>(passManager);
+  optimizer.checkAndPushBackTo<PassDataLocalityMetric>(passManager);
+  optimizer.checkAndPushBackTo<PassSetSyncStage>(passManager);
+}
+
 DawnCompiler::DawnCompiler(Options* options) : diagnostics_(make_unique<DiagnosticsEngine>()) {
   options_ = options ? make_unique<Options>(*options) : make_unique<Options>();
 }
@@ -145,73 +345,190 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
   // -max-fields
   int maxFields = options_->MaxFieldsPerStencil;
 
+  // -profile-passes-format
+  if(options_->ProfilePassesFormat != "json" && options_->ProfilePassesFormat != "trace") {
+    diagnostics_->report(buildDiag("-profile-passes-format", options_->ProfilePassesFormat, "",
+                                   {"json", "trace"}));
+    return nullptr;
+  }
+
+  // -machine
+  HardwareConfig machine;
+  if(!parseMachine(options_->Machine, machine, *diagnostics_))
+    return nullptr;
+
+  // -performance-model-domain
+  Array3i domain;
+  if(!parseDomain(options_->PerformanceModelDomain, domain, *diagnostics_))
+    return nullptr;
+
   IIRSerializer::SerializationKind serializationKind = IIRSerializer::SK_Json;
   if(options_->SerializeIIR) { /*|| (options_->LoadSerialized != "")) {*/
     if(options_->IIRFormat == "json") {
       serializationKind = IIRSerializer::SK_Json;
     } else if(options_->IIRFormat == "byte") {
       serializationKind = IIRSerializer::SK_Byte;
-
+    } else if(options_->IIRFormat == "mapped") {
+      serializationKind = IIRSerializer::SK_MappedByte;
     } else {
       dawn_unreachable("Unknown SIRFormat option");
     }
   }
 
+  // -specialize-globals
+  std::shared_ptr<dawn::SIR> specializedSIR = SIR;
+  if(!options_->SpecializeGlobals.empty()) {
+    specializedSIR = specializeGlobals(SIR, options_->SpecializeGlobals, *diagnostics_);
+    if(!specializedSIR)
+      return nullptr;
+  }
+
   // Initialize optimizer
   std::unique_ptr<OptimizerContext> optimizer =
-      make_unique<OptimizerContext>(getDiagnostics(), getOptions(), SIR);
+      make_unique<OptimizerContext>(getDiagnostics(), getOptions(), specializedSIR);
   PassManager& passManager = optimizer->getPassManager();
+  optimizer->getHardwareConfiguration() = machine;
 
   // Setup pass interface
-  optimizer->checkAndPushBack<PassInlining>(true, PassInlining::IK_InlineProcedures);
-  // This pass is currently broken and needs to be redesigned before it can be enabled
-  //  optimizer->checkAndPushBack<PassTemporaryFirstAccss>();
-  optimizer->checkAndPushBack<PassFieldVersioning>();
-  optimizer->checkAndPushBack<PassSSA>();
-  optimizer->checkAndPushBack<PassMultiStageSplitter>(mssSplitStrategy);
-  optimizer->checkAndPushBack<PassStageSplitter>();
-  optimizer->checkAndPushBack<PassPrintStencilGraph>();
-  optimizer->checkAndPushBack<PassTemporaryType>();
-  optimizer->checkAndPushBack<PassSetStageName>();
-  optimizer->checkAndPushBack<PassSetStageGraph>();
-  optimizer->checkAndPushBack<PassStageReordering>(reorderStrategy);
-  optimizer->checkAndPushBack<PassStageMerger>();
-  optimizer->checkAndPushBack<PassStencilSplitter>(maxFields);
-  optimizer->checkAndPushBack<PassTemporaryType>();
-  optimizer->checkAndPushBack<PassTemporaryMerger>();
-  optimizer->checkAndPushBack<PassInlining>(
-      (getOptions().InlineSF || getOptions().PassTmpToFunction),
-      PassInlining::IK_ComputationsOnTheFly);
-  optimizer->checkAndPushBack<PassTemporaryToStencilFunction>();
-  optimizer->checkAndPushBack<PassSetNonTempCaches>();
-  optimizer->checkAndPushBack<PassSetCaches>();
-  optimizer->checkAndPushBack<PassComputeStageExtents>();
-  optimizer->checkAndPushBack<PassSetBoundaryCondition>();
-  optimizer->checkAndPushBack<PassSetBlockSize>();
-  optimizer->checkAndPushBack<PassDataLocalityMetric>();
-  optimizer->checkAndPushBack<PassSetSyncStage>();
+  registerPasses(*optimizer, passManager, reorderStrategy, mssSplitStrategy, maxFields);
 
   DAWN_LOG(INFO) << "All the passes ran with the current command line arugments:";
   for(const auto& a : passManager.getPasses()) {
     DAWN_LOG(INFO) << a->getName();
   }
-  // Run optimization passes
-  for(auto& stencil : optimizer->getStencilInstantiationMap()) {
-    std::shared_ptr<iir::StencilInstantiation> instantiation = stencil.second;
+
+  std::vector<std::shared_ptr<iir::StencilInstantiation>> instantiations;
+  for(auto& stencil : optimizer->getStencilInstantiationMap())
+    instantiations.push_back(stencil.second);
+  const int numInstantiations = instantiations.size();
+
+  // Every instantiation draws its identifiers from a range of its own and reports to a diagnostics
+  // engine of its own. This makes the result independent of the number of jobs and of the order in
+  // which the instantiations are processed.
+  //
+  // The size of a range is derived from the size of the instantiation, as the passes draw a few
+  // identifiers per statement and access. The ranges are never returned, hence they must not be
+  // larger than needed.
+  std::vector<int> uidOffsets(numInstantiations + 1, 0);
+  for(int i = 0; i < numInstantiations; ++i) {
+    const long numUIDs = std::min(1L << 20, 1024 + 16L * computeIIRSize(*instantiations[i]));
+    DAWN_ASSERT_MSG(uidOffsets[i] + numUIDs <= std::numeric_limits<int>::max() / 2,
+                    "too many identifiers reserved");
+    uidOffsets[i + 1] = uidOffsets[i] + numUIDs;
+  }
+  const int firstUID = UIDGenerator::getInstance()->reserve(uidOffsets[numInstantiations]);
+
+  std::vector<std::unique_ptr<DiagnosticsEngine>> diagnostics(numInstantiations);
+  std::vector<char> success(numInstantiations, false);
+
+  auto optimize = [&](PassManager& manager, int i) -> bool {
+    const std::shared_ptr<iir::StencilInstantiation>& instantiation = instantiations[i];
+
+    diagnostics[i] = make_unique<DiagnosticsEngine>();
+    diagnostics[i]->setFilename(diagnostics_->getFilename());
+    OptimizerContext::DiagnosticsScope diagnosticsScope(*diagnostics[i]);
+    UIDScope uidScope(firstUID + uidOffsets[i], uidOffsets[i + 1] - uidOffsets[i]);
+
     DAWN_LOG(INFO) << "Starting Optimization and Analysis passes for `" << instantiation->getName()
                    << "` ...";
-    if(!passManager.runAllPassesOnStecilInstantiation(instantiation))
-      return nullptr;
+    if(!manager.runAllPassesOnStecilInstantiation(instantiation))
+      return false;
     DAWN_LOG(INFO) << "Done with Optimization and Analysis passes for `" << instantiation->getName()
                    << "`";
 
+    // The identifiers drawn from the shared counter depend on the other jobs
+    if(uidScope.isExhausted()) {
+      DiagnosticsBuilder diag(DiagnosticsKind::Error,
+                              instantiation->getMetaData().getStencilLocation());
+      diag << "exhausted the " << (uidOffsets[i + 1] - uidOffsets[i])
+           << " identifiers reserved for stencil '" << instantiation->getName()
+           << "', the result would depend on the number of jobs";
+      diagnostics[i]->report(diag);
+      return false;
+    }
+
     if(options_->SerializeIIR) {
       IIRSerializer::serialize(
           remove_fileextension(instantiation->getMetaData().getFileName(), ".cpp") + ".iir",
           instantiation, serializationKind);
     }
+    return true;
+  };
 
-    stencil.second = instantiation;
+  // -jobs
+  int numJobs = options_->Jobs > 0 ? options_->Jobs
+                                   : static_cast<int>(std::thread::hardware_concurrency());
+  numJobs = std::min(numJobs, numInstantiations);
+
+  // The dumps of -pass-verbose are numbered by a per pass counter of the pass manager
+  if(options_->PassVerbose)
+    numJobs = 1;
+
+  // Run optimization passes
+  if(numJobs <= 1) {
+    for(int i = 0; i < numInstantiations; ++i)
+      if(!(success[i] = optimize(passManager, i)))
+        break;
+  } else {
+    DAWN_LOG(INFO) << "Optimizing " << numInstantiations << " stencil instantiations using "
+                   << numJobs << " jobs";
+
+    std::atomic<int> nextInstantiation(0);
+    std::atomic<int> firstFailure(numInstantiations);
+
+    std::vector<std::thread> workers;
+    for(int job = 0; job < numJobs; ++job) {
+      workers.emplace_back([&]() {
+        // Passes may keep state between runs, hence every worker needs its own instances
+        PassManager workerPassManager;
+        registerPasses(*optimizer, workerPassManager, reorderStrategy, mssSplitStrategy,
+                       maxFields);
+
+        // Instantiations after a failed one are skipped (as in the serial run)
+        for(int i = nextInstantiation++; i < firstFailure; i = nextInstantiation++) {
+          if(!(success[i] = optimize(workerPassManager, i))) {
+            int failure = firstFailure;
+            while(i < failure && !firstFailure.compare_exchange_weak(failure, i))
+              ;
+          }
+        }
+      });
+    }
+    for(auto& worker : workers)
+      worker.join();
+  }
+
+  // -profile-passes
+  if(const PassProfiler* profiler = optimizer->getPassProfiler()) {
+    PassProfiler::OutputFormat format = options_->ProfilePassesFormat == "trace"
+                                            ? PassProfiler::OF_Trace
+                                            : PassProfiler::OF_Report;
+    if(!profiler->write(options_->ProfilePasses, format)) {
+      DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+      diag << "file system error: cannot open file: " << options_->ProfilePasses;
+      diagnostics_->report(diag);
+    }
+  }
+
+  // Merge the diagnostics in the order of the serial run
+  for(int i = 0; i < numInstantiations; ++i) {
+    for(const auto& diag : diagnostics[i]->getQueue())
+      diagnostics_->report(*diag);
+    if(!success[i])
+      return nullptr;
+  }
+
+  // -performance-model
+  if(!options_->PerformanceModel.empty()) {
+    PerformanceModel model(optimizer->getHardwareConfiguration(), domain);
+    std::ofstream fs(options_->PerformanceModel, std::ios::out | std::ios::trunc);
+    fs << model.jsonDump(optimizer->getStencilInstantiationMap()).dump(2) << std::endl;
+    if(!fs) {
+      DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+      diag << "file system error: cannot open file: " << options_->PerformanceModel;
+      diagnostics_->report(diag);
+      return nullptr;
+    }
   }
 
   return optimizer;
@@ -230,6 +547,12 @@ std::unique_ptr<codegen::TranslationUnit> DawnCompiler::compile(const std::share
     return nullptr;
   }
 
+  // -autotune, -tuning-db
+  if(!options_->Autotune.empty() || !options_->TuningDB.empty()) {
+    Autotuner autotuner(*options_, *diagnostics_);
+    return autotuner.compile(SIR);
+  }
+
   // Initialize optimizer
   auto optimizer = runOptimizer(SIR);
 
@@ -248,12 +571,12 @@ std::unique_ptr<codegen::TranslationUnit> DawnCompiler::compile(const std::share
   } else if(options_->Backend == "cuda") {
     CG = make_unique<codegen::cuda::CudaCodeGen>(optimizer.get());
   } else if(options_->Backend == "c++-opt") {
-    dawn_unreachable("GTClangOptCXX not supported yet");
+    CG = make_unique<codegen::cxxopt::CXXOptCodeGen>(optimizer.get());
   } else {
     diagnostics_->report(buildDiag("-backend", options_->Backend,
                                    "backend options must be : " +
                                        dawn::RangeToString(", ", "", "")(std::vector<std::string>{
-                                           "gridtools", "c++-naive", "c++-opt"})));
+                                           "gridtools", "c++-naive", "c++-opt", "cuda"})));
     return nullptr;
   }
 
@@ -50,6 +50,9 @@ public:
 
   /// @brief Set the name of the file currently being processed
   void setFilename(const std::string& filename) { filename_ = filename; }
+
+  /// @brief Get the name of the file currently being processed
+  const std::string& getFilename() const { return filename_; }
 };
 
 } // namespace dawn
@@ -0,0 +1,81 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/TuningDatabase.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/FileUtil.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/Logging.h"
+#include <fstream>
+
+namespace dawn {
+
+TuningDatabase::TuningDatabase(std::string file) : file_(std::move(file)) {}
+
+bool TuningDatabase::load() {
+  entries_.clear();
+
+  std::ifstream ifs(file_);
+  if(!ifs.is_open())
+    return true;
+
+  try {
+    json::json node;
+    ifs >> node;
+
+    const json::json& entries = node.at("entries");
+    for(auto it = entries.begin(); it != entries.end(); ++it) {
+      TuningEntry entry;
+      entry.Stencil = it.value().at("stencil").get<std::string>();
+      entry.Backend = it.value().at("backend").get<std::string>();
+      entry.Runtime = it.value().at("runtime").get<double>();
+      const json::json& options = it.value().at("options");
+      for(auto optionIt = options.begin(); optionIt != options.end(); ++optionIt)
+        entry.Options.emplace(optionIt.key(), optionIt.value().get<std::string>());
+      entries_.emplace(it.key(), std::move(entry));
+    }
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << "failed to read tuning database '" << file_ << "': " << e.what();
+    entries_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool TuningDatabase::save() const {
+  json::json node;
+  node["version"] = DAWN_FULL_VERSION_STR;
+  node["entries"] = json::json::object();
+  for(const auto& entryPair : entries_) {
+    const TuningEntry& entry = entryPair.second;
+    json::json entryNode;
+    entryNode["stencil"] = entry.Stencil;
+    entryNode["backend"] = entry.Backend;
+    entryNode["runtime"] = entry.Runtime;
+    entryNode["options"] = entry.Options;
+    node["entries"][entryPair.first] = entryNode;
+  }
+  return writeFileAtomically(file_, node.dump(2));
+}
+
+const TuningEntry* TuningDatabase::lookup(const std::string& key) const {
+  auto it = entries_.find(key);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+void TuningDatabase::insert(const std::string& key, TuningEntry entry) {
+  entries_[key] = std::move(entry);
+}
+
+} // namespace dawn
@@ -0,0 +1,69 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_TUNINGDATABASE_H
+#define DAWN_COMPILER_TUNINGDATABASE_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <map>
+#include <string>
+
+namespace dawn {
+
+/// @brief Best configuration of a stencil found by the autotuner
+/// @ingroup compiler
+struct TuningEntry {
+  std::string Stencil;                        ///< Name of the stencil
+  std::string Backend;                        ///< Backend the stencil was tuned for
+  std::map<std::string, std::string> Options; ///< Values of the tuned options (by their flag)
+  double Runtime = 0;                         ///< Runtime reported by the benchmark harness
+};
+
+/// @brief Persistent database of the configurations found by the autotuner
+///
+/// The database is a single JSON file mapping the key of a stencil (see `Autotuner::computeKey`)
+/// to its `TuningEntry`. It is read once and written back as a whole, concurrent tuning sessions
+/// on the same database hence overwrite each other's results (the file itself is never corrupted).
+///
+/// @ingroup compiler
+class TuningDatabase : NonCopyable {
+  std::string file_;
+  std::map<std::string, TuningEntry> entries_;
+
+public:
+  /// @brief Open the database stored in `file` (the file is created on the first `save`)
+  explicit TuningDatabase(std::string file);
+
+  /// @brief Read the entries of the database file (a missing file is an empty database)
+  /// @returns `false` if the file cannot be parsed
+  bool load();
+
+  /// @brief Write all entries to the database file
+  /// @returns `true` on success
+  bool save() const;
+
+  /// @brief Get the entry of `key`
+  /// @returns the entry or `nullptr` if there is no entry for `key`
+  const TuningEntry* lookup(const std::string& key) const;
+
+  /// @brief Add the entry of `key` (replacing a previous entry)
+  void insert(const std::string& key, TuningEntry entry);
+
+  /// @brief Get the database file
+  const std::string& getFile() const { return file_; }
+};
+
+} // namespace dawn
+
+#endif
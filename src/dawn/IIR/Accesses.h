@@ -16,7 +16,7 @@
 #define DAWN_IIR_ACCESSES_H
 
 #include "dawn/IIR/Extents.h"
-#include <unordered_map>
+#include "dawn/Support/SmallIntMap.h"
 
 namespace dawn {
 namespace iir {
@@ -24,13 +24,16 @@ namespace iir {
 class StencilFunctionInstantiation;
 class StencilMetaInformation;
 
+/// @brief Extents of the accesses to each AccessID, sorted by AccessID
+using AccessMap = SmallIntMap<Extents>;
+
 /// @brief Read and write accesses of a statement
 ///
 /// Accesses are either part of a `StencilInstantiation` or `StencilFunctionInstantiation`.
 /// @ingroup optimizer
 class Accesses {
-  std::unordered_map<int, Extents> writeAccesses_;
-  std::unordered_map<int, Extents> readAccesses_;
+  AccessMap writeAccesses_;
+  AccessMap readAccesses_;
 
 public:
   Accesses() = default;
@@ -73,11 +76,11 @@ public:
   const Extents& getWriteAccess(int AccessID) const;
 
   /// @brief Get the accesses maps
-  std::unordered_map<int, Extents>& getReadAccesses() { return readAccesses_; }
-  const std::unordered_map<int, Extents>& getReadAccesses() const { return readAccesses_; }
+  AccessMap& getReadAccesses() { return readAccesses_; }
+  const AccessMap& getReadAccesses() const { return readAccesses_; }
 
-  std::unordered_map<int, Extents>& getWriteAccesses() { return writeAccesses_; }
-  const std::unordered_map<int, Extents>& getWriteAccesses() const { return writeAccesses_; }
+  AccessMap& getWriteAccesses() { return writeAccesses_; }
+  const AccessMap& getWriteAccesses() const { return writeAccesses_; }
 
   /// @brief Convert the accesses of a stencil or stencil-function instantiation to string
   /// @{
@@ -18,10 +18,10 @@
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Unreachable.h"
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iosfwd>
 #include <iterator>
-#include <list>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -34,6 +34,12 @@ namespace dawn {
 namespace iir {
 
 /// @brief CRTP base class of all dependency graphs
+///
+/// The vertices are numbered consecutively by their VertexID which indexes the flat adjacency list
+/// as well as the reverse mapping to the vertex values. The edges of a vertex are stored
+/// contiguously and an additional hash index of the (From, To) pairs makes the duplicate check of
+/// `insertEdge` constant time.
+///
 /// @ingroup optimizer
 template <class Derived, class EdgeData>
 class DependencyGraph {
@@ -57,7 +63,7 @@ public:
     bool operator!=(const Edge& other) const { return !(*this == other); }
   };
 
-  using EdgeList = std::list<Edge>;
+  using EdgeList = std::vector<Edge>;
 
   struct Vertex {
     std::size_t VertexID; ///< Unqiue ID of the Vertex
@@ -66,20 +72,25 @@ public:
 
 protected:
   std::unordered_map<int, Vertex> vertices_;
-  std::vector<std::shared_ptr<EdgeList>> adjacencyList_;
+  std::vector<int> vertexValues_;
+  std::vector<EdgeList> adjacencyList_;
+
+  /// Map of the (FromVertexID, ToVertexID) pair of each edge to its index in the edge list of
+  /// `FromVertexID`
+  std::unordered_map<std::uint64_t, std::size_t> edgeIndices_;
 
 public:
-  /// @brief Get the adjacency list
-  /// @{
-  std::vector<std::shared_ptr<EdgeList>>& getAdjacencyList() { return adjacencyList_; }
-  const std::vector<std::shared_ptr<EdgeList>>& getAdjacencyList() const { return adjacencyList_; }
-  /// @}
+  /// @brief Get the key identifying the edge (FromVertexID, ToVertexID) in hash maps
+  static std::uint64_t getEdgeKey(std::size_t FromVertexID, std::size_t ToVertexID) {
+    return (static_cast<std::uint64_t>(FromVertexID) << 32) |
+           static_cast<std::uint64_t>(ToVertexID);
+  }
+
+  /// @brief Get the adjacency list (indexed by VertexID)
+  const std::vector<EdgeList>& getAdjacencyList() const { return adjacencyList_; }
 
   /// @brief Get the vertices
-  /// @{
-  std::unordered_map<int, Vertex>& getVertices() { return vertices_; }
   const std::unordered_map<int, Vertex>& getVertices() const { return vertices_; }
-  /// @}
 
   //===----------------------------------------------------------------------------------------===//
   //     Graph implementation
@@ -91,8 +102,10 @@ public:
   /// @brief Insert a new node
   Vertex& insertNode(int ID) {
     auto insertPair = vertices_.emplace(ID, Vertex{adjacencyList_.size(), ID});
-    if(insertPair.second)
-      adjacencyList_.push_back(std::make_shared<EdgeList>());
+    if(insertPair.second) {
+      vertexValues_.push_back(ID);
+      adjacencyList_.emplace_back();
+    }
     return insertPair.first->second;
   }
 
@@ -122,19 +135,33 @@ public:
     // if the node does already exist)
     static_cast<Derived*>(this)->insertNode(vertexValueTo);
 
-    // Traverse the edge-list of node `IDFrom` to check if we already have such an edge
-    auto& edgeList = adjacencyList_[getVertexIDFromValue(vertexValueFrom)];
-    const Edge edge{std::forward<TEdgeData>(data), getVertexIDFromValue(vertexValueFrom),
-                    getVertexIDFromValue(vertexValueTo)};
-
-    auto it = std::find_if(edgeList->begin(), edgeList->end(), [&edge](const Edge& e) {
-      return e.FromVertexID == edge.FromVertexID && e.ToVertexID == edge.ToVertexID;
-    });
+    // Check if we already have such an edge
+    const std::size_t FromVertexID = getVertexIDFromValue(vertexValueFrom);
+    const std::size_t ToVertexID = getVertexIDFromValue(vertexValueTo);
+    auto& edgeList = adjacencyList_[FromVertexID];
 
-    if(it != edgeList->end())
-      static_cast<Derived*>(this)->edgeAlreadyExists(it->Data, edge.Data);
+    auto insertPair = edgeIndices_.emplace(getEdgeKey(FromVertexID, ToVertexID), edgeList.size());
+    if(!insertPair.second)
+      static_cast<Derived*>(this)->edgeAlreadyExists(edgeList[insertPair.first->second].Data,
+                                                     data);
     else
-      edgeList->push_back(edge);
+      edgeList.push_back(Edge{std::forward<TEdgeData>(data), FromVertexID, ToVertexID});
+  }
+
+  /// @brief Get the edge from `FromVertexID` to `ToVertexID` (or `nullptr` if there is no such
+  /// edge)
+  const Edge* getEdge(std::size_t FromVertexID, std::size_t ToVertexID) const {
+    auto it = edgeIndices_.find(getEdgeKey(FromVertexID, ToVertexID));
+    return it == edgeIndices_.end() ? nullptr : &adjacencyList_[FromVertexID][it->second];
+  }
+
+  /// @brief Check if there is an edge from `vertexValueFrom` to `vertexValueTo`
+  bool hasEdge(int vertexValueFrom, int vertexValueTo) const {
+    auto fromIt = vertices_.find(vertexValueFrom);
+    auto toIt = vertices_.find(vertexValueTo);
+    if(fromIt == vertices_.end() || toIt == vertices_.end())
+      return false;
+    return edgeIndices_.count(getEdgeKey(fromIt->second.VertexID, toIt->second.VertexID));
   }
 
   /// @brief Callback which will be invoked if an edge already exists
@@ -157,24 +184,21 @@ public:
 
   /// @brief Get the ID of the vertex given by ID
   int getValueFromVertexID(std::size_t VertexID) const {
-    for(const auto& vertexPair : vertices_)
-      if(vertexPair.second.VertexID == VertexID)
-        return vertexPair.first;
-    dawn_unreachable("invalid VertexID");
+    DAWN_ASSERT_MSG(VertexID < vertexValues_.size(), "invalid VertexID");
+    return vertexValues_[VertexID];
   }
 
   /// @brief Get the list of edges of node given by `ID`
-  EdgeList& edgesOf(int vertexValue) {
-    return *(adjacencyList_[getVertexIDFromValue(vertexValue)]);
-  }
   const EdgeList& edgesOf(int vertexValue) const {
-    return *(adjacencyList_[getVertexIDFromValue(vertexValue)]);
+    return adjacencyList_[getVertexIDFromValue(vertexValue)];
   }
 
   /// @brief Clear the graph
   void clear() {
     vertices_.clear();
+    vertexValues_.clear();
     adjacencyList_.clear();
+    edgeIndices_.clear();
   }
 
   /// @brief Check if graph is empty
@@ -204,7 +228,7 @@ public:
   std::string toString() const {
     std::stringstream ss;
     for(std::size_t VertexID = 0; VertexID < adjacencyList_.size(); ++VertexID) {
-      for(const Edge& edge : *(adjacencyList_[VertexID])) {
+      for(const Edge& edge : adjacencyList_[VertexID]) {
         ss << static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.FromVertexID)
            << static_cast<const Derived*>(this)->edgeDataToString(edge.Data)
            << static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.ToVertexID) << "\n";
@@ -223,7 +247,7 @@ protected:
   bool hasCycleDependencyImpl(const int targetVertexID, const int seedID,
                               std::set<int>& visited) const {
     // DFS search for cycles on access to ID
-    for(auto& edge : *(getAdjacencyList()[seedID])) {
+    for(auto& edge : adjacencyList_[seedID]) {
       if(edge.ToVertexID == targetVertexID) {
         return true;
       }
@@ -254,7 +278,7 @@ protected:
                        "\"");
 
       // Convert edge to dot
-      for(const Edge& edge : *(adjacencyList_[VertexID]))
+      for(const Edge& edge : adjacencyList_[VertexID])
         edgeStrs.emplace(
             "\"" + FromVertexName + "\" -> \"" +
             static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.ToVertexID) + "\"" +
@@ -42,12 +42,6 @@ void DependencyGraphAccesses::insertStatementAccessesPair(
   }
 }
 
-DependencyGraphAccesses::Vertex& DependencyGraphAccesses::insertNode(int ID) {
-  Vertex& vertex = Base::insertNode(ID);
-  VertexIDToAccessIDMap_.emplace(vertex.VertexID, vertex.value);
-  return vertex;
-}
-
 void DependencyGraphAccesses::edgeAlreadyExists(DependencyGraphAccesses::EdgeData& existingEdge,
                                                 const DependencyGraphAccesses::EdgeData& newEdge) {
   if(!newEdge.isPointwise())
@@ -55,9 +49,7 @@ void DependencyGraphAccesses::edgeAlreadyExists(DependencyGraphAccesses::EdgeDat
 }
 
 int DependencyGraphAccesses::getIDFromVertexID(std::size_t VertexID) const {
-  auto it = VertexIDToAccessIDMap_.find(VertexID);
-  DAWN_ASSERT_MSG(it != VertexIDToAccessIDMap_.end(), "Node with given VertexID does not exist");
-  return it->second;
+  return getValueFromVertexID(VertexID);
 }
 
 const char* DependencyGraphAccesses::edgeDataToString(const EdgeData& data) const {
@@ -92,7 +84,7 @@ void DependencyGraphAccesses::merge(const DependencyGraphAccesses* other) {
 
   // Insert the edges of `other`
   for(std::size_t VertexID = 0; VertexID < other->getAdjacencyList().size(); ++VertexID) {
-    for(const Edge& edge : *(other->getAdjacencyList()[VertexID])) {
+    for(const Edge& edge : other->getAdjacencyList()[VertexID]) {
       insertEdge(other->getIDFromVertexID(edge.FromVertexID),
                  other->getIDFromVertexID(edge.ToVertexID), edge.Data);
     }
@@ -101,10 +93,7 @@ void DependencyGraphAccesses::merge(const DependencyGraphAccesses* other) {
 
 std::shared_ptr<DependencyGraphAccesses> DependencyGraphAccesses::clone() const {
   auto graph = std::make_shared<DependencyGraphAccesses>(metaData_);
-  graph->vertices_ = vertices_;
-  graph->VertexIDToAccessIDMap_ = VertexIDToAccessIDMap_;
-  for(const auto& edgeListPtr : adjacencyList_)
-    graph->adjacencyList_.push_back(std::make_shared<EdgeList>(*edgeListPtr));
+  static_cast<Base&>(*graph) = *this;
   return graph;
 }
 
@@ -156,7 +145,7 @@ std::vector<std::set<std::size_t>> DependencyGraphAccesses::partitionInSubGraphs
         partition[curNode] = currentPartitionIdx;
       }
 
-      for(const Edge& edge : *adjacencyList_[curNode])
+      for(const Edge& edge : adjacencyList_[curNode])
         nodesToVisit.push_back(edge.ToVertexID);
     }
   }
@@ -194,11 +183,11 @@ void getInputVertexIDsImpl(
   const auto& adjacencyList = graph.getAdjacencyList();
   for(const auto& vertex : vertexList) {
     std::size_t VertexID = getVertexIDFromVertexListElemenFunc(vertex);
-    if(adjacencyList[VertexID]->empty())
+    if(adjacencyList[VertexID].empty())
       inputVertexIDs.push_back(VertexID);
-    else if(adjacencyList[VertexID]->size() == 1) {
+    else if(adjacencyList[VertexID].size() == 1) {
       // We allow self-dependencies!
-      const auto& edge = adjacencyList[VertexID]->front();
+      const auto& edge = adjacencyList[VertexID].front();
       if(edge.FromVertexID == edge.ToVertexID)
         inputVertexIDs.push_back(VertexID);
     }
@@ -220,7 +209,7 @@ void getOutputVertexIDsImpl(
 
   // Construct a set of dependent nodes i.e nodes with edges from other nodes pointing to them
   for(const auto& edgeList : adjacencyList)
-    for(const auto& edge : *edgeList)
+    for(const auto& edge : edgeList)
       // We allow self-dependencies!
       if(edge.FromVertexID != edge.ToVertexID)
         dependentNodes.insert(edge.ToVertexID);
@@ -349,7 +338,7 @@ private:
     index_++;
 
     // Consider successors of the `FromVertex`
-    for(const EdgeType& edge : *graph_->getAdjacencyList()[FromVertexID]) {
+    for(const EdgeType& edge : graph_->getAdjacencyList()[FromVertexID]) {
 
       VertexData& ToVertexData = vertexData_[edge.ToVertexID];
 
@@ -421,7 +410,7 @@ public:
     // Compute the neighbor-list
     std::vector<std::set<std::size_t>> neighborList(numVertices);
     for(std::size_t FromVertexID = 0; FromVertexID < numVertices; ++FromVertexID) {
-      for(const Edge& edge : *adjacencyList[FromVertexID]) {
+      for(const Edge& edge : adjacencyList[FromVertexID]) {
         neighborList[edge.FromVertexID].insert(edge.ToVertexID);
         neighborList[edge.ToVertexID].insert(edge.FromVertexID);
       }
@@ -467,11 +456,6 @@ void DependencyGraphAccesses::greedyColoring(std::unordered_map<int, int>& color
   return GreedyColoring(this, coloring).compute();
 }
 
-void DependencyGraphAccesses::clear() {
-  Base::clear();
-  VertexIDToAccessIDMap_.clear();
-}
-
 void DependencyGraphAccesses::toJSON(const std::string& file, DiagnosticsEngine& diagEngine) const {
   std::unordered_map<std::size_t, Extents> extentMap = *computeBoundaryExtents(this);
   json::json jgraph;
@@ -507,7 +491,7 @@ void DependencyGraphAccesses::toJSON(const std::string& file, DiagnosticsEngine&
 
     jgraph["vertices"][std::to_string(VertexID)] = jvertex;
 
-    for(const Edge& edge : *getAdjacencyList()[VertexID]) {
+    for(const Edge& edge : getAdjacencyList()[VertexID]) {
       json::json jedge;
 
       jedge["from"] = edge.FromVertexID;
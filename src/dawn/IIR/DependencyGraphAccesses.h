@@ -62,7 +62,6 @@ class DependencyGraphAccesses
     : public DependencyGraph<DependencyGraphAccesses, DependencyGraphAccessesEdgeData> {
 
   const StencilMetaInformation& metaData_;
-  std::unordered_map<std::size_t, int> VertexIDToAccessIDMap_;
 
 public:
   using Base = DependencyGraph<DependencyGraphAccesses, DependencyGraphAccessesEdgeData>;
@@ -97,9 +96,6 @@ public:
   void
   insertStatementAccessesPair(const std::unique_ptr<iir::StatementAccessesPair>& stmtAccessPair);
 
-  /// @brief Insert a new node
-  Vertex& insertNode(int ID);
-
   /// @brief Merge extents if edge already exists
   void edgeAlreadyExists(EdgeData& existingEdge, const EdgeData& newEdge);
 
@@ -170,9 +166,6 @@ public:
   /// @see https://en.wikipedia.org/wiki/Greedy_coloring
   void greedyColoring(std::unordered_map<int, int>& coloring) const;
 
-  /// @brief Clear the graph
-  void clear();
-
   /// @brief Serialize the graph to JSON
   void toJSON(const std::string& file, DiagnosticsEngine& diagEngine) const;
 };
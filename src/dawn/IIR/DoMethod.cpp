@@ -24,15 +24,15 @@
 #include "dawn/IIR/StencilMetaInformation.h"
 #include "dawn/Optimizer/AccessUtils.h"
 #include "dawn/SIR/Statement.h"
-#include "dawn/Support/IndexGenerator.h"
 #include "dawn/Support/Logging.h"
+#include "dawn/Support/UIDGenerator.h"
 #include <boost/optional.hpp>
 
 namespace dawn {
 namespace iir {
 
 DoMethod::DoMethod(Interval interval, const StencilMetaInformation& metaData)
-    : interval_(interval), id_(IndexGenerator::Instance().getIndex()), metaData_(metaData) {}
+    : interval_(interval), id_(UIDGenerator::getInstance()->get()), metaData_(metaData) {}
 
 std::unique_ptr<DoMethod> DoMethod::clone() const {
   auto cloneMS = make_unique<DoMethod>(interval_, metaData_);
@@ -127,9 +127,9 @@ void DoMethod::updateLevel() {
   //        +----------> | InputOutput | <----------+
   //                     +-------------+
   //
-  std::unordered_map<int, Field> inputOutputFields;
-  std::unordered_map<int, Field> inputFields;
-  std::unordered_map<int, Field> outputFields;
+  FieldMap inputOutputFields;
+  FieldMap inputFields;
+  FieldMap outputFields;
 
   for(const auto& statementAccessesPair : children_) {
     const auto& access = statementAccessesPair->getAccesses();
@@ -48,7 +48,7 @@ class DoMethod : public IIRNode<Stage, DoMethod, StatementAccessesPair> {
     void clear();
 
     /// Declaration of the fields of this doMethod
-    std::unordered_map<int, Field> fields_;
+    FieldMap fields_;
     std::shared_ptr<DependencyGraphAccesses> dependencyGraph_;
   };
 
@@ -110,7 +110,7 @@ public:
   /// `Input`
   ///
   /// The fields are computed during `DoMethod::update`.
-  const std::unordered_map<int, Field>& getFields() const { return derivedInfo_.fields_; }
+  const FieldMap& getFields() const { return derivedInfo_.fields_; }
 
   bool hasField(int accessID) const { return derivedInfo_.fields_.count(accessID); }
 
@@ -36,47 +36,49 @@ json::json Field::jsonDump() const {
   return node;
 }
 
-void mergeFields(std::unordered_map<int, Field> const& sourceFields,
-                 std::unordered_map<int, Field>& destinationFields,
+void mergeFields(FieldMap const& sourceFields, FieldMap& destinationFields,
                  boost::optional<Extents> baseExtents) {
 
-  for(const auto& fieldPair : sourceFields) {
-    Field sField = fieldPair.second;
+  auto mergeField = [](Field& dField, const Field& sField) {
+    // Adjust the Intend
+    if(dField.getIntend() != sField.getIntend())
+      dField.setIntend(Field::IK_InputOutput);
+
+    // field accounting for extents of the accesses plus the base extent (i.e. normally redundant
+    // computations of the stages)
+
+    // Merge the Extent
+    dField.mergeReadExtentsRB(sField.getReadExtentsRB());
+    dField.mergeWriteExtentsRB(sField.getWriteExtentsRB());
+
+    dField.mergeReadExtents(sField.getReadExtents());
+    dField.mergeWriteExtents(sField.getWriteExtents());
+    dField.extendInterval(sField.getInterval());
+  };
+
+  if(!baseExtents.is_initialized()) {
+    destinationFields.merge(sourceFields, mergeField);
+    return;
+  }
+
+  // add the baseExtent of the field (i.e. normally redundant computations of a stage)
+  FieldMap expandedFields(sourceFields);
+  for(auto& fieldPair : expandedFields) {
+    Field& sField = fieldPair.second;
 
     auto readExtentsRB = sField.getReadExtents();
-    if(readExtentsRB.is_initialized() && baseExtents.is_initialized()) {
+    if(readExtentsRB.is_initialized()) {
       readExtentsRB->expand(*baseExtents);
       sField.setReadExtentsRB(readExtentsRB);
     }
 
     auto writeExtentsRB = sField.getWriteExtents();
-    if(writeExtentsRB.is_initialized() && baseExtents.is_initialized()) {
+    if(writeExtentsRB.is_initialized()) {
       writeExtentsRB->expand(*baseExtents);
       sField.setWriteExtentsRB(writeExtentsRB);
     }
-
-    auto it = destinationFields.find(sField.getAccessID());
-    if(it != destinationFields.end()) {
-      // Adjust the Intend
-      if(it->second.getIntend() != sField.getIntend())
-        it->second.setIntend(Field::IK_InputOutput);
-
-      // field accounting for extents of the accesses plus the base extent (i.e. normally redundant
-      // computations of the stages)
-
-      // Merge the Extent
-      it->second.mergeReadExtentsRB(sField.getReadExtentsRB());
-      it->second.mergeWriteExtentsRB(sField.getWriteExtentsRB());
-
-      it->second.mergeReadExtents(sField.getReadExtents());
-      it->second.mergeWriteExtents(sField.getWriteExtents());
-      it->second.extendInterval(sField.getInterval());
-    } else {
-
-      // add the baseExtent of the field (i.e. normally redundant computations of a stage)
-      destinationFields.emplace(sField.getAccessID(), sField);
-    }
   }
+  destinationFields.merge(expandedFields, mergeField);
 }
 
 void Field::setReadExtentsRB(boost::optional<Extents> const& extents) {
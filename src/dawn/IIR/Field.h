@@ -19,6 +19,7 @@
 #include "dawn/IIR/FieldAccessExtents.h"
 #include "dawn/IIR/Interval.h"
 #include "dawn/Support/Json.h"
+#include "dawn/Support/SmallIntMap.h"
 #include <utility>
 
 namespace dawn {
@@ -138,12 +139,14 @@ public:
   inline void extendInterval(Interval const& interval) { interval_.merge(interval); }
 };
 
+/// @brief Fields indexed by their AccessID
+using FieldMap = SmallIntMap<Field>;
+
 /// @brief merges all the fields from sourceFields into destinationFields
 /// If a baseExtent is provided (optionally), the extent of each sourceField is expanded with the
 /// baseExtent (in order to account for redundant block computations where the accesses were
 /// recorded)
-void mergeFields(std::unordered_map<int, Field> const& sourceFields,
-                 std::unordered_map<int, Field>& destinationFields,
+void mergeFields(FieldMap const& sourceFields, FieldMap& destinationFields,
                  boost::optional<Extents> baseExtents = boost::optional<Extents>());
 
 } // namespace iir
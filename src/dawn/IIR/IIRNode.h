@@ -60,10 +60,21 @@ protected:
   /// @{
   virtual ~IIRNode() = default;
   IIRNode() = default;
-  IIRNode(IIRNode&&) = default;
+  IIRNode(IIRNode&& other)
+      : parent_(other.parent_), derivedInfoDirty_(other.derivedInfoDirty_),
+        children_(std::move(other.children_)) {
+    for(const auto& child : children_)
+      linkChild<Child>(child);
+  }
   /// @}
 
-  const std::unique_ptr<Parent>* parent_ = nullptr;
+  /// @brief the parent node. The nodes are always heap allocated and owned by a smart pointer of
+  /// their parent, therefore the address is stable when the container of the siblings reallocates
+  Parent* parent_ = nullptr;
+
+  /// @brief the derived info of the node is out of date with respect to its children and will be
+  /// recomputed by the next `updateDirtyDerivedInfo` (the flag is propagated to the ancestors)
+  bool derivedInfoDirty_ = false;
 
   template <class T>
   using SmartPtr = typename std::conditional<std::is_void<Child>::value, std::shared_ptr<T>,
@@ -125,14 +136,14 @@ public:
   inline const ChildSmartPtrType& getChild(unsigned long pos) {
     return getChildImpl<typename std::iterator_traits<ChildIterator>::iterator_category>(pos);
   }
-  /// @brief get unique_ptr to parent
-  inline const std::unique_ptr<Parent>& getParent() const {
+  /// @brief get the parent node
+  inline Parent* getParent() const {
     DAWN_ASSERT(parent_);
-    return *parent_;
+    return parent_;
   }
 
-  /// @brief get raw pointer to parent smart ptr
-  inline const std::unique_ptr<Parent>* getParentPtr() { return parent_; }
+  /// @brief get the parent node (nullptr if the node has no parent)
+  inline Parent* getParentPtr() const { return parent_; }
   /// @}
 
   /// @brief erase a children element (tree consistency is ensured after erasure)
@@ -171,98 +182,15 @@ public:
   /// children derived infos
   virtual void updateFromChildren() {}
 
-  inline void setParent(const std::unique_ptr<Parent>& p) { parent_ = &p; }
+  inline void setParent(Parent* p) { parent_ = p; }
 
   /// @brief check if the pointer to parent is set
   inline bool parentIsSet() const { return static_cast<bool>(parent_); }
 
-  template <bool T>
-  struct identity {
-    using type = std::integral_constant<bool, T>;
-  };
-
-  template <typename T>
-  struct identity_t {
-    using type = T;
-  };
-
-  template <typename T>
-  struct isVoid {
-    using type = typename std::is_void<typename std::remove_reference<T>::type::element_type>::type;
-  };
-
-  template <typename T>
-  struct is_child_void {
-    static constexpr bool value =
-        std::conditional<std::is_void<T>::value, identity<true>, isVoid<T>>::type::type::value;
-  };
-
-  template <typename T>
-  struct getChildTypeImpl {
-    using type = typename std::remove_reference<T>::type::element_type::ChildSmartPtrType;
-  };
-
-  template <typename T>
-  struct getChildType {
-    using type = typename std::conditional<std::is_void<T>::value, identity_t<void>,
-                                           getChildTypeImpl<T>>::type;
-  };
-
-  /// @brief set the parent pointer of the children
-  template <typename TChildSmartPtr>
-  void
-  setChildrenParent(typename std::enable_if<!is_child_void<TChildSmartPtr>::value>::type* = 0) {
-    if(!parent_)
-      return;
-
-    const std::unique_ptr<NodeType>& thisNodeSmartPtr =
-        (*parent_)->getChildSmartPtr(static_cast<NodeType*>(this));
-
-    for(const auto& child : getChildren()) {
-      child->setParent(thisNodeSmartPtr);
-      child->template setChildrenParent<typename getChildType<TChildSmartPtr>::type::type>();
-    }
-  }
-
-  /// @brief set the parent pointer of the children
-  template <typename TChildSmartPtr>
-  void setChildrenParent(typename std::enable_if<is_child_void<TChildSmartPtr>::value>::type* = 0) {
-  }
-
-  /// @brief set the parent pointer of a child of this node
-  /// @param child child node of this node, for which the parent pointer will be set
-  template <typename TParent, typename TChild>
-  void setChildParent(
-      const std::unique_ptr<TChild>& child,
-      typename std::enable_if<!std::is_void<TParent>::value &&
-                              !is_child_void<std::unique_ptr<TChild>>::value>::type* = 0) {
-
-    static_assert(std::is_same<TParent, Parent>::value,
-                  "The template TParent type of this function should be == Parent. The function is "
-                  "templated only for syntax specialization using SFINAE");
-
-    if(parent_) {
-      // we need to find the smart ptr of "this"
-      const std::unique_ptr<NodeType>& thisNodeSmartPtr =
-          (*parent_)->getChildSmartPtr(static_cast<NodeType*>(this));
-
-      child->setParent(thisNodeSmartPtr);
-
-      // we recursively set the parent of not only this child but all the siblings, since an insert
-      // into a vector can modify the pointers of all elements
-      for(const auto& sibling : thisNodeSmartPtr->getChildren()) {
-        sibling->setParent(thisNodeSmartPtr);
-        sibling->template setChildrenParent<
-            typename getChildType<std::unique_ptr<TChild>>::type::type>();
-      }
-    }
-  }
-
-  template <typename TParent, typename TChild>
-  void setChildParent(
-      const std::unique_ptr<TChild>& child,
-      typename std::enable_if<std::is_void<TParent>::value ||
-                              is_child_void<std::unique_ptr<TChild>>::value>::type* = 0) {}
+  /// @brief check if the chain of parents of this node reaches the root of a tree (a node type
+  /// without parent). The derived info is only propagated upwards within attached trees: the
+  /// nodes of a detached subtree are still being built and their derived info can be incomplete
+  inline bool isAttachedToRoot() const { return isAttachedToRootImpl<NodeType>(); }
 
   /// @brief insert a child node (specialization for nodes with a parent node)
   /// @param child node being inserted as a child
@@ -346,6 +274,7 @@ public:
   inline void updateFromChildrenRec(
       typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
 
+    ++NodeUpdateStatistics::getThreadLocal().NumUpdateFromChildren;
     updateFromChildren();
   }
 
@@ -354,11 +283,11 @@ public:
   inline void updateFromChildrenRec(
       typename std::enable_if<!std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
 
+    ++NodeUpdateStatistics::getThreadLocal().NumUpdateFromChildren;
     updateFromChildren();
 
-    auto parentPtr = getParentPtr();
-    if(parentPtr) {
-      (*parentPtr)->template updateFromChildrenRec<typename TNodeType::ParentType>();
+    if(isAttachedToRoot()) {
+      parent_->template updateFromChildrenRec<typename TNodeType::ParentType>();
     }
   }
 
@@ -366,6 +295,7 @@ public:
   template <typename TNodeType>
   inline void clearDerivedInfoRec(
       typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
+    ++NodeUpdateStatistics::getThreadLocal().NumClearDerivedInfo;
     clearDerivedInfo();
   }
 
@@ -374,10 +304,11 @@ public:
   inline void clearDerivedInfoRec(
       typename std::enable_if<!std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
 
-    auto parentPtr = getParentPtr();
-    if(parentPtr) {
-      (*parentPtr)->clearDerivedInfo();
-      (*parentPtr)->template clearDerivedInfoRec<typename TNodeType::ParentType>();
+    if(isAttachedToRoot()) {
+      auto parentPtr = getParentPtr();
+      ++NodeUpdateStatistics::getThreadLocal().NumClearDerivedInfo;
+      parentPtr->clearDerivedInfo();
+      parentPtr->template clearDerivedInfoRec<typename TNodeType::ParentType>();
     }
   }
 
@@ -386,9 +317,11 @@ public:
   /// propagate it to the top or bottom of the tree
   void update(NodeUpdateType updateType) {
     if(impl::updateLevel(updateType)) {
+      ++NodeUpdateStatistics::getThreadLocal().NumClearDerivedInfo;
       clearDerivedInfo();
       static_cast<NodeType*>(this)->updateLevel();
       if(!impl::updateTreeAbove(updateType)) {
+        ++NodeUpdateStatistics::getThreadLocal().NumUpdateFromChildren;
         updateFromChildren();
       }
     }
@@ -404,14 +337,85 @@ public:
   virtual void updateLevel() {}
   virtual void clearDerivedInfo() {}
 
+  /// @brief mark the derived info of the tree above this node as dirty, without recomputing it
+  ///
+  /// Every dirty ancestor is recomputed once, no matter how many of its children were invalidated,
+  /// by the next call to `updateDirtyDerivedInfo` on the root of the tree. This replaces a sequence
+  /// of `update(NodeUpdateType::levelAndTreeAbove)` on sibling nodes, which recomputes all the
+  /// ancestors for every sibling.
+  void invalidateTreeAbove() { invalidateTreeAboveImpl<NodeType>(); }
+
+  /// @brief mark the derived info of this node (and therefore of all its ancestors) as dirty
+  ///
+  /// Passes modifying the statements of a node mark it dirty instead of updating it, the next
+  /// `updateDirtyDerivedInfo` recomputes it as `update(NodeUpdateType::level)` would.
+  void markDerivedInfoDirty() {
+    derivedInfoDirty_ = true;
+    invalidateTreeAbove();
+  }
+
+  /// @brief recompute the derived info of the dirty nodes of this subtree, children before their
+  /// parents. Subtrees without dirty nodes are not visited
+  void updateDirtyDerivedInfo() { updateDirtyDerivedInfoImpl<Child>(); }
+
+  /// @brief check if the derived info has to be recomputed by `updateDirtyDerivedInfo`
+  bool isDerivedInfoDirty() const { return derivedInfoDirty_; }
+
 private:
+  template <typename TNodeType>
+  bool isAttachedToRootImpl(
+      typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) const {
+    return true;
+  }
+
+  template <typename TNodeType>
+  bool isAttachedToRootImpl(typename std::enable_if<
+                            !std::is_void<typename TNodeType::ParentType>::value>::type* = 0) const {
+    return parent_ && parent_->isAttachedToRoot();
+  }
+
+  template <typename TNodeType>
+  void invalidateTreeAboveImpl(
+      typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {}
+
+  template <typename TNodeType>
+  void invalidateTreeAboveImpl(
+      typename std::enable_if<!std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
+    auto parentPtr = getParentPtr();
+    if(parentPtr) {
+      parentPtr->markDerivedInfoDirty();
+    }
+  }
+
+  /// @brief recompute the derived info of this node from its statements and children, if dirty
+  void updateDirtyLevel() {
+    if(!derivedInfoDirty_)
+      return;
+    ++NodeUpdateStatistics::getThreadLocal().NumClearDerivedInfo;
+    clearDerivedInfo();
+    static_cast<NodeType*>(this)->updateLevel();
+    ++NodeUpdateStatistics::getThreadLocal().NumUpdateFromChildren;
+    updateFromChildren();
+    derivedInfoDirty_ = false;
+  }
+
+  template <typename TChild>
+  void updateDirtyDerivedInfoImpl(typename std::enable_if<std::is_void<TChild>::value>::type* = 0) {
+    updateDirtyLevel();
+  }
+
+  template <typename TChild>
+  void
+  updateDirtyDerivedInfoImpl(typename std::enable_if<!std::is_void<TChild>::value>::type* = 0) {
+    for(const auto& child : children_) {
+      if(child->isDerivedInfoDirty())
+        child->updateDirtyDerivedInfo();
+    }
+    updateDirtyLevel();
+  }
+
   /// @brief fix the tree structure after the erase of a child
   inline void fixAfterErase() {
-    // since we have removed a child, the pointers of other siblings might have change,
-    // there we need to reset the parent pointer of grandchildren
-    for(auto& childIt_ : children_) {
-      childIt_->template setChildrenParent<typename Child::ChildSmartPtrType>();
-    }
     // recompute the derived info from the remaining children
     if(!children_.empty()) {
       updateFromChildrenRec<NodeType>();
@@ -479,23 +483,43 @@ private:
       if(!child->parentIsSet()) {
         return false;
       }
-      const auto& parent = child->getParent();
-
-      if(parent.get() != this) {
+      if(child->getParent() != this) {
+        return false;
+      }
+      if(!child->checkTreeConsistency()) {
         return false;
       }
-      return child->checkTreeConsistency();
     }
 
     return true;
   }
 
+  /// @brief set this node as the parent of a child node. The grandchildren keep pointing to the
+  /// child node, which does not move in memory, so there is nothing else to repair
+  template <typename TChild>
+  void linkChild(const SmartPtr<TChild>& child,
+                 typename std::enable_if<!std::is_void<TChild>::value>::type* = 0) {
+    child->setParent(static_cast<NodeType*>(this));
+  }
+
+  template <typename TChild>
+  void linkChild(const SmartPtr<TChild>& child,
+                 typename std::enable_if<std::is_void<TChild>::value>::type* = 0) {}
+
+  /// @brief link the children in [first, first + count) to this node and update the derived info
+  void repairTreeOfChildren(ChildIterator first, std::size_t count) {
+    for(; count > 0; --count, ++first)
+      linkChild<Child>(*first);
+
+    updateFromChildrenRec<NodeType>();
+  }
+
   template <typename TParent>
   void insertChildImpl(ChildSmartPtrType&& child,
                        typename std::enable_if<!std::is_void<TParent>::value>::type* = 0) {
     PROTECT_TEMPLATE(TParent, Parent)
     children_.push_back(std::move(child));
-    repairTreeOfChildren();
+    repairTreeOfChildren(std::prev(children_.end()), 1);
   }
 
   template <typename TParent>
@@ -505,7 +529,7 @@ private:
     PROTECT_TEMPLATE(TParent, Parent)
     auto it = children_.insert(pos, std::move(child));
 
-    repairTreeOfChildren();
+    repairTreeOfChildren(it, 1);
     return it;
   }
 
@@ -515,47 +539,27 @@ private:
                      typename std::enable_if<!std::is_void<TParent>::value>::type* = 0) {
     PROTECT_TEMPLATE(TParent, Parent)
 
+    const std::size_t count = std::distance(first, last);
     auto newfirst = children_.insert(pos, first, last);
 
-    repairTreeOfChildren();
+    repairTreeOfChildren(newfirst, count);
     return newfirst;
   }
 
-  void repairTreeOfChildren(const std::unique_ptr<NodeType>& p) {
-    for(const auto& sibling : children_) {
-      sibling->setParent(p);
-
-      if(!sibling->getChildren().empty()) {
-        const auto& lastSibling = sibling->getChildren().back();
-        sibling->template setChildParent<NodeType>(lastSibling);
-      }
-    }
-
-    updateFromChildrenRec<NodeType>();
-  }
-
-  void repairTreeOfChildren() {
-    // setting recursively the children parents is performed on all the siblings of a child,
-    // therefore
-    // here we only need to do it on one child
-    const auto& lastChild = children_.back();
-    setChildParent<Parent>(lastChild);
-
-    updateFromChildrenRec<NodeType>();
-  }
-
   template <typename TParent, typename Iterator, typename TChildParent>
   ChildIterator
   insertChildrenImpl(ChildIterator pos, Iterator first, Iterator last,
                      const std::unique_ptr<NodeType>& p,
                      typename std::enable_if<std::is_void<TParent>::value &&
                                              !std::is_void<TChildParent>::value>::type* = 0) {
+    DAWN_ASSERT(p.get() == this);
     PROTECT_TEMPLATE(TParent, Parent)
     PROTECT_TEMPLATE(TChildParent, NodeType)
 
+    const std::size_t count = std::distance(first, last);
     auto newfirst = children_.insert(pos, first, last);
 
-    repairTreeOfChildren(p);
+    repairTreeOfChildren(newfirst, count);
 
     return newfirst;
   }
@@ -569,7 +573,7 @@ private:
     PROTECT_TEMPLATE(TParent, Parent)
     children_.push_back(std::move(child));
 
-    repairTreeOfChildren(p);
+    repairTreeOfChildren(std::prev(children_.end()), 1);
   }
 
   template <typename TParent>
@@ -577,13 +581,10 @@ private:
                    typename std::enable_if<!std::is_void<TParent>::value>::type* = 0) {
     auto it = std::find(children_.begin(), children_.end(), inputChild);
     DAWN_ASSERT(it != children_.end());
-    const std::unique_ptr<NodeType>* ptr = &((*it)->getParent());
 
     (it)->swap(withNewChild);
-    inputChild->setParent(*ptr);
-    setChildParent<Parent, Child>(inputChild);
 
-    updateFromChildrenRec<NodeType>();
+    repairTreeOfChildren(it, 1);
   }
 
   /// @brief replace a child node by another node (specialization for nodes that do not have a
@@ -595,17 +596,13 @@ private:
   void replaceImpl(const SmartPtr<Child>& inputChild, SmartPtr<Child>& withNewChild,
                    const std::unique_ptr<NodeType>& thisNode,
                    typename std::enable_if<std::is_void<TParent>::value>::type* = 0) {
+    DAWN_ASSERT(thisNode.get() == this);
     auto it = std::find(children_.begin(), children_.end(), inputChild);
     DAWN_ASSERT(it != children_.end());
-    const std::unique_ptr<NodeType>* ptr = &((*it)->getParent());
 
     (it)->swap(withNewChild);
 
-    inputChild->setParent(*ptr);
-    inputChild
-        ->template setChildrenParent<typename getChildType<std::unique_ptr<Child>>::type::type>();
-
-    updateFromChildrenRec<NodeType>();
+    repairTreeOfChildren(it, 1);
   }
 
   /// @brief print the tree of pointers (for debugging)
@@ -615,7 +612,7 @@ private:
       if(child->parentIsSet())
         std::cout << "&child : " << &child << "  child.get() : " << child.get()
                   << " child->getParentP() : " << parent_
-                  << " parent.get() : " << child->getParent().get() << std::endl;
+                  << " parent.get() : " << child->getParent() << std::endl;
       else
         std::cout << "&child : " << &child << "  child.get() : " << child.get()
                   << " child->getParentP() : " << parent_ << " parent.get() : "
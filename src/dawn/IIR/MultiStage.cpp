@@ -361,8 +361,8 @@ boost::optional<Interval> MultiStage::getEnclosingAccessIntervalTemporaries() co
   return interval;
 }
 
-std::unordered_map<int, Field> MultiStage::computeFieldsOnTheFly() const {
-  std::unordered_map<int, Field> fields;
+FieldMap MultiStage::computeFieldsOnTheFly() const {
+  FieldMap fields;
 
   for(const auto& stagePtr : children_) {
     mergeFields(stagePtr->getFields(), fields, stagePtr->getExtents());
@@ -375,7 +375,7 @@ void MultiStage::DerivedInfo::clear() { fields_.clear(); }
 
 void MultiStage::clearDerivedInfo() { derivedInfo_.clear(); }
 
-const std::unordered_map<int, Field>& MultiStage::getFields() const { return derivedInfo_.fields_; }
+const FieldMap& MultiStage::getFields() const { return derivedInfo_.fields_; }
 
 void MultiStage::updateFromChildren() {
   for(const auto& stagePtr : children_) {
@@ -458,9 +458,8 @@ bool MultiStage::isEmptyOrNullStmt() const {
   return true;
 }
 
-std::unordered_map<int, Field>
-MultiStage::computeFieldsAtInterval(const iir::Interval& interval) const {
-  std::unordered_map<int, Field> fields;
+FieldMap MultiStage::computeFieldsAtInterval(const iir::Interval& interval) const {
+  FieldMap fields;
   for(const auto& stage : iterateIIROver<Stage>(*this)) {
     for(const auto& doMethod : stage->getChildren()) {
       if(!doMethod->getInterval().overlaps(interval))
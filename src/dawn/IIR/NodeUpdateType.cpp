@@ -3,6 +3,11 @@
 namespace dawn {
 namespace iir {
 
+NodeUpdateStatistics& NodeUpdateStatistics::getThreadLocal() {
+  static thread_local NodeUpdateStatistics statistics;
+  return statistics;
+}
+
 namespace impl {
 bool updateLevel(NodeUpdateType updateType) {
   return static_cast<int>(updateType) < 2 && static_cast<int>(updateType) > -2;
@@ -26,6 +26,23 @@ enum class NodeUpdateType : int {
   treeBelow = -2          // update only the tree below the node
 };
 
+/// @brief Number of derived info computations performed by the IIR nodes
+///
+/// The statistics are kept per thread and are used to profile the optimizer passes.
+struct NodeUpdateStatistics {
+  /// Number of calls to `clearDerivedInfo`
+  unsigned long NumClearDerivedInfo = 0;
+
+  /// Number of calls to `updateFromChildren`
+  unsigned long NumUpdateFromChildren = 0;
+
+  /// Number of derived info consistency checks of stencils (`Stencil::compareDerivedInfo`)
+  unsigned long NumCompareDerivedInfo = 0;
+
+  /// @brief Get the statistics of the calling thread
+  static NodeUpdateStatistics& getThreadLocal();
+};
+
 namespace impl {
 /// @brief return true if the current level needs to be updated
 bool updateLevel(NodeUpdateType updateType);
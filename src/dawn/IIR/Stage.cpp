@@ -147,7 +147,7 @@ bool Stage::overlaps(const Stage& other) const {
   return false;
 }
 
-bool Stage::overlaps(const Interval& interval, const std::unordered_map<int, Field>& fields) const {
+bool Stage::overlaps(const Interval& interval, const FieldMap& fields) const {
   for(const auto& doMethodPtr : getChildren()) {
     const Interval& thisInterval = doMethodPtr->getInterval();
 
@@ -324,8 +324,6 @@ Stage::split(std::deque<int>& splitterIndices,
 }
 
 void Stage::updateFromChildren() {
-  updateGlobalVariablesInfo();
-
   for(const auto& doMethod : children_) {
     mergeFields(doMethod->getFields(), derivedInfo_.fields_, boost::optional<Extents>());
   }
@@ -58,7 +58,7 @@ class Stage : public IIRNode<MultiStage, Stage, DoMethod> {
     void clear();
 
     /// Declaration of the fields of this stage
-    std::unordered_map<int, Field> fields_;
+    FieldMap fields_;
 
     /// AccessIDs of the global variable accesses of this stage
     std::unordered_set<int> allGlobalVariables_;
@@ -136,7 +136,7 @@ public:
   ///
   /// @{
   bool overlaps(const Stage& other) const;
-  bool overlaps(const Interval& interval, const std::unordered_map<int, Field>& fields) const;
+  bool overlaps(const Interval& interval, const FieldMap& fields) const;
   /// @}
 
   /// @brief Get the maximal vertical extent of this stage
@@ -150,7 +150,7 @@ public:
   /// `Input`
   ///
   /// The fields are computed during `Stage::update`.
-  const std::unordered_map<int, Field>& getFields() const { return derivedInfo_.fields_; }
+  const FieldMap& getFields() const { return derivedInfo_.fields_; }
 
   /// @brief Update the fields and global variables
   ///
@@ -162,7 +162,7 @@ bool StatementAccessesPair::hasCalleeAccesses() { return calleeAccesses_ != null
 
 json::json StatementAccessesPair::print(const StencilMetaInformation& metadata,
                                         const AccessToNameMapper& accessToNameMapper,
-                                        const std::unordered_map<int, Extents>& accesses) const {
+                                        const AccessMap& accesses) const {
   json::json node;
   for(const auto& accessPair : accesses) {
     json::json accessNode;
@@ -102,7 +102,7 @@ public:
   json::json jsonDump(const StencilMetaInformation& metadata) const;
   json::json print(const StencilMetaInformation& metadata,
                    const AccessToNameMapper& accessToNameMapper,
-                   const std::unordered_map<int, Extents>& accesses) const;
+                   const AccessMap& accesses) const;
 };
 
 } // namespace iir
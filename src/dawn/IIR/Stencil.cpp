@@ -119,12 +119,13 @@ bool Stencil::containsRedundantComputations() const {
 
 void Stencil::updateFromChildren() {
   derivedInfo_.fields_.clear();
-  std::unordered_map<int, Field> fields;
+  FieldMap fields;
 
   for(const auto& MSPtr : children_) {
     mergeFields(MSPtr->getFields(), fields);
   }
 
+  derivedInfo_.fields_.reserve(fields.size());
   for(const auto& fieldPair : fields) {
     const int accessID = fieldPair.first;
     const Field& field = fieldPair.second;
@@ -133,8 +134,8 @@ void Stencil::updateFromChildren() {
     bool isTemporary = metadata_.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, accessID);
     Array3i specifiedDimension = metadata_.getFieldDimensionsMask(accessID);
 
-    derivedInfo_.fields_.emplace(
-        std::make_pair(accessID, FieldInfo{isTemporary, name, specifiedDimension, field}));
+    derivedInfo_.fields_.emplace(accessID,
+                                 FieldInfo{isTemporary, name, specifiedDimension, field});
   }
 }
 
@@ -250,8 +251,8 @@ void Stencil::updateFieldsImpl(int startStageIdx, int endStageIdx) {
   }
 }
 
-std::unordered_map<int, Field> Stencil::computeFieldsOnTheFly() const {
-  std::unordered_map<int, Field> fields;
+FieldMap Stencil::computeFieldsOnTheFly() const {
+  FieldMap fields;
 
   for(const auto& mssPtr : children_) {
     for(const auto& fieldPair : mssPtr->computeFieldsOnTheFly()) {
@@ -492,7 +493,7 @@ Stencil::Lifetime Stencil::getLifetime(const int AccessID) const {
         for(const auto& stmtAccessPair : doMethod.getChildren()) {
           const Accesses& accesses = *stmtAccessPair->getAccesses();
 
-          auto processAccessMap = [&](const std::unordered_map<int, Extents>& accessMap) {
+          auto processAccessMap = [&](const AccessMap& accessMap) {
             if(!accessMap.count(AccessID))
               return;
 
@@ -59,12 +59,15 @@ public:
     json::json jsonDump() const;
   };
 
+  /// Field infos indexed by their AccessID
+  using FieldInfoMap = SmallIntMap<FieldInfo>;
+
 private:
   struct DerivedInfo {
     /// Dependency graph of the stages of this stencil
     std::shared_ptr<DependencyGraphStage> stageDependencyGraph_;
     /// field info properties
-    std::unordered_map<int, FieldInfo> fields_;
+    FieldInfoMap fields_;
 
     void clear();
   };
@@ -290,9 +293,9 @@ public:
   void accept(ASTVisitor& visitor);
 
   /// @brief Get the pair <AccessID, field> for the fields used within the multi-stage
-  const std::unordered_map<int, FieldInfo>& getFields() const { return derivedInfo_.fields_; }
+  const FieldInfoMap& getFields() const { return derivedInfo_.fields_; }
 
-  std::unordered_map<int, Field> computeFieldsOnTheFly() const;
+  FieldMap computeFieldsOnTheFly() const;
 
   /// @brief update the derived info from children
   virtual void updateFromChildren() override;
@@ -438,9 +438,9 @@ void StencilFunctionInstantiation::update() {
   //        +----------> | InputOutput | <----------+
   //                     +-------------+
   //
-  std::unordered_map<int, Field> inputOutputFields;
-  std::unordered_map<int, Field> inputFields;
-  std::unordered_map<int, Field> outputFields;
+  FieldMap inputOutputFields;
+  FieldMap inputFields;
+  FieldMap outputFields;
 
   for(const auto& statementAccessesPair : doMethod_->getChildren()) {
     auto access = statementAccessesPair->getAccesses();
@@ -48,7 +48,8 @@ namespace iir {
 //===------------------------------------------------------------------------------------------===//
 
 StencilInstantiation::StencilInstantiation(dawn::OptimizerContext* context)
-    : context_(context), metadata_(*(context->getSIR()->GlobalVariableMap)),
+    : context_(context), astArena_(make_unique<Arena>()),
+      metadata_(*(context->getSIR()->GlobalVariableMap)),
       IIR_(make_unique<IIR>(*(context->getSIR()->GlobalVariableMap),
                             context->getSIR()->StencilFunctions)) {}
 
@@ -59,6 +60,7 @@ std::shared_ptr<StencilInstantiation> StencilInstantiation::clone() const {
   std::shared_ptr<StencilInstantiation> stencilInstantiation =
       std::make_shared<StencilInstantiation>(context_);
 
+  ArenaScope astArenaScope(stencilInstantiation->astArena_.get());
   stencilInstantiation->metadata_.clone(metadata_);
 
   stencilInstantiation->IIR_ =
@@ -21,6 +21,7 @@
 #include "dawn/IIR/StencilFunctionInstantiation.h"
 #include "dawn/IIR/StencilMetaInformation.h"
 #include "dawn/SIR/SIR.h"
+#include "dawn/Support/Arena.h"
 #include "dawn/Support/NonCopyable.h"
 #include "dawn/Support/StringRef.h"
 #include "dawn/Support/UIDGenerator.h"
@@ -41,6 +42,11 @@ enum class TemporaryScope { TS_LocalVariable, TS_StencilTemporary, TS_Field };
 class StencilInstantiation : NonCopyable {
 
   OptimizerContext* context_;
+
+  /// Arena of the AST nodes cloned while optimizing this instantiation (see `makeArenaShared`),
+  /// declared before the members holding these nodes to outlive them
+  std::unique_ptr<Arena> astArena_;
+
   StencilMetaInformation metadata_;
   std::unique_ptr<IIR> IIR_;
 
@@ -53,6 +59,13 @@ public:
 
   std::shared_ptr<StencilInstantiation> clone() const;
 
+  /// @brief Get the arena of the AST nodes of this instantiation
+  ///
+  /// The optimizer passes run with this arena active (`ArenaScope`), hence the AST nodes they clone
+  /// are bump allocated and the nodes replaced by the passes return their memory to the arena. The
+  /// nodes must not outlive the instantiation.
+  Arena* getASTArena() const { return astArena_.get(); }
+
   bool checkTreeConsistency() const;
 
   /// @brief Get the name of the StencilInstantiation (corresponds to the name of the SIRStencil)
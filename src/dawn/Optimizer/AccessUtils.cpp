@@ -4,9 +4,8 @@ namespace dawn {
 
 namespace AccessUtils {
 
-void recordWriteAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
-                       std::unordered_map<int, iir::Field>& inputFields,
-                       std::unordered_map<int, iir::Field>& outputFields, int AccessID,
+void recordWriteAccess(iir::FieldMap& inputOutputFields, iir::FieldMap& inputFields,
+                       iir::FieldMap& outputFields, int AccessID,
                        const boost::optional<iir::Extents>& writeExtents,
                        iir::Interval const& doMethodInterval) {
   // Field was recorded as `InputOutput`, state can't change ...
@@ -35,9 +34,8 @@ void recordWriteAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
   }
 }
 
-void recordReadAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
-                      std::unordered_map<int, iir::Field>& inputFields,
-                      std::unordered_map<int, iir::Field>& outputFields, int AccessID,
+void recordReadAccess(iir::FieldMap& inputOutputFields, iir::FieldMap& inputFields,
+                      iir::FieldMap& outputFields, int AccessID,
                       boost::optional<iir::Extents> const& readExtents,
                       const iir::Interval& doMethodInterval) {
 
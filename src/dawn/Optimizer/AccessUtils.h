@@ -19,7 +19,6 @@
 
 #include "dawn/IIR/Accesses.h"
 #include "dawn/IIR/Field.h"
-#include <unordered_map>
 
 namespace dawn {
 namespace AccessUtils {
@@ -29,9 +28,8 @@ namespace AccessUtils {
 /// depending on previous accesses to the same field
 ///
 /// @ingroup optimizer
-void recordWriteAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
-                       std::unordered_map<int, iir::Field>& inputFields,
-                       std::unordered_map<int, iir::Field>& outputFields, int AccessID,
+void recordWriteAccess(iir::FieldMap& inputOutputFields, iir::FieldMap& inputFields,
+                       iir::FieldMap& outputFields, int AccessID,
                        const boost::optional<iir::Extents>& extents,
                        iir::Interval const& doMethodInterval);
 
@@ -40,9 +38,8 @@ void recordWriteAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
 /// depending on previous accesses to the same field
 ///
 /// @ingroup optimizer
-void recordReadAccess(std::unordered_map<int, iir::Field>& inputOutputFields,
-                      std::unordered_map<int, iir::Field>& inputFields,
-                      std::unordered_map<int, iir::Field>& outputFields, int AccessID,
+void recordReadAccess(iir::FieldMap& inputOutputFields, iir::FieldMap& inputFields,
+                      iir::FieldMap& outputFields, int AccessID,
                       const boost::optional<iir::Extents>& extents,
                       iir::Interval const& doMethodInterval);
 
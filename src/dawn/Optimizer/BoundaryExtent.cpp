@@ -77,7 +77,7 @@ computeBoundaryExtents(const iir::DependencyGraphAccesses* graph) {
         visitedNodes.insert(curNode);
 
       // Follow edges of the current node and update the node extents
-      for(const Edge& edge : *adjacencyList[curNode]) {
+      for(const Edge& edge : adjacencyList[curNode]) {
         nodeExtents.at(edge.ToVertexID).merge(iir::Extents::add(curExtent, edge.Data));
         nodesToVisit.push_back(edge.ToVertexID);
       }
@@ -571,6 +571,9 @@ OptimizerContext::OptimizerContext(DiagnosticsEngine& diagnostics, Options& opti
     : diagnostics_(diagnostics), options_(options), SIR_(SIR) {
   DAWN_LOG(INFO) << "Intializing OptimizerContext ... ";
 
+  if(!options_.ProfilePasses.empty())
+    passProfiler_ = make_unique<PassProfiler>();
+
   for(const auto& stencil : SIR_->Stencils)
     if(!stencil->Attributes.has(sir::Attr::AK_NoCodeGen)) {
       stencilInstantiationMap_.insert(
@@ -586,6 +589,7 @@ bool OptimizerContext::fillIIRFromSIR(
     const std::shared_ptr<sir::Stencil> SIRStencil, const std::shared_ptr<SIR> fullSIR) {
   DAWN_LOG(INFO) << "Intializing StencilInstantiation of `" << SIRStencil->Name << "`";
   DAWN_ASSERT_MSG(SIRStencil, "Stencil does not exist");
+  ArenaScope astArenaScope(stencilInstantation->getASTArena());
   auto& metadata = stencilInstantation->getMetaData();
   metadata.setStencilname(SIRStencil->Name);
   metadata.setFileName(fullSIR->Filename);
@@ -616,22 +620,19 @@ bool OptimizerContext::fillIIRFromSIR(
     stencilInstantation->reportAccesses();
   }
 
-  for(const auto& MS : iterateIIROver<MultiStage>(*(stencilInstantation->getIIR()))) {
-    MS->update(NodeUpdateType::levelAndTreeAbove);
-  }
   DAWN_LOG(INFO) << "Done initializing StencilInstantiation";
 
-  // Iterate all statements (top -> bottom)
+  // Iterate all statements (top -> bottom); the multi-stages and stencils above the stages are
+  // recomputed once at the end
   for(const auto& stagePtr : iterateIIROver<iir::Stage>(*(stencilInstantation->getIIR()))) {
     iir::Stage& stage = *stagePtr;
     for(const auto& doMethod : stage.getChildren()) {
       doMethod->update(iir::NodeUpdateType::level);
     }
     stage.update(iir::NodeUpdateType::level);
+    stage.invalidateTreeAbove();
   }
-  for(const auto& MSPtr : iterateIIROver<iir::Stage>(*(stencilInstantation->getIIR()))) {
-    MSPtr->update(iir::NodeUpdateType::levelAndTreeAbove);
-  }
+  stencilInstantation->getIIR()->updateDirtyDerivedInfo();
 
   return true;
 }
@@ -646,9 +647,27 @@ OptimizerContext::getStencilInstantiationMap() const {
   return stencilInstantiationMap_;
 }
 
-const DiagnosticsEngine& OptimizerContext::getDiagnostics() const { return diagnostics_; }
+namespace {
+
+/// Diagnostics engine of the innermost `DiagnosticsScope` of the current thread (may be NULL)
+thread_local DiagnosticsEngine* scopedDiagnostics = nullptr;
+
+} // anonymous namespace
+
+const DiagnosticsEngine& OptimizerContext::getDiagnostics() const {
+  return scopedDiagnostics ? *scopedDiagnostics : diagnostics_;
+}
+
+DiagnosticsEngine& OptimizerContext::getDiagnostics() {
+  return scopedDiagnostics ? *scopedDiagnostics : diagnostics_;
+}
+
+OptimizerContext::DiagnosticsScope::DiagnosticsScope(DiagnosticsEngine& diagnostics)
+    : parent_(scopedDiagnostics) {
+  scopedDiagnostics = &diagnostics;
+}
 
-DiagnosticsEngine& OptimizerContext::getDiagnostics() { return diagnostics_; }
+OptimizerContext::DiagnosticsScope::~DiagnosticsScope() { scopedDiagnostics = parent_; }
 
 const Options& OptimizerContext::getOptions() const { return options_; }
 
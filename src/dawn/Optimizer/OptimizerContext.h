@@ -18,6 +18,7 @@
 #include "dawn/Compiler/DiagnosticsEngine.h"
 #include "dawn/Compiler/Options.h"
 #include "dawn/Optimizer/PassManager.h"
+#include "dawn/Optimizer/PassProfiler.h"
 #include "dawn/Support/NonCopyable.h"
 #include <map>
 #include <memory>
@@ -40,6 +41,15 @@ struct HardwareConfig {
 
   /// Maximum number of fields concurrently in the texture cache
   int TexCacheMaxFields = 3;
+
+  /// Main memory bandwidth in GB/s
+  double Bandwidth = 100;
+
+  /// Peak floating point performance in GFlop/s
+  double PeakFlops = 1000;
+
+  /// Size of the last level cache in KiB
+  int CacheSize = 1024;
 };
 
 /// @brief Context of handling all Optimizations
@@ -53,6 +63,7 @@ class OptimizerContext : NonCopyable {
   std::map<std::string, std::shared_ptr<iir::StencilInstantiation>> stencilInstantiationMap_;
   PassManager passManager_;
   HardwareConfig hardwareConfiguration_;
+  std::unique_ptr<PassProfiler> passProfiler_;
 
 public:
   /// @brief Initialize the context with a SIR
@@ -71,6 +82,10 @@ public:
   PassManager& getPassManager() { return passManager_; }
   const PassManager& getPassManager() const { return passManager_; }
 
+  /// @brief Get the pass profiler (`NULL` if the passes are not profiled)
+  PassProfiler* getPassProfiler() { return passProfiler_.get(); }
+  const PassProfiler* getPassProfiler() const { return passProfiler_.get(); }
+
   /// @brief Get the SIR
   const std::shared_ptr<SIR>& getSIR() const { return SIR_; }
 
@@ -79,9 +94,24 @@ public:
   Options& getOptions();
 
   /// @brief Get the diagnostics engine
+  ///
+  /// If a `DiagnosticsScope` is active on the calling thread, its engine is returned instead.
   const DiagnosticsEngine& getDiagnostics() const;
   DiagnosticsEngine& getDiagnostics();
 
+  /// @brief Redirect the diagnostics obtained via `getDiagnostics` on the current thread to
+  /// `diagnostics` for the lifetime of the scope
+  ///
+  /// This is used to gather the diagnostics of stencil instantiations which are optimized
+  /// concurrently, such that they can be merged in a deterministic order afterwards.
+  class DiagnosticsScope : NonCopyable {
+    DiagnosticsEngine* parent_;
+
+  public:
+    DiagnosticsScope(DiagnosticsEngine& diagnostics);
+    ~DiagnosticsScope();
+  };
+
   /// @brief Get the hardware configuration
   const HardwareConfig& getHardwareConfiguration() const { return hardwareConfiguration_; }
   HardwareConfig& getHardwareConfiguration() { return hardwareConfiguration_; }
@@ -89,9 +119,15 @@ public:
   /// @brief Create a new pass at the end of the pass list
   template <class T, typename... Args>
   void checkAndPushBack(Args&&... args) {
+    checkAndPushBackTo<T>(passManager_, std::forward<Args>(args)...);
+  }
+
+  /// @brief Create a new pass at the end of the pass list of `passManager`
+  template <class T, typename... Args>
+  void checkAndPushBackTo(PassManager& passManager, Args&&... args) {
     std::unique_ptr<T> pass = make_unique<T>(std::forward<Args>(args)...);
     if(compareOptionsToPassFlags<T>(pass)) {
-      passManager_.getPasses().push_back(std::move(pass));
+      passManager.getPasses().push_back(std::move(pass));
     }
   }
 
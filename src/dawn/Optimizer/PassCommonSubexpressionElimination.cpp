@@ -0,0 +1,375 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PassCommonSubexpressionElimination.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/InstantiationHelper.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/AccessComputation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTStringifier.h"
+#include "dawn/SIR/ASTUtil.h"
+#include "dawn/Support/Casting.h"
+#include "dawn/Support/STLExtras.h"
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+/// @brief All occurrences of a pure subexpression in a Do-Method
+struct Candidate {
+  /// Number of AST nodes of the expression
+  int Size = 0;
+
+  /// Position of the first occurrence in the post-order traversal (used to break ties)
+  int Order = 0;
+
+  /// Index of the statement in the Do-Method and the expression of each occurrence
+  std::vector<std::pair<std::size_t, std::shared_ptr<Expr>>> Occurrences;
+};
+
+/// @brief Key identifying the value of an expression
+struct ExprKey {
+  std::string Key;
+  int Size = 1;
+  bool IsPure = true;
+  bool HasAccess = false;
+};
+
+/// @brief Computes the keys of the expressions of a statement and records its pure compound
+/// subexpressions as candidates
+///
+/// Field and variable accesses are keyed by their AccessID (and offset) together with the number
+/// of writes to the AccessID preceding the statement, hence two expressions have the same key if
+/// and only if they compute the same value.
+class CandidateCollector {
+  const iir::StencilMetaInformation& metadata_;
+  const std::unordered_map<int, int>& versions_;
+  std::unordered_map<std::string, Candidate>& candidates_;
+  std::size_t stmtIndex_;
+  int& order_;
+
+public:
+  CandidateCollector(const iir::StencilMetaInformation& metadata,
+                     const std::unordered_map<int, int>& versions,
+                     std::unordered_map<std::string, Candidate>& candidates, std::size_t stmtIndex,
+                     int& order)
+      : metadata_(metadata), versions_(versions), candidates_(candidates), stmtIndex_(stmtIndex),
+        order_(order) {}
+
+  ExprKey collect(const std::shared_ptr<Expr>& expr) {
+    ExprKey key;
+    switch(expr->getKind()) {
+    case Expr::EK_FieldAccessExpr: {
+      const FieldAccessExpr& field = *static_cast<FieldAccessExpr*>(expr.get());
+      if(field.hasArguments()) {
+        key.IsPure = false;
+        break;
+      }
+      const Array3i& offset = field.getOffset();
+      int sign = field.negateOffset() ? -1 : 1;
+      key.Key = "f" + accessKey(metadata_.getAccessIDFromExpr(expr)) + "[" +
+                std::to_string(sign * offset[0]) + "," + std::to_string(sign * offset[1]) + "," +
+                std::to_string(sign * offset[2]) + "]";
+      key.HasAccess = true;
+      break;
+    }
+    case Expr::EK_VarAccessExpr: {
+      if(static_cast<VarAccessExpr*>(expr.get())->isArrayAccess()) {
+        key.IsPure = false;
+        break;
+      }
+      key.Key = "v" + accessKey(metadata_.getAccessIDFromExpr(expr));
+      key.HasAccess = true;
+      break;
+    }
+    case Expr::EK_LiteralAccessExpr: {
+      const LiteralAccessExpr& literal = *static_cast<LiteralAccessExpr*>(expr.get());
+      key.Key = "l" + std::to_string(static_cast<int>(literal.getBuiltinType())) + ":" +
+                literal.getValue();
+      break;
+    }
+    case Expr::EK_UnaryOperator: {
+      const UnaryOperator& op = *static_cast<UnaryOperator*>(expr.get());
+      key.Key = std::string(op.getOp()) + "(" + append(key, collect(op.getOperand())) + ")";
+      break;
+    }
+    case Expr::EK_BinaryOperator: {
+      const BinaryOperator& op = *static_cast<BinaryOperator*>(expr.get());
+      std::string left = append(key, collect(op.getLeft()));
+      std::string right = append(key, collect(op.getRight()));
+
+      // Addition and multiplication are commutative (also in floating point arithmetic)
+      std::string opStr = op.getOp();
+      if((opStr == "+" || opStr == "*") && right < left)
+        std::swap(left, right);
+      key.Key = "(" + left + opStr + right + ")";
+      break;
+    }
+    case Expr::EK_TernaryOperator: {
+      const TernaryOperator& op = *static_cast<TernaryOperator*>(expr.get());
+      std::string cond = append(key, collect(op.getCondition()));
+      std::string left = append(key, collect(op.getLeft()));
+      std::string right = append(key, collect(op.getRight()));
+      key.Key = "(" + cond + "?" + left + ":" + right + ")";
+      break;
+    }
+    case Expr::EK_FunCallExpr: {
+      const FunCallExpr& call = *static_cast<FunCallExpr*>(expr.get());
+      key.IsPure = isPureMathFunction(call.getCallee());
+      key.Key = call.getCallee() + "(";
+      for(const auto& arg : call.getArguments())
+        key.Key += append(key, collect(arg)) + ",";
+      key.Key += ")";
+      break;
+    }
+    default:
+      // Assignments and stencil function calls are never reused, but their arguments may be
+      key.IsPure = false;
+      for(const auto& child : expr->getChildren())
+        collect(child);
+      break;
+    }
+
+    // Only compound expressions which access memory are worth a local variable
+    if(key.IsPure && key.HasAccess && key.Size > 1) {
+      Candidate& candidate = candidates_[key.Key];
+      if(candidate.Occurrences.empty()) {
+        candidate.Size = key.Size;
+        candidate.Order = order_++;
+      }
+      candidate.Occurrences.emplace_back(stmtIndex_, expr);
+    }
+    return key;
+  }
+
+private:
+  /// @brief Check if `callee` is a function of the math library, whose result only depends on its
+  /// arguments
+  ///
+  /// The namespace of the callee is ignored (e.g `std::sqrt` or `gridtools::clang::math::sqrt`).
+  /// Calls of any other function may have side-effects and are never reused.
+  static bool isPureMathFunction(const std::string& callee) {
+    static const std::unordered_set<std::string> pureMathFunctions{
+        "abs",   "fabs",  "min",   "max",   "fmin",  "fmax",  "sqrt",     "cbrt",
+        "exp",   "exp2",  "expm1", "log",   "log2",  "log10", "log1p",    "pow",
+        "sin",   "cos",   "tan",   "asin",  "acos",  "atan",  "atan2",    "sinh",
+        "cosh",  "tanh",  "asinh", "acosh", "atanh", "floor", "ceil",     "trunc",
+        "round", "fmod",  "hypot", "erf",   "erfc",  "fma",   "copysign", "tgamma"};
+    std::size_t namespaceEnd = callee.rfind("::");
+    return pureMathFunctions.count(
+        namespaceEnd == std::string::npos ? callee : callee.substr(namespaceEnd + 2));
+  }
+
+  std::string accessKey(int AccessID) const {
+    auto it = versions_.find(AccessID);
+    return std::to_string(AccessID) + "." + std::to_string(it != versions_.end() ? it->second : 0);
+  }
+
+  /// @brief Account for the operand `child` of `key` and return the key of the operand
+  static const std::string& append(ExprKey& key, const ExprKey& child) {
+    key.Size += child.Size;
+    key.IsPure &= child.IsPure;
+    key.HasAccess |= child.HasAccess;
+    return child.Key;
+  }
+};
+
+/// @brief Check if `expr` contains an assignment
+bool hasAssignment(const std::shared_ptr<Expr>& expr) {
+  if(isa<AssignmentExpr>(expr.get()))
+    return true;
+  for(const auto& child : expr->getChildren())
+    if(hasAssignment(child))
+      return true;
+  return false;
+}
+
+/// @brief Get the expressions of `stmt` whose value may be reused
+///
+/// Only the right-hand side of top-level assignments and the initializer of scalar variable
+/// declarations are considered. Statements containing control flow or nested assignments are
+/// skipped.
+std::vector<std::shared_ptr<Expr>> getValueExprs(const std::shared_ptr<Stmt>& stmt) {
+  if(ExprStmt* exprStmt = dyn_cast<ExprStmt>(stmt.get())) {
+    std::shared_ptr<Expr> expr = exprStmt->getExpr();
+    if(AssignmentExpr* assignment = dyn_cast<AssignmentExpr>(expr.get()))
+      expr = assignment->getRight();
+    if(!hasAssignment(expr))
+      return {expr};
+  } else if(VarDeclStmt* varDecl = dyn_cast<VarDeclStmt>(stmt.get())) {
+    if(!varDecl->isArray() && varDecl->hasInit() && !hasAssignment(varDecl->getInitList().front()))
+      return {varDecl->getInitList().front()};
+  }
+  return {};
+}
+
+/// @brief Check if `expr` or one of its subexpressions is in `replacedExprs`
+bool overlaps(const std::shared_ptr<Expr>& expr,
+              const std::unordered_set<const Expr*>& replacedExprs) {
+  if(replacedExprs.count(expr.get()))
+    return true;
+  for(const auto& child : expr->getChildren())
+    if(overlaps(child, replacedExprs))
+      return true;
+  return false;
+}
+
+/// @brief Add `expr` and its subexpressions to `replacedExprs`
+void insertReplaced(const std::shared_ptr<Expr>& expr,
+                    std::unordered_set<const Expr*>& replacedExprs) {
+  replacedExprs.insert(expr.get());
+  for(const auto& child : expr->getChildren())
+    insertReplaced(child, replacedExprs);
+}
+
+/// @brief Replace the common subexpressions of `doMethod` by local variables
+///
+/// The candidates are collected once and replaced in the order of their savings. Candidates
+/// overlapping an already replaced subexpression are left to the next sweep, which sees the
+/// updated statements.
+///
+/// @returns the number of eliminated subexpressions
+int eliminateCommonSubexpressions(iir::StencilInstantiation& instantiation,
+                                  iir::DoMethod& doMethod, bool report) {
+  iir::StencilMetaInformation& metadata = instantiation.getMetaData();
+
+  // Number of writes to each AccessID before the current statement
+  std::unordered_map<int, int> versions;
+  std::unordered_map<std::string, Candidate> candidates;
+  int order = 0;
+
+  const auto& stmtAccessesPairs = doMethod.getChildren();
+  for(std::size_t stmtIndex = 0; stmtIndex < stmtAccessesPairs.size(); ++stmtIndex) {
+    const auto& stmtAccessesPair = stmtAccessesPairs[stmtIndex];
+    CandidateCollector collector(metadata, versions, candidates, stmtIndex, order);
+    for(const auto& expr : getValueExprs(stmtAccessesPair->getStatement()->ASTStmt))
+      collector.collect(expr);
+
+    for(const auto& accessPair : stmtAccessesPair->getAccesses()->getWriteAccesses())
+      versions[accessPair.first]++;
+  }
+
+  // Replace the expressions saving the most nodes first
+  std::vector<const Candidate*> sortedCandidates;
+  for(const auto& candidatePair : candidates)
+    if(candidatePair.second.Occurrences.size() >= 2)
+      sortedCandidates.push_back(&candidatePair.second);
+
+  auto savings = [](const Candidate* c) { return (c->Occurrences.size() - 1) * c->Size; };
+  std::sort(sortedCandidates.begin(), sortedCandidates.end(),
+            [&](const Candidate* a, const Candidate* b) {
+              return savings(a) > savings(b) || (savings(a) == savings(b) && a->Order < b->Order);
+            });
+
+  std::unordered_set<const Expr*> replacedExprs;
+  using NewStmt = std::pair<std::size_t, std::unique_ptr<iir::StatementAccessesPair>>;
+  std::vector<NewStmt> newStmts;
+  for(const Candidate* candidate : sortedCandidates) {
+    if(std::any_of(candidate->Occurrences.begin(), candidate->Occurrences.end(),
+                   [&](const std::pair<std::size_t, std::shared_ptr<Expr>>& occurrence) {
+                     return overlaps(occurrence.second, replacedExprs);
+                   }))
+      continue;
+
+    // The value is computed by the first occurrence, right before its statement (none of the
+    // operands are modified in between)
+    std::size_t firstStmtIndex = candidate->Occurrences.front().first;
+    const std::shared_ptr<Expr>& valueExpr = candidate->Occurrences.front().second;
+
+    int AccessID = instantiation.nextUID();
+    std::string varname = iir::InstantiationHelper::makeLocalVariablename("cse", AccessID);
+    auto varDeclStmt =
+        std::make_shared<VarDeclStmt>(Type(BuiltinTypeID::Auto, CVQualifier::Const), varname, 0,
+                                      "=", std::vector<std::shared_ptr<Expr>>{valueExpr});
+
+    if(report)
+      std::cout << "\nPASS: PassCommonSubexpressionElimination: " << instantiation.getName()
+                << ": " << varname << " = " << ASTStringifer::toString(valueExpr) << " ("
+                << candidate->Occurrences.size() << " occurrences)\n";
+
+    metadata.insertAccessOfType(iir::FieldAccessType::FAT_LocalVariable, AccessID, varname);
+    metadata.insertStmtToAccessID(varDeclStmt, AccessID);
+
+    for(const auto& occurrence : candidate->Occurrences) {
+      insertReplaced(occurrence.second, replacedExprs);
+      auto varAccessExpr = std::make_shared<VarAccessExpr>(varname);
+      metadata.insertExprToAccessID(varAccessExpr, AccessID);
+      replaceOldExprWithNewExprInStmt(
+          stmtAccessesPairs[occurrence.first]->getStatement()->ASTStmt, occurrence.second,
+          varAccessExpr);
+    }
+
+    auto newStmtAccessesPair = make_unique<iir::StatementAccessesPair>(std::make_shared<Statement>(
+        varDeclStmt, stmtAccessesPairs[firstStmtIndex]->getStatement()->StackTrace));
+    computeAccesses(&instantiation, newStmtAccessesPair);
+    newStmts.emplace_back(firstStmtIndex, std::move(newStmtAccessesPair));
+  }
+
+  // Inserting the statements updates the tree above, hence their accesses need to be known. They
+  // are inserted from the back to keep the indices of the statements valid.
+  std::stable_sort(newStmts.begin(), newStmts.end(),
+                   [](const NewStmt& a, const NewStmt& b) { return a.first < b.first; });
+  for(auto it = newStmts.rbegin(); it != newStmts.rend(); ++it)
+    doMethod.insertChild(doMethod.childrenBegin() + it->first, std::move(it->second));
+  return newStmts.size();
+}
+
+} // anonymous namespace
+
+PassCommonSubexpressionElimination::PassCommonSubexpressionElimination()
+    : Pass("PassCommonSubexpressionElimination") {}
+
+bool PassCommonSubexpressionElimination::run(
+    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+  OptimizerContext* context = stencilInstantiation->getOptimizerContext();
+  if(!context->getOptions().CSE)
+    return true;
+
+  bool report = context->getOptions().ReportPassCSE;
+  int numEliminated = 0;
+
+  for(const auto& doMethodPtr : iterateIIROver<iir::DoMethod>(*(stencilInstantiation->getIIR()))) {
+    iir::DoMethod& doMethod = *doMethodPtr;
+
+    int numEliminatedInDoMethod = 0;
+    while(int numEliminatedInSweep =
+              eliminateCommonSubexpressions(*stencilInstantiation, doMethod, report))
+      numEliminatedInDoMethod += numEliminatedInSweep;
+
+    if(numEliminatedInDoMethod) {
+      // The replaced subexpressions changed the reads of the statements
+      computeAccesses(stencilInstantiation.get(), doMethod.getChildren());
+      doMethod.markDerivedInfoDirty();
+      numEliminated += numEliminatedInDoMethod;
+    }
+  }
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
+
+  if(report && numEliminated == 0)
+    std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName()
+              << ": no common subexpressions\n";
+  return true;
+}
+
+} // namespace dawn
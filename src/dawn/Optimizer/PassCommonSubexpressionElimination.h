@@ -0,0 +1,49 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PASSCOMMONSUBEXPRESSIONELIMINATION_H
+#define DAWN_OPTIMIZER_PASSCOMMONSUBEXPRESSIONELIMINATION_H
+
+#include "dawn/Optimizer/Pass.h"
+
+namespace dawn {
+
+/// @brief Pass to eliminate common subexpressions within each Do-Method
+/// @ingroup optimizer
+///
+/// Pure subexpressions (arithmetic on fields, variables and literals as well as math function
+/// calls) which are computed more than once in the straight-line code of a Do-Method, without any
+/// of their operands being written in between, are computed once into a local variable:
+///
+/// @code
+///   out1 = (in[i+1] - in[i-1]) * a;         const auto __local_cse_42 = in[i+1] - in[i-1];
+///   out2 = (in[i+1] - in[i-1]) * b;   =>    out1 = __local_cse_42 * a;
+///                                           out2 = __local_cse_42 * b;
+/// @endcode
+///
+/// Field accesses are identified by their AccessID and offset. Statements with control flow are
+/// left untouched and end the reuse of the expressions they might modify.
+///
+/// This pass is not necessary to create legal code and is hence not in the debug-group
+class PassCommonSubexpressionElimination : public Pass {
+public:
+  PassCommonSubexpressionElimination();
+
+  /// @brief Pass implementation
+  bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+};
+
+} // namespace dawn
+
+#endif
@@ -18,6 +18,8 @@
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/STLExtras.h"
+#include <unordered_map>
+#include <vector>
 
 namespace dawn {
 
@@ -30,19 +32,47 @@ bool PassComputeStageExtents::run(
   for(const auto& stencilPtr : stencilInstantiation->getStencils()) {
     iir::Stencil& stencil = *stencilPtr;
 
-    int numStages = stencil.getNumStages();
+    std::vector<iir::Stage*> stages;
+    for(const auto& multiStage : stencil.getChildren())
+      for(const auto& stage : multiStage->getChildren())
+        stages.push_back(stage.get());
 
-    // backward loop over stages
-    for(int i = numStages - 1; i >= 0; --i) {
-      iir::Stage& fromStage = *(stencil.getStage(i));
+    // Extents of the accesses to each field in the stages after the current one, expanded by the
+    // extents of the accessing stage
+    std::unordered_map<int, iir::Extents> accessExtents;
 
-      iir::Extents const& stageExtent = fromStage.getExtents();
+    // backward loop over stages
+    for(auto stageIt = stages.rbegin(); stageIt != stages.rend(); ++stageIt) {
+      iir::Stage& stage = **stageIt;
+
+      // The extents of the stage are final once all the later stages are processed: the stage
+      // needs to compute the fields it writes wherever they are accessed by the later stages
+      bool isAccessedLater = false;
+      iir::Extents ext = stage.getExtents();
+      for(const auto& fieldPair : stage.getFields()) {
+        const iir::Field& field = fieldPair.second;
+        if(field.getIntend() == iir::Field::IntendKind::IK_Input)
+          continue;
+
+        auto it = accessExtents.find(field.getAccessID());
+        if(it == accessExtents.end())
+          continue;
+
+        ext.merge(it->second);
+        isAccessedLater = true;
+      }
 
-      // loop over all the input fields read in fromStage
-      for(const auto& fromFieldPair : fromStage.getFields()) {
+      if(isAccessedLater) {
+        // this pass is computing the redundant computation in the horizontal, therefore we
+        // nullify the vertical component of the stage
+        ext[2] = iir::Extent{0, 0};
+        stage.setExtents(ext);
+      }
 
-        const iir::Field& fromField = fromFieldPair.second;
-        auto&& fromFieldExtents = fromField.getExtents();
+      // loop over all the fields accessed in the stage
+      const iir::Extents& stageExtent = stage.getExtents();
+      for(const auto& fieldPair : stage.getFields()) {
+        const iir::Field& field = fieldPair.second;
 
         // notice that IO (if read happens before write) would also be a valid pattern
         // to trigger the propagation of the stage extents, however this is not a legal
@@ -51,41 +81,22 @@ bool PassComputeStageExtents::run(
         //      Point one [ExtentComputationTODO]
         // ===-----------------------------------------------------------------------------------===
 
-        iir::Extents fieldExtent = fromFieldExtents;
-
+        iir::Extents fieldExtent = field.getExtents();
         fieldExtent.expand(stageExtent);
 
-        // check which (previous) stage computes the field (read in fromStage)
-        for(int j = i - 1; j >= 0; --j) {
-          iir::Stage& toStage = *(stencil.getStage(j));
-          // ===---------------------------------------------------------------------------------===
-          //      Point two [ExtentComputationTODO]
-          // ===---------------------------------------------------------------------------------===
-          auto fields = toStage.getFields();
-          auto it = std::find_if(fields.begin(), fields.end(),
-                                 [&](std::pair<int, iir::Field> const& pair) {
-                                   const auto& f = pair.second;
-                                   return (f.getIntend() != iir::Field::IntendKind::IK_Input) &&
-                                          (f.getAccessID() == fromField.getAccessID());
-                                 });
-          if(it == fields.end())
-            continue;
-
-          // if found, add the (read) extent of the field as an extent of the stage
-          iir::Extents ext = toStage.getExtents();
-          ext.merge(fieldExtent);
-          // this pass is computing the redundant computation in the horizontal, therefore we
-          // nullify the vertical component of the stage
-          ext[2] = iir::Extent{0, 0};
-          toStage.setExtents(ext);
-        }
+        auto it = accessExtents.find(field.getAccessID());
+        if(it == accessExtents.end())
+          accessExtents.emplace(field.getAccessID(), fieldExtent);
+        else
+          it->second.merge(fieldExtent);
       }
     }
   }
 
   for(const auto& MS : iterateIIROver<iir::MultiStage>(*(stencilInstantiation->getIIR()))) {
-    MS->update(iir::NodeUpdateType::levelAndTreeAbove);
+    MS->markDerivedInfoDirty();
   }
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
 
   return true;
 }
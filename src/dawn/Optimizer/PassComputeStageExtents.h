@@ -17,7 +17,7 @@
 
 // ===-------------------------------------------------------------------------------------------===
 //      The Algorithm in this pass was broken and is now replaced by a greedier one that works
-//        in order to fix it, Point One and Two [ExtentComputationTODO] needs to be optimized:
+//        in order to fix it, Point One [ExtentComputationTODO] needs to be optimized:
 //        https://github.com/MeteoSwiss-APN/dawn/issues/104
 // ===-------------------------------------------------------------------------------------------===
 #include "dawn/Optimizer/Pass.h"
@@ -28,6 +28,10 @@ namespace dawn {
 /// The pass takes as input a collection of stages of each multi-stage from the StencilInstantation
 /// and stores the computation in the `Extent` member of the Stage (@see Stage)
 ///
+/// The stages are visited once in reverse order: the extents with which each field is accessed by
+/// the stages already visited are accumulated and merged into the extents of the stage writing it,
+/// hence the pass runs in linear time in the number of stages and fields.
+///
 /// This Pass needs to be recomputed if the collection and order of stages/multistages changes
 ///
 /// @ingroup optimizer
@@ -0,0 +1,340 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PassConstantFolding.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/AccessComputation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTVisitor.h"
+#include "dawn/Support/Casting.h"
+#include "dawn/Support/NonCopyable.h"
+#include "dawn/Support/StringUtil.h"
+#include <boost/optional.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Value of a literal of type `bool`, `int` or `float_type`
+struct Constant {
+  BuiltinTypeID Type;
+
+  /// Value of booleans and integers
+  long long Integer = 0;
+
+  /// Value of floating point numbers
+  double Float = 0;
+
+  explicit Constant(BuiltinTypeID type) : Type(type) {}
+
+  bool isFloat() const { return Type == BuiltinTypeID::Float; }
+  double asFloat() const { return isFloat() ? Float : static_cast<double>(Integer); }
+  bool asBool() const { return isFloat() ? Float != 0 : Integer != 0; }
+
+  static Constant makeBool(bool value) {
+    Constant c(BuiltinTypeID::Boolean);
+    c.Integer = value;
+    return c;
+  }
+
+  static boost::optional<Constant> makeInteger(long long value) {
+    if(value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+      return boost::none;
+    Constant c(BuiltinTypeID::Integer);
+    c.Integer = value;
+    return c;
+  }
+
+  static boost::optional<Constant> makeFloat(double value) {
+    if(!std::isfinite(value))
+      return boost::none;
+    Constant c(BuiltinTypeID::Float);
+    c.Float = value;
+    return c;
+  }
+};
+
+/// @brief Get the value of `expr` if it is a literal
+boost::optional<Constant> getConstant(const std::shared_ptr<Expr>& expr) {
+  const LiteralAccessExpr* literal = dyn_cast<LiteralAccessExpr>(expr.get());
+  if(!literal)
+    return boost::none;
+
+  const std::string& value = literal->getValue();
+  if(value.empty())
+    return boost::none;
+
+  char* end = nullptr;
+  switch(literal->getBuiltinType()) {
+  case BuiltinTypeID::Boolean:
+    if(value != "true" && value != "false")
+      return boost::none;
+    return Constant::makeBool(value == "true");
+  case BuiltinTypeID::Integer: {
+    long long integer = std::strtoll(value.c_str(), &end, 10);
+    return *end == '\0' ? Constant::makeInteger(integer) : boost::none;
+  }
+  case BuiltinTypeID::Float: {
+    double floatingPoint = std::strtod(value.c_str(), &end);
+    return *end == '\0' ? Constant::makeFloat(floatingPoint) : boost::none;
+  }
+  default:
+    return boost::none;
+  }
+}
+
+boost::optional<Constant> evalUnaryOperator(const std::string& op, const Constant& operand) {
+  if(op == "!")
+    return Constant::makeBool(!operand.asBool());
+  if(op == "-" || op == "+") {
+    // Booleans are promoted to int
+    if(operand.isFloat())
+      return Constant::makeFloat(op == "-" ? -operand.Float : operand.Float);
+    return Constant::makeInteger(op == "-" ? -operand.Integer : operand.Integer);
+  }
+  return boost::none;
+}
+
+boost::optional<Constant> evalBinaryOperator(const std::string& op, const Constant& lhs,
+                                             const Constant& rhs) {
+  if(op == "&&")
+    return Constant::makeBool(lhs.asBool() && rhs.asBool());
+  if(op == "||")
+    return Constant::makeBool(lhs.asBool() || rhs.asBool());
+
+  // Usual arithmetic conversions: bool is promoted to int, mixed operands to floating point
+  if(lhs.isFloat() || rhs.isFloat()) {
+    double a = lhs.asFloat(), b = rhs.asFloat();
+    if(op == "+")
+      return Constant::makeFloat(a + b);
+    if(op == "-")
+      return Constant::makeFloat(a - b);
+    if(op == "*")
+      return Constant::makeFloat(a * b);
+    if(op == "/")
+      return Constant::makeFloat(a / b);
+    if(op == "==")
+      return Constant::makeBool(a == b);
+    if(op == "!=")
+      return Constant::makeBool(a != b);
+    if(op == "<")
+      return Constant::makeBool(a < b);
+    if(op == ">")
+      return Constant::makeBool(a > b);
+    if(op == "<=")
+      return Constant::makeBool(a <= b);
+    if(op == ">=")
+      return Constant::makeBool(a >= b);
+    return boost::none;
+  }
+
+  long long a = lhs.Integer, b = rhs.Integer;
+  if(op == "+")
+    return Constant::makeInteger(a + b);
+  if(op == "-")
+    return Constant::makeInteger(a - b);
+  if(op == "*")
+    return Constant::makeInteger(a * b);
+  if(op == "/")
+    return b != 0 ? Constant::makeInteger(a / b) : boost::none;
+  if(op == "%")
+    return b != 0 ? Constant::makeInteger(a % b) : boost::none;
+  if(op == "==")
+    return Constant::makeBool(a == b);
+  if(op == "!=")
+    return Constant::makeBool(a != b);
+  if(op == "<")
+    return Constant::makeBool(a < b);
+  if(op == ">")
+    return Constant::makeBool(a > b);
+  if(op == "<=")
+    return Constant::makeBool(a <= b);
+  if(op == ">=")
+    return Constant::makeBool(a >= b);
+  return boost::none;
+}
+
+/// @brief Replaces the operators with literal operands by their value
+///
+/// The arguments of stencil function calls are left untouched as they are referenced by the
+/// stencil function instantiations.
+class ConstantFolder : public ASTVisitorPostOrder, public NonCopyable {
+  iir::StencilInstantiation& instantiation_;
+  int numFolded_ = 0;
+
+public:
+  ConstantFolder(iir::StencilInstantiation& instantiation) : instantiation_(instantiation) {}
+
+  int getNumFolded() const { return numFolded_; }
+
+  bool preVisitNode(std::shared_ptr<StencilFunCallExpr> const& expr) override { return false; }
+
+  std::shared_ptr<Expr> postVisitNode(std::shared_ptr<UnaryOperator> const& expr) override {
+    boost::optional<Constant> operand = getConstant(expr->getOperand());
+    if(!operand)
+      return expr;
+    return makeLiteral(expr, evalUnaryOperator(expr->getOp(), *operand));
+  }
+
+  std::shared_ptr<Expr> postVisitNode(std::shared_ptr<BinaryOperator> const& expr) override {
+    boost::optional<Constant> lhs = getConstant(expr->getLeft());
+    boost::optional<Constant> rhs = getConstant(expr->getRight());
+    if(!lhs || !rhs)
+      return expr;
+    return makeLiteral(expr, evalBinaryOperator(expr->getOp(), *lhs, *rhs));
+  }
+
+  std::shared_ptr<Expr> postVisitNode(std::shared_ptr<TernaryOperator> const& expr) override {
+    boost::optional<Constant> cond = getConstant(expr->getCondition());
+    if(!cond)
+      return expr;
+    numFolded_++;
+    return cond->asBool() ? expr->getLeft() : expr->getRight();
+  }
+
+private:
+  /// @brief Create and register the literal of `value` (or return `expr` if it could not be
+  /// evaluated)
+  std::shared_ptr<Expr> makeLiteral(const std::shared_ptr<Expr>& expr,
+                                    const boost::optional<Constant>& value) {
+    if(!value)
+      return expr;
+
+    std::string valueStr;
+    switch(value->Type) {
+    case BuiltinTypeID::Boolean:
+      valueStr = value->Integer ? "true" : "false";
+      break;
+    case BuiltinTypeID::Integer:
+      valueStr = std::to_string(value->Integer);
+      break;
+    default:
+      valueStr = doubleToString(value->Float);
+      break;
+    }
+
+    auto literal =
+        std::make_shared<LiteralAccessExpr>(valueStr, value->Type, expr->getSourceLocation());
+
+    // Register a literal access (Note: the negative AccessID we assign!)
+    int AccessID = -instantiation_.nextUID();
+    iir::StencilMetaInformation& metadata = instantiation_.getMetaData();
+    metadata.insertAccessOfType(iir::FieldAccessType::FAT_Literal, AccessID, valueStr);
+    metadata.insertExprToAccessID(literal, AccessID);
+
+    numFolded_++;
+    return literal;
+  }
+};
+
+/// @brief Replace the if-statements of `doMethod` whose condition is a literal by the statements of
+/// the branch which is taken
+/// @returns number of removed if-statements
+int eliminateDeadBranches(iir::StencilInstantiation& instantiation, iir::DoMethod& doMethod) {
+  int numEliminated = 0;
+
+  for(auto it = doMethod.childrenBegin(); it != doMethod.childrenEnd();) {
+    const auto& stmtAccessesPair = *it;
+    const IfStmt* ifStmt = dyn_cast<IfStmt>(stmtAccessesPair->getStatement()->ASTStmt.get());
+    boost::optional<Constant> cond = ifStmt ? getConstant(ifStmt->getCondExpr()) : boost::none;
+    if(!cond) {
+      ++it;
+      continue;
+    }
+
+    const BlockStmt* thenStmt = dyn_cast<BlockStmt>(ifStmt->getThenStmt().get());
+    const BlockStmt* elseStmt =
+        ifStmt->hasElse() ? dyn_cast<BlockStmt>(ifStmt->getElseStmt().get()) : nullptr;
+    if(!thenStmt || (ifStmt->hasElse() && !elseStmt)) {
+      ++it;
+      continue;
+    }
+
+    // The statements of the then- and else-block are stored consecutively in the block statements
+    const auto& blockStatements = stmtAccessesPair->getBlockStatements();
+    const std::size_t numThenStmts = thenStmt->getStatements().size();
+    DAWN_ASSERT(blockStatements.size() ==
+                numThenStmts + (elseStmt ? elseStmt->getStatements().size() : 0));
+
+    std::size_t first = cond->asBool() ? 0 : numThenStmts;
+    std::size_t last = cond->asBool() ? numThenStmts : blockStatements.size();
+    if(first == last && doMethod.getChildren().size() == 1) {
+      ++it;
+      continue;
+    }
+
+    // Inserting the statements updates the tree above, hence their accesses need to be known
+    std::vector<std::unique_ptr<iir::StatementAccessesPair>> takenStmtAccessesPairs;
+    for(std::size_t i = first; i < last; ++i)
+      takenStmtAccessesPairs.push_back(blockStatements[i]->clone());
+    computeAccesses(&instantiation, takenStmtAccessesPairs);
+
+    it = doMethod.childrenErase(it);
+    it = doMethod.insertChildren(it, std::make_move_iterator(takenStmtAccessesPairs.begin()),
+                                 std::make_move_iterator(takenStmtAccessesPairs.end()));
+    numEliminated++;
+  }
+  return numEliminated;
+}
+
+} // anonymous namespace
+
+PassConstantFolding::PassConstantFolding() : Pass("PassConstantFolding") {}
+
+bool PassConstantFolding::run(
+    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+  OptimizerContext* context = stencilInstantiation->getOptimizerContext();
+  const Options& options = context->getOptions();
+  if(!options.FoldConstants && options.SpecializeGlobals.empty())
+    return true;
+
+  int numFolded = 0, numEliminated = 0;
+
+  for(const auto& doMethodPtr : iterateIIROver<iir::DoMethod>(*(stencilInstantiation->getIIR()))) {
+    iir::DoMethod& doMethod = *doMethodPtr;
+
+    ConstantFolder folder(*stencilInstantiation);
+    for(const auto& stmtAccessesPair : doMethod.getChildren())
+      stmtAccessesPair->getStatement()->ASTStmt->acceptAndReplace(folder);
+
+    int numEliminatedInDoMethod = eliminateDeadBranches(*stencilInstantiation, doMethod);
+
+    if(folder.getNumFolded() || numEliminatedInDoMethod) {
+      // The folded expressions and removed conditions changed the reads of the statements
+      computeAccesses(stencilInstantiation.get(), doMethod.getChildren());
+      doMethod.markDerivedInfoDirty();
+    }
+
+    numFolded += folder.getNumFolded();
+    numEliminated += numEliminatedInDoMethod;
+  }
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
+
+  if(options.ReportPassConstantFolding)
+    std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName() << ": folded "
+              << numFolded << " expressions, removed " << numEliminated << " if-statements\n";
+  return true;
+}
+
+} // namespace dawn
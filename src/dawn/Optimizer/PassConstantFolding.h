@@ -0,0 +1,55 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PASSCONSTANTFOLDING_H
+#define DAWN_OPTIMIZER_PASSCONSTANTFOLDING_H
+
+#include "dawn/Optimizer/Pass.h"
+
+namespace dawn {
+
+/// @brief Pass to fold constant expressions and to remove the branches which are never taken
+/// @ingroup optimizer
+///
+/// Unary, binary and ternary operators whose operands are literals are replaced by their value.
+/// Constant global variables are replaced by their value when the IIR is built, this pass is hence
+/// what specializes the stencils for them (see `-specialize-globals`):
+///
+/// @code
+///   globals { bool use_diffusion = false; }
+///
+///   out = in * (2 * 3 + 1);                  out = in * 7;
+///   if(use_diffusion) {                =>    out = 0.0;
+///     out = in + 0.5 * lap;
+///   } else {
+///     out = 0.0;
+///   }
+/// @endcode
+///
+/// If-statements of a Do-Method whose condition folds to a literal are replaced by the statements
+/// of the branch which is taken (unless this would leave the Do-Method empty). Expressions of
+/// floating point type are evaluated in double precision.
+///
+/// This pass is not necessary to create legal code and is hence not in the debug-group
+class PassConstantFolding : public Pass {
+public:
+  PassConstantFolding();
+
+  /// @brief Pass implementation
+  bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+};
+
+} // namespace dawn
+
+#endif
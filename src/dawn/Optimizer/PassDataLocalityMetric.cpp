@@ -16,6 +16,7 @@
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PerformanceModel.h"
 #include "dawn/SIR/AST.h"
 #include "dawn/SIR/ASTVisitor.h"
 #include "dawn/Support/Format.h"
@@ -30,7 +31,7 @@ namespace dawn {
 namespace {
 
 class ReadWriteCounter : public ASTVisitorForwarding {
-  const std::shared_ptr<iir::StencilInstantiation>& instantiation_;
+  const iir::StencilInstantiation& instantiation_;
   const iir::StencilMetaInformation& metadata_;
 
   std::size_t numReads_, numWrites_;
@@ -39,7 +40,7 @@ class ReadWriteCounter : public ASTVisitorForwarding {
   const iir::MultiStage& multiStage_;
 
   /// Fields of the MultiStage
-  std::unordered_map<int, iir::Field> fields_;
+  iir::FieldMap fields_;
 
   /// Fields which are considered to be loaded into a register
   std::unordered_set<int> register_;
@@ -60,9 +61,9 @@ class ReadWriteCounter : public ASTVisitorForwarding {
   std::unordered_map<int, ReadWriteAccumulator> individualReadWrites_;
 
 public:
-  ReadWriteCounter(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+  ReadWriteCounter(const iir::StencilInstantiation& instantiation,
                    const iir::MultiStage& multiStage)
-      : instantiation_(instantiation), metadata_(instantiation->getMetaData()), numReads_(0),
+      : instantiation_(instantiation), metadata_(instantiation.getMetaData()), numReads_(0),
         numWrites_(0), multiStage_(multiStage), fields_(multiStage_.getFields()) {}
 
   std::size_t getNumReads() const { return numReads_; }
@@ -70,7 +71,7 @@ public:
 
   void updateTextureCache(int AccessID, int kOffset) {
     if(textureCache_.size() <
-       instantiation_->getOptimizerContext()->getHardwareConfiguration().TexCacheMaxFields)
+       instantiation_.getOptimizerContext()->getHardwareConfiguration().TexCacheMaxFields)
       textureCache_.emplace_front(AccessID, kOffset);
     else {
       auto it = std::find_if(
@@ -235,7 +236,7 @@ DAWN_ATTRIBUTE_UNUSED static std::pair<int, int>
 computeReadWriteAccessesLowerBound(iir::StencilInstantiation* instantiation,
                                    const iir::MultiStage& multiStage) {
   std::size_t numReads = 0, numWrites = 0;
-  std::unordered_map<int, iir::Field> fields = multiStage.getFields();
+  iir::FieldMap fields = multiStage.getFields();
 
   for(const auto& AccessIDFieldPair : fields) {
     int AccessID = AccessIDFieldPair.first;
@@ -282,6 +283,12 @@ computeReadWriteAccessesLowerBound(iir::StencilInstantiation* instantiation,
 std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerAccessID(
     const std::shared_ptr<iir::StencilInstantiation>& instantiation,
     const iir::MultiStage& multiStage) {
+  return computeReadWriteAccessesMetricPerAccessID(*instantiation, multiStage);
+}
+
+std::unordered_map<int, ReadWriteAccumulator>
+computeReadWriteAccessesMetricPerAccessID(const iir::StencilInstantiation& instantiation,
+                                          const iir::MultiStage& multiStage) {
   ReadWriteCounter readWriteCounter(instantiation, multiStage);
 
   for(const auto& statementAccessesPair : iterateIIROver<iir::StatementAccessesPair>(multiStage)) {
@@ -295,6 +302,11 @@ std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerA
 std::pair<int, int>
 computeReadWriteAccessesMetric(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
                                const iir::MultiStage& multiStage) {
+  return computeReadWriteAccessesMetric(*instantiation, multiStage);
+}
+
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   const iir::MultiStage& multiStage) {
   ReadWriteCounter readWriteCounter(instantiation, multiStage);
 
   for(const auto& statementAccessesPair : iterateIIROver<iir::StatementAccessesPair>(multiStage)) {
@@ -316,7 +328,7 @@ bool PassDataLocalityMetric::run(
     std::cout << std::string((paddingLength) / 2, '-') << title
               << std::string((paddingLength + 1) / 2, '-') << "\n";
 
-    std::size_t perStencilNumReads = 0, perStencilNumWrites = 0;
+    std::size_t perStencilNumReads = 0, perStencilNumWrites = 0, perStencilNumFlops = 0;
 
     int stencilIdx = 0;
     for(const auto& stencilPtr : stencilInstantiation->getStencils()) {
@@ -333,12 +345,15 @@ bool PassDataLocalityMetric::run(
         auto readAndWrite = computeReadWriteAccessesMetric(stencilInstantiation, multiStage);
 
         std::size_t numReads = readAndWrite.first, numWrites = readAndWrite.second;
+        std::size_t numFlops = computeFlopsPerGridPoint(*stencilInstantiation, multiStage);
 
         std::cout << format("    %-20s %15i\n", "Reads", numReads);
         std::cout << format("    %-20s %15i\n", "Writes", numWrites);
+        std::cout << format("    %-20s %15i\n", "Flops", numFlops);
 
         perStencilNumReads += numReads;
         perStencilNumWrites += numWrites;
+        perStencilNumFlops += numFlops;
         multiStageIdx++;
       }
 
@@ -348,6 +363,7 @@ bool PassDataLocalityMetric::run(
     std::cout << format("\n  %-22s %15s\n", "", std::string(15, '='));
     std::cout << format("  %-22s %15i\n", "Reads", perStencilNumReads);
     std::cout << format("  %-22s %15i\n", "Writes", perStencilNumWrites);
+    std::cout << format("  %-22s %15i\n", "Flops", perStencilNumFlops);
     std::cout << std::string(51, '-') << std::endl;
   }
 
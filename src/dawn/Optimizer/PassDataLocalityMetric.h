@@ -47,9 +47,14 @@ public:
 std::pair<int, int>
 computeReadWriteAccessesMetric(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
                                const iir::MultiStage& multiStage);
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   const iir::MultiStage& multiStage);
 std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerAccessID(
     const std::shared_ptr<iir::StencilInstantiation>& instantiation,
     const iir::MultiStage& multiStage);
+std::unordered_map<int, ReadWriteAccumulator>
+computeReadWriteAccessesMetricPerAccessID(const iir::StencilInstantiation& instantiation,
+                                          const iir::MultiStage& multiStage);
 
 } // namespace dawn
 
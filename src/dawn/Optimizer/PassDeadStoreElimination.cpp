@@ -0,0 +1,251 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PassDeadStoreElimination.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTStringifier.h"
+#include "dawn/SIR/ASTVisitor.h"
+#include "dawn/Support/Casting.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Collect the stencil function calls of a statement (including the calls in arguments)
+class StencilFunCallCollector : public ASTVisitorForwarding {
+  std::vector<std::shared_ptr<StencilFunCallExpr>> calls_;
+
+public:
+  void visit(const std::shared_ptr<StencilFunCallExpr>& expr) override {
+    calls_.push_back(expr);
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  const std::vector<std::shared_ptr<StencilFunCallExpr>>& getCalls() const { return calls_; }
+};
+
+/// @brief Accesses of the whole stencil instantiation
+struct GlobalAccesses {
+  /// AccessIDs read by any statement
+  std::unordered_set<int> ReadAccessIDs;
+
+  /// Local variables accessed in more than one Do-Method (they are never removed)
+  std::unordered_set<int> SharedLocalVariables;
+};
+
+GlobalAccesses computeGlobalAccesses(iir::StencilInstantiation& instantiation) {
+  const iir::StencilMetaInformation& metadata = instantiation.getMetaData();
+
+  GlobalAccesses globalAccesses;
+  std::unordered_map<int, const iir::DoMethod*> localVariableToDoMethod;
+  auto insertLocalVariable = [&](int AccessID, const iir::DoMethod* doMethod) {
+    if(!metadata.isAccessType(iir::FieldAccessType::FAT_LocalVariable, AccessID))
+      return;
+    auto it = localVariableToDoMethod.emplace(AccessID, doMethod).first;
+    if(it->second != doMethod)
+      globalAccesses.SharedLocalVariables.insert(AccessID);
+  };
+
+  for(const auto& doMethodPtr : iterateIIROver<iir::DoMethod>(*(instantiation.getIIR()))) {
+    for(const auto& stmtAccessesPair : doMethodPtr->getChildren()) {
+      const auto& accesses = stmtAccessesPair->getAccesses();
+      for(const auto& accessPair : accesses->getReadAccesses()) {
+        globalAccesses.ReadAccessIDs.insert(accessPair.first);
+        insertLocalVariable(accessPair.first, doMethodPtr.get());
+      }
+      for(const auto& accessPair : accesses->getWriteAccesses())
+        insertLocalVariable(accessPair.first, doMethodPtr.get());
+    }
+  }
+  return globalAccesses;
+}
+
+/// @brief Check if `stmt` is an assignment or a variable declaration
+bool isStore(const std::shared_ptr<Stmt>& stmt) {
+  if(ExprStmt* exprStmt = dyn_cast<ExprStmt>(stmt.get()))
+    return isa<AssignmentExpr>(exprStmt->getExpr().get());
+  return isa<VarDeclStmt>(stmt.get());
+}
+
+/// @brief Find the dead statements of `doMethod`
+///
+/// The statements are traversed backwards while keeping track of the local variables whose
+/// current value is read later on. Statements with control flow never end the lifetime of a value
+/// as they may not be executed.
+std::vector<bool> findDeadStatements(const iir::StencilMetaInformation& metadata,
+                                     const iir::DoMethod& doMethod,
+                                     const GlobalAccesses& globalAccesses) {
+  const auto& stmtAccessesPairs = doMethod.getChildren();
+  std::vector<bool> isDead(stmtAccessesPairs.size(), false);
+
+  // Local variables read after the current statement and AccessIDs accessed by the statements
+  // which are kept (a declaration is kept as long as its variable is used)
+  std::unordered_set<int> liveLocalVariables;
+  std::unordered_set<int> referencedAccessIDs;
+
+  auto isDeadWrite = [&](int AccessID, bool isDecl) {
+    if(metadata.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, AccessID))
+      return !globalAccesses.ReadAccessIDs.count(AccessID);
+    if(metadata.isAccessType(iir::FieldAccessType::FAT_LocalVariable, AccessID))
+      return !liveLocalVariables.count(AccessID) &&
+             !(isDecl && referencedAccessIDs.count(AccessID)) &&
+             !globalAccesses.SharedLocalVariables.count(AccessID);
+    return false;
+  };
+
+  for(std::size_t stmtIndex = stmtAccessesPairs.size(); stmtIndex-- > 0;) {
+    const auto& stmtAccessesPair = stmtAccessesPairs[stmtIndex];
+    const std::shared_ptr<Stmt>& stmt = stmtAccessesPair->getStatement()->ASTStmt;
+    const auto& writeAccesses = stmtAccessesPair->getAccesses()->getWriteAccesses();
+    const auto& readAccesses = stmtAccessesPair->getAccesses()->getReadAccesses();
+
+    bool isDecl = isa<VarDeclStmt>(stmt.get());
+    if(isStore(stmt) && !writeAccesses.empty() &&
+       std::all_of(writeAccesses.begin(), writeAccesses.end(),
+                   [&](const std::pair<int, iir::Extents>& accessPair) {
+                     return isDeadWrite(accessPair.first, isDecl);
+                   })) {
+      isDead[stmtIndex] = true;
+      continue;
+    }
+
+    // The writes of statements with control flow are conditional
+    if(!isa<IfStmt>(stmt.get()))
+      for(const auto& accessPair : writeAccesses)
+        liveLocalVariables.erase(accessPair.first);
+
+    for(const auto& accessPair : readAccesses)
+      liveLocalVariables.insert(accessPair.first);
+
+    for(const auto& accessPair : writeAccesses)
+      referencedAccessIDs.insert(accessPair.first);
+    for(const auto& accessPair : readAccesses)
+      referencedAccessIDs.insert(accessPair.first);
+  }
+  return isDead;
+}
+
+/// @brief Remove the dead statements of `doMethod`
+/// @returns number of removed statements
+int removeDeadStatements(iir::StencilInstantiation& instantiation, iir::DoMethod& doMethod,
+                         const GlobalAccesses& globalAccesses, bool report) {
+  iir::StencilMetaInformation& metadata = instantiation.getMetaData();
+  std::vector<bool> isDead = findDeadStatements(metadata, doMethod, globalAccesses);
+
+  int numRemoved = 0;
+  std::size_t stmtIndex = 0;
+  for(auto it = doMethod.childrenBegin(); it != doMethod.childrenEnd(); ++stmtIndex) {
+    if(!isDead[stmtIndex]) {
+      ++it;
+      continue;
+    }
+
+    const std::shared_ptr<Stmt>& stmt = (*it)->getStatement()->ASTStmt;
+    if(report)
+      std::cout << "\nPASS: PassDeadStoreElimination: " << instantiation.getName()
+                << ": removed " << ASTStringifer::toString(stmt, 0, false) << "\n";
+
+    StencilFunCallCollector collector;
+    stmt->accept(collector);
+    for(const auto& call : collector.getCalls())
+      if(metadata.getExprToStencilFunctionInstantiation().count(call))
+        metadata.removeStencilFunctionInstantiation(call, nullptr);
+
+    it = doMethod.childrenErase(it);
+    ++numRemoved;
+  }
+  return numRemoved;
+}
+
+} // anonymous namespace
+
+PassDeadStoreElimination::PassDeadStoreElimination() : Pass("PassDeadStoreElimination") {}
+
+bool PassDeadStoreElimination::run(
+    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+  OptimizerContext* context = stencilInstantiation->getOptimizerContext();
+  if(!context->getOptions().DeadStoreElimination)
+    return true;
+
+  bool report = context->getOptions().ReportPassDeadStoreElimination;
+  int numRemoved = 0;
+
+  // Removing a statement may render the statements computing its operands dead
+  int numRemovedInIteration = 0;
+  do {
+    GlobalAccesses globalAccesses = computeGlobalAccesses(*stencilInstantiation);
+    numRemovedInIteration = 0;
+
+    for(const auto& stencil : stencilInstantiation->getStencils()) {
+      int numRemovedInStencil = 0;
+
+      for(auto multiStageIt = stencil->childrenBegin(); multiStageIt != stencil->childrenEnd();) {
+        iir::MultiStage& multiStage = **multiStageIt;
+
+        for(auto stageIt = multiStage.childrenBegin(); stageIt != multiStage.childrenEnd();) {
+          iir::Stage& stage = **stageIt;
+
+          for(auto doMethodIt = stage.childrenBegin(); doMethodIt != stage.childrenEnd();) {
+            iir::DoMethod& doMethod = **doMethodIt;
+            int numRemovedInDoMethod =
+                removeDeadStatements(*stencilInstantiation, doMethod, globalAccesses, report);
+            numRemovedInStencil += numRemovedInDoMethod;
+
+            if(doMethod.childrenEmpty()) {
+              doMethodIt = stage.childrenErase(doMethodIt);
+            } else {
+              if(numRemovedInDoMethod)
+                doMethod.markDerivedInfoDirty();
+              doMethodIt++;
+            }
+          }
+
+          if(stage.childrenEmpty())
+            stageIt = multiStage.childrenErase(stageIt);
+          else
+            stageIt++;
+        }
+
+        if(multiStage.childrenEmpty())
+          multiStageIt = stencil->childrenErase(multiStageIt);
+        else
+          multiStageIt++;
+      }
+
+      // The dependencies between the stages have changed (or the stages do not exist anymore),
+      // the stage graph is no longer valid
+      if(numRemovedInStencil != 0)
+        stencil->setStageDependencyGraph(nullptr);
+      numRemovedInIteration += numRemovedInStencil;
+    }
+    numRemoved += numRemovedInIteration;
+  } while(numRemovedInIteration != 0);
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
+
+  if(report)
+    std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName() << ": removed "
+              << numRemoved << " statement" << (numRemoved == 1 ? "" : "s") << "\n";
+  return true;
+}
+
+} // namespace dawn
@@ -0,0 +1,46 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PASSDEADSTOREELIMINATION_H
+#define DAWN_OPTIMIZER_PASSDEADSTOREELIMINATION_H
+
+#include "dawn/Optimizer/Pass.h"
+
+namespace dawn {
+
+/// @brief Pass to remove the statements whose result is never read
+/// @ingroup optimizer
+///
+/// An assignment or variable declaration is dead if it only writes to
+///
+///   - stencil temporaries which are not read anywhere in the stencil instantiation or
+///   - local variables which are not read before being overwritten or going out of scope.
+///
+/// Removing a statement may render the statements computing its operands dead, the pass hence
+/// iterates until no more statements can be removed. Do-Methods, stages and multi-stages which end
+/// up empty are removed as well. Writes to API fields, inter-stencil temporaries and global
+/// variables are always kept.
+///
+/// This pass is not necessary to create legal code and is hence not in the debug-group
+class PassDeadStoreElimination : public Pass {
+public:
+  PassDeadStoreElimination();
+
+  /// @brief Pass implementation
+  bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+};
+
+} // namespace dawn
+
+#endif
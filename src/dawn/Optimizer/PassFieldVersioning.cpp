@@ -182,7 +182,7 @@ PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
     for(int fromAccessID : scc) {
       std::size_t fromVertexID = graph->getVertexIDFromValue(fromAccessID);
 
-      for(const Edge& edge : *graph->getAdjacencyList()[fromVertexID]) {
+      for(const Edge& edge : graph->getAdjacencyList()[fromVertexID]) {
         if(scc.count(graph->getIDFromVertexID(edge.ToVertexID)) &&
            isHorizontalStencilOrCounterLoopOrderExtent(edge.Data, loopOrder)) {
           isStencilSCC = true;
@@ -202,7 +202,7 @@ PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
     for(const auto& AccessIDVertexPair : graph->getVertices()) {
       const Vertex& vertex = AccessIDVertexPair.second;
 
-      for(const Edge& edge : *graph->getAdjacencyList()[vertex.VertexID]) {
+      for(const Edge& edge : graph->getAdjacencyList()[vertex.VertexID]) {
         if(edge.FromVertexID == edge.ToVertexID &&
            isHorizontalStencilOrCounterLoopOrderExtent(edge.Data, loopOrder)) {
           stencilSCCs->emplace_back(std::set<int>{vertex.value});
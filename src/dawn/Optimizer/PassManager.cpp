@@ -46,7 +46,19 @@ bool PassManager::runPassOnStecilInstantiation(
     const std::shared_ptr<iir::StencilInstantiation>& instantiation, Pass* pass) {
   DAWN_LOG(INFO) << "Starting " << pass->getName() << " ...";
 
-  if(!pass->run(instantiation)) {
+  // -profile-passes (the measurement stops before the consistency checks below)
+  std::unique_ptr<PassProfiler::Measurement> measurement;
+  if(PassProfiler* profiler = instantiation->getOptimizerContext()->getPassProfiler())
+    measurement = make_unique<PassProfiler::Measurement>(*profiler, pass->getName(), instantiation);
+
+  bool success;
+  {
+    ArenaScope astArenaScope(instantiation->getASTArena());
+    success = pass->run(instantiation);
+  }
+  measurement.reset();
+
+  if(!success) {
     DAWN_LOG(WARNING) << "Done with " << pass->getName() << " : FAIL";
     return false;
   }
@@ -60,7 +72,9 @@ bool PassManager::runPassOnStecilInstantiation(
                   std::string("Tree consistency check failed for pass" + pass->getName()).c_str());
 
 #ifndef NDEBUG
+  // Passes may modify the accesses of the statements directly, hence all stencils are verified
   for(const auto& stencil : instantiation->getIIR()->getChildren()) {
+    ++iir::NodeUpdateStatistics::getThreadLocal().NumCompareDerivedInfo;
     DAWN_ASSERT(stencil->compareDerivedInfo());
   }
 #endif
@@ -36,13 +36,14 @@ int checkDependencies(const std::unique_ptr<iir::Stage>& stage, int stmtIdx) {
   return 0;
 }
 
-std::function<void(iir::MultiStage::child_reverse_iterator_t&, iir::DependencyGraphAccesses&,
+std::function<void(iir::MultiStage::child_reverse_iterator_t&, ReadBeforeWriteConflictTracker&,
                    iir::LoopOrderKind&, iir::LoopOrderKind&,
                    std::deque<iir::MultiStage::SplitIndex>&, int, int, int&, const std::string&,
                    const std::string&, const Options&)>
 multiStageSplitterOptimized() {
   return
-      [&](iir::MultiStage::child_reverse_iterator_t& stageIt, iir::DependencyGraphAccesses& graph,
+      [&](iir::MultiStage::child_reverse_iterator_t& stageIt,
+          ReadBeforeWriteConflictTracker& tracker,
           iir::LoopOrderKind userSpecifiedLoopOrder, iir::LoopOrderKind& curLoopOrder,
           std::deque<iir::MultiStage::SplitIndex>& splitterIndices, int stageIndex,
           int multiStageIndex, int& numSplit, const std::string& StencilName,
@@ -53,13 +54,13 @@ multiStageSplitterOptimized() {
         // Iterate statements backwards
         for(int stmtIndex = doMethod.getChildren().size() - 1; stmtIndex >= 0; --stmtIndex) {
           auto& stmtAccessesPair = doMethod.getChildren()[stmtIndex];
-          graph.insertStatementAccessesPair(stmtAccessesPair);
+          tracker.insertStatementAccessesPair(stmtAccessesPair);
 
           // Check for read-before-write conflicts in the loop order and counter loop order.
           // Conflicts in the loop order will assure us that the multi-stage can't be
           // parallel. A conflict in the counter loop order is more severe and needs the current
           // multistage be splitted!
-          auto conflict = hasVerticalReadBeforeWriteConflict(&graph, userSpecifiedLoopOrder);
+          auto conflict = tracker.getVerticalConflict();
           if(conflict.CounterLoopOrderConflict) {
 
             // The loop order of the lower part is what we recoreded in the last steps
@@ -75,14 +76,14 @@ multiStageSplitterOptimized() {
                         << " looporder:" << curLoopOrder << "\n";
 
             if(options.DumpSplitGraphs)
-              graph.toDot(format("stmt_vd_ms%i_%02i.dot", multiStageIndex, numSplit));
+              tracker.getGraph().toDot(format("stmt_vd_ms%i_%02i.dot", multiStageIndex, numSplit));
 
             // Clear the graph ...
-            graph.clear();
+            tracker.clear();
             curLoopOrder = iir::LoopOrderKind::LK_Parallel;
 
             // ... and process the current statement again
-            graph.insertStatementAccessesPair(stmtAccessesPair);
+            tracker.insertStatementAccessesPair(stmtAccessesPair);
 
             numSplit++;
 
@@ -93,14 +94,15 @@ multiStageSplitterOptimized() {
         }
       };
 }
-std::function<void(iir::MultiStage::child_reverse_iterator_t&, iir::DependencyGraphAccesses&,
+std::function<void(iir::MultiStage::child_reverse_iterator_t&, ReadBeforeWriteConflictTracker&,
                    iir::LoopOrderKind&, iir::LoopOrderKind&,
                    std::deque<iir::MultiStage::SplitIndex>&, int, int, int&, const std::string&,
                    const std::string&, const Options&)>
 multiStageSplitterDebug() {
 
   return
-      [&](iir::MultiStage::child_reverse_iterator_t& stageIt, iir::DependencyGraphAccesses& graph,
+      [&](iir::MultiStage::child_reverse_iterator_t& stageIt,
+          ReadBeforeWriteConflictTracker& tracker,
           iir::LoopOrderKind& userSpecifiedLoopOrder, iir::LoopOrderKind& curLoopOrder,
           std::deque<iir::MultiStage::SplitIndex>& splitterIndices, int stageIndex,
           int multiStageIndex, int& numSplit, const std::string& StencilName,
@@ -141,10 +143,10 @@ multiStageSplitterDebug() {
         // ensure the proper loop order and cannot just assume parallel.
         for(int stmtIndex = doMethod.getChildren().size() - 1; stmtIndex >= 0; --stmtIndex) {
           auto& stmtAccessesPair = doMethod.getChildren()[stmtIndex];
-          graph.insertStatementAccessesPair(stmtAccessesPair);
+          tracker.insertStatementAccessesPair(stmtAccessesPair);
 
           // Check for read-before-write conflicts in the loop order.
-          auto conflict = hasVerticalReadBeforeWriteConflict(&graph, userSpecifiedLoopOrder);
+          auto conflict = tracker.getVerticalConflict();
           if(conflict.LoopOrderConflict) {
             // We have a conflict in the loop order, the multi-stage cannot be executed in
             // parallel and we use the loop order specified by the user
@@ -159,7 +161,7 @@ multiStageSplitterDebug() {
 bool PassMultiStageSplitter::run(
     const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
 
-  std::function<void(iir::MultiStage::child_reverse_iterator_t&, iir::DependencyGraphAccesses&,
+  std::function<void(iir::MultiStage::child_reverse_iterator_t&, ReadBeforeWriteConflictTracker&,
                      iir::LoopOrderKind&, iir::LoopOrderKind&,
                      std::deque<iir::MultiStage::SplitIndex>&, int, int, int&, const std::string&,
                      const std::string&, const Options&)>
@@ -193,6 +195,9 @@ bool PassMultiStageSplitter::run(
       // forward)
       auto userSpecifiedLoopOrder = multiStage.getLoopOrder();
 
+      // The conflicts are updated incrementally as the statements are inserted into the graph
+      ReadBeforeWriteConflictTracker tracker(graph, userSpecifiedLoopOrder);
+
       // If not proven otherwise, we assume a parralel loop order
       auto curLoopOrder = iir::LoopOrderKind::LK_Parallel;
 
@@ -201,7 +206,7 @@ bool PassMultiStageSplitter::run(
       for(auto stageIt = multiStage.childrenRBegin(); stageIt != multiStage.childrenREnd();
           ++stageIt, --stageIndex) {
 
-        multistagesplitter(stageIt, graph, userSpecifiedLoopOrder, curLoopOrder, splitterIndices,
+        multistagesplitter(stageIt, tracker, userSpecifiedLoopOrder, curLoopOrder, splitterIndices,
                            stageIndex, multiStageIndex, numSplit, StencilName, PassName, options);
       }
       if(context->getOptions().DumpSplitGraphs)
@@ -0,0 +1,200 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#include "dawn/Optimizer/PassProfiler.h"
+#include "dawn/IIR/NodeUpdateType.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/Json.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#ifdef DAWN_ON_UNIX
+#include <sys/resource.h>
+#endif
+
+namespace dawn {
+
+PassProfiler::Measurement::Measurement(
+    PassProfiler& profiler, const std::string& passName,
+    const std::shared_ptr<iir::StencilInstantiation>& instantiation)
+    : profiler_(profiler), instantiation_(instantiation) {
+  const iir::NodeUpdateStatistics& statistics = iir::NodeUpdateStatistics::getThreadLocal();
+
+  profile_.PassName = passName;
+  profile_.InstantiationName = instantiation->getName();
+  profile_.NumNodesBefore = getNumNodes(*instantiation);
+  profile_.PeakRSSDelta = getPeakRSS();
+  profile_.NumClearDerivedInfo = statistics.NumClearDerivedInfo;
+  profile_.NumUpdateFromChildren = statistics.NumUpdateFromChildren;
+  start_ = std::chrono::steady_clock::now();
+}
+
+PassProfiler::Measurement::~Measurement() {
+  auto end = std::chrono::steady_clock::now();
+  const iir::NodeUpdateStatistics& statistics = iir::NodeUpdateStatistics::getThreadLocal();
+
+  profile_.StartTime =
+      std::chrono::duration<double, std::micro>(start_ - profiler_.origin_).count();
+  profile_.WallTime = std::chrono::duration<double, std::micro>(end - start_).count();
+  profile_.NumNodesAfter = getNumNodes(*instantiation_);
+  profile_.PeakRSSDelta = getPeakRSS() - profile_.PeakRSSDelta;
+  profile_.NumClearDerivedInfo = statistics.NumClearDerivedInfo - profile_.NumClearDerivedInfo;
+  profile_.NumUpdateFromChildren =
+      statistics.NumUpdateFromChildren - profile_.NumUpdateFromChildren;
+
+  profiler_.record(std::move(profile_));
+}
+
+PassProfiler::PassProfiler() : origin_(std::chrono::steady_clock::now()) {}
+
+void PassProfiler::record(PassProfile&& profile) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = threadIndices_.emplace(std::this_thread::get_id(), threadIndices_.size()).first;
+  profile.Thread = it->second;
+  profiles_.emplace_back(std::move(profile));
+}
+
+std::string PassProfiler::toString(OutputFormat format) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  json::json node;
+
+  if(format == OF_Trace) {
+    auto events = json::json::array();
+    for(const PassProfile& profile : profiles_) {
+      json::json event;
+      event["name"] = profile.PassName;
+      event["cat"] = "pass";
+      event["ph"] = "X";
+      event["ts"] = profile.StartTime;
+      event["dur"] = profile.WallTime;
+      event["pid"] = 0;
+      event["tid"] = profile.Thread;
+      event["args"]["instantiation"] = profile.InstantiationName;
+      event["args"]["iir_nodes_before"] = profile.NumNodesBefore;
+      event["args"]["iir_nodes_after"] = profile.NumNodesAfter;
+      event["args"]["peak_rss_delta_kb"] = profile.PeakRSSDelta;
+      event["args"]["clear_derived_info_calls"] = profile.NumClearDerivedInfo;
+      event["args"]["update_from_children_calls"] = profile.NumUpdateFromChildren;
+      events.push_back(event);
+    }
+    node["traceEvents"] = events;
+    node["displayTimeUnit"] = "ms";
+    return node.dump(2);
+  }
+
+  // Accumulate the runs of each pass
+  std::map<std::string, PassProfile> passes;
+  std::map<std::string, int> numRuns;
+
+  auto runs = json::json::array();
+  for(const PassProfile& profile : profiles_) {
+    json::json run;
+    run["pass"] = profile.PassName;
+    run["instantiation"] = profile.InstantiationName;
+    run["thread"] = profile.Thread;
+    run["start_us"] = profile.StartTime;
+    run["wall_time_us"] = profile.WallTime;
+    run["iir_nodes_before"] = profile.NumNodesBefore;
+    run["iir_nodes_after"] = profile.NumNodesAfter;
+    run["peak_rss_delta_kb"] = profile.PeakRSSDelta;
+    run["clear_derived_info_calls"] = profile.NumClearDerivedInfo;
+    run["update_from_children_calls"] = profile.NumUpdateFromChildren;
+    runs.push_back(run);
+
+    auto it = passes.find(profile.PassName);
+    if(it == passes.end()) {
+      passes.emplace(profile.PassName, profile);
+    } else {
+      PassProfile& total = it->second;
+      total.WallTime += profile.WallTime;
+      total.PeakRSSDelta += profile.PeakRSSDelta;
+      total.NumClearDerivedInfo += profile.NumClearDerivedInfo;
+      total.NumUpdateFromChildren += profile.NumUpdateFromChildren;
+    }
+    numRuns[profile.PassName]++;
+  }
+
+  // Summary sorted by decreasing total wall time
+  std::vector<const PassProfile*> totals;
+  for(const auto& passPair : passes)
+    totals.push_back(&passPair.second);
+  std::stable_sort(totals.begin(), totals.end(), [](const PassProfile* a, const PassProfile* b) {
+    return a->WallTime > b->WallTime;
+  });
+
+  double totalWallTime = 0;
+  for(const PassProfile* total : totals)
+    totalWallTime += total->WallTime;
+
+  auto summary = json::json::array();
+  for(const PassProfile* total : totals) {
+    json::json pass;
+    pass["pass"] = total->PassName;
+    pass["runs"] = numRuns[total->PassName];
+    pass["wall_time_us"] = total->WallTime;
+    pass["wall_time_fraction"] = totalWallTime > 0 ? total->WallTime / totalWallTime : 0.0;
+    pass["peak_rss_delta_kb"] = total->PeakRSSDelta;
+    pass["clear_derived_info_calls"] = total->NumClearDerivedInfo;
+    pass["update_from_children_calls"] = total->NumUpdateFromChildren;
+    summary.push_back(pass);
+  }
+
+  node["summary"] = summary;
+  node["runs"] = runs;
+  return node.dump(2);
+}
+
+bool PassProfiler::write(const std::string& filename, OutputFormat format) const {
+  std::ofstream fs(filename, std::ios::out | std::ios::trunc);
+  if(!fs.is_open())
+    return false;
+  fs << toString(format) << std::endl;
+  return static_cast<bool>(fs);
+}
+
+int PassProfiler::getNumNodes(const iir::StencilInstantiation& instantiation) {
+  int numNodes = 0;
+  for(const auto& stencil : instantiation.getStencils()) {
+    numNodes++;
+    for(const auto& multiStage : stencil->getChildren()) {
+      numNodes++;
+      for(const auto& stage : multiStage->getChildren()) {
+        numNodes++;
+        for(const auto& doMethod : stage->getChildren())
+          numNodes += 1 + doMethod->getChildren().size();
+      }
+    }
+  }
+  return numNodes;
+}
+
+long PassProfiler::getPeakRSS() {
+#ifdef DAWN_ON_UNIX
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef DAWN_ON_APPLE
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+} // namespace dawn
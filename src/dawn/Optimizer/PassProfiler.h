@@ -0,0 +1,116 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#ifndef DAWN_OPTIMIZER_PASSPROFILER_H
+#define DAWN_OPTIMIZER_PASSPROFILER_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn {
+
+namespace iir {
+class StencilInstantiation;
+}
+
+/// @brief Measurements of a single run of a pass on a stencil instantiation
+/// @ingroup optimizer
+struct PassProfile {
+  /// Name of the pass and of the stencil instantiation it ran on
+  std::string PassName;
+  std::string InstantiationName;
+
+  /// Index of the thread which ran the pass
+  int Thread;
+
+  /// Start (relative to the creation of the profiler) and duration of the run in microseconds
+  double StartTime;
+  double WallTime;
+
+  /// Number of IIR nodes before and after the run
+  int NumNodesBefore;
+  int NumNodesAfter;
+
+  /// Growth of the peak resident set size of the process in KiB
+  long PeakRSSDelta;
+
+  /// Number of derived info computations of the IIR nodes during the run
+  unsigned long NumClearDerivedInfo;
+  unsigned long NumUpdateFromChildren;
+};
+
+/// @brief Collect wall time, IIR size, memory and derived info statistics of the optimizer passes
+///
+/// The profiler is filled by the `PassManager` (see `-profile-passes`) and can be written as a JSON
+/// report or as a Chrome trace-event file (viewable in `chrome://tracing`). Passes may be profiled
+/// concurrently from multiple threads.
+///
+/// @ingroup optimizer
+class PassProfiler : NonCopyable {
+public:
+  enum OutputFormat {
+    OF_Report, ///< JSON report with one entry per run and a summary per pass
+    OF_Trace   ///< Chrome trace-event format
+  };
+
+  /// @brief Profile a single run of a pass (the run ends with the lifetime of the object)
+  class Measurement : NonCopyable {
+    PassProfiler& profiler_;
+    const std::shared_ptr<iir::StencilInstantiation>& instantiation_;
+    PassProfile profile_;
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    Measurement(PassProfiler& profiler, const std::string& passName,
+                const std::shared_ptr<iir::StencilInstantiation>& instantiation);
+    ~Measurement();
+  };
+
+  PassProfiler();
+
+  /// @brief Get the recorded runs (in the order they finished)
+  const std::vector<PassProfile>& getProfiles() const { return profiles_; }
+
+  /// @brief Write the recorded runs to `filename`
+  /// @returns `true` on success, `false` otherwise
+  bool write(const std::string& filename, OutputFormat format) const;
+
+  /// @brief Convert the recorded runs to a string in the given format
+  std::string toString(OutputFormat format) const;
+
+  /// @brief Number of IIR nodes (stencils, multi-stages, stages, do-methods and statements)
+  static int getNumNodes(const iir::StencilInstantiation& instantiation);
+
+  /// @brief Peak resident set size of the process in KiB (0 if unsupported)
+  static long getPeakRSS();
+
+private:
+  void record(PassProfile&& profile);
+
+  std::chrono::steady_clock::time_point origin_;
+  mutable std::mutex mutex_;
+  std::vector<PassProfile> profiles_;
+  std::unordered_map<std::thread::id, int> threadIndices_;
+};
+
+} // namespace dawn
+
+#endif
@@ -38,6 +38,9 @@ bool PassSetBlockSize::run(const std::shared_ptr<iir::StencilInstantiation>& ste
     getline(idomain_size, arg, ',');
     unsigned int kBlockSize = std::stoi(arg);
 
+    // There are no further sizes
+    arg.clear();
+    getline(idomain_size, arg, ',');
     assert(arg.empty());
 
     blockSize = {iBlockSize, jBlockSize, kBlockSize};
@@ -320,8 +320,9 @@ bool PassSetBoundaryCondition::run(
   }
 
   for(const auto& doMethod : iterateIIROver<iir::DoMethod>(*(stencilInstantiation->getIIR()))) {
-    doMethod->update(iir::NodeUpdateType::levelAndTreeAbove);
+    doMethod->markDerivedInfoDirty();
   }
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
 
   OptimizerContext* context = stencilInstantiation->getOptimizerContext();
   // Output
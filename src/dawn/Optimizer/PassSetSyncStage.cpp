@@ -75,8 +75,9 @@ PassSetSyncStage::PassSetSyncStage() : Pass("PassSetSyncStage") {}
 
 bool PassSetSyncStage::run(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
   for(const auto& doMethod : iterateIIROver<iir::DoMethod>(*(instantiation->getIIR()))) {
-    doMethod->update(iir::NodeUpdateType::levelAndTreeAbove);
+    doMethod->markDerivedInfoDirty();
   }
+  instantiation->getIIR()->updateDirtyDerivedInfo();
 
   for(const auto& ms : iterateIIROver<iir::MultiStage>(*(instantiation->getIIR()))) {
     for(const auto& stage : ms->getChildren()) {
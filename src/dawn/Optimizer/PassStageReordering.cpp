@@ -54,13 +54,12 @@ bool PassStageReordering::run(
 
     // TODO should we have Iterators so to prevent unique_ptr swaps
     auto newStencil = strategy->reorder(stencilInstantiation.get(), stencilPtr);
+    if(!newStencil)
+      return false;
 
     stencilInstantiation->getIIR()->replace(stencilPtr, newStencil, stencilInstantiation->getIIR());
 
     stencilPtr->update(iir::NodeUpdateType::levelAndTreeAbove);
-
-    if(!stencilPtr)
-      return false;
   }
   if(context->getOptions().ReportPassStageReodering)
     stencilInstantiation->jsonDump(filenameWE + "_after.json");
@@ -54,20 +54,22 @@ bool PassStageSplitter::run(
         splitterIndices.clear();
         graphs.clear();
 
-        std::shared_ptr<iir::DependencyGraphAccesses> newGraph, oldGraph;
-        newGraph =
+        auto newGraph =
             std::make_shared<iir::DependencyGraphAccesses>(stencilInstantiation->getMetaData());
-        oldGraph = newGraph->clone();
+        ReadBeforeWriteConflictTracker tracker(*newGraph, iir::LoopOrderKind::LK_Parallel);
+
+        // Statements in `(stmtIndex, lastStmtIndexOfGraph]` are contained in the new graph
+        int lastStmtIndexOfGraph = doMethod.getChildren().size() - 1;
 
         // Build the Dependency graph (bottom to top)
         for(int stmtIndex = doMethod.getChildren().size() - 1; stmtIndex >= 0; --stmtIndex) {
           auto& stmtAccessesPair = doMethod.getChildren()[stmtIndex];
 
-          newGraph->insertStatementAccessesPair(stmtAccessesPair);
+          tracker.insertStatementAccessesPair(stmtAccessesPair);
 
           // If we have a horizontal read-before-write conflict, we record the current index for
           // splitting
-          if(hasHorizontalReadBeforeWriteConflict(newGraph.get())) {
+          if(tracker.hasHorizontalConflict()) {
 
             // Check if the conflict is related to a conditional block
             if(isa<IfStmt>(stmtAccessesPair->getStatement()->ASTStmt.get())) {
@@ -87,6 +89,14 @@ bool PassStageSplitter::run(
               }
             }
 
+            // Rebuild the graph without the current statement (this is cheaper than keeping a copy
+            // of the graph before every insertion)
+            auto oldGraph =
+                std::make_shared<iir::DependencyGraphAccesses>(stencilInstantiation->getMetaData());
+            for(int i = lastStmtIndexOfGraph; i > stmtIndex; --i)
+              oldGraph->insertStatementAccessesPair(doMethod.getChildren()[i]);
+            lastStmtIndexOfGraph = stmtIndex;
+
             if(context->getOptions().DumpSplitGraphs)
               oldGraph->toDot(
                   format("stmt_hd_ms%i_s%i_%02i.dot", multiStageIndex, stageIndex, numSplit));
@@ -102,13 +112,11 @@ bool PassStageSplitter::run(
                         << "\n";
 
             // Clear the new graph an process the current statements again
-            newGraph->clear();
-            newGraph->insertStatementAccessesPair(stmtAccessesPair);
+            tracker.clear();
+            tracker.insertStatementAccessesPair(stmtAccessesPair);
 
             numSplit++;
           }
-
-          oldGraph = newGraph->clone();
         }
 
         if(context->getOptions().DumpSplitGraphs)
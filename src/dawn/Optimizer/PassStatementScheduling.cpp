@@ -0,0 +1,284 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PassStatementScheduling.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Support/Assert.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Accesses of a statement relevant for the scheduling
+struct StatementInfo {
+  /// Accessed AccessIDs (sorted)
+  std::vector<int> Reads;
+  std::vector<int> Writes;
+
+  /// Accessed local variables
+  std::vector<int> ReadLocalVariables;
+  std::vector<int> WrittenLocalVariables;
+
+  /// Accessed fields and their extents
+  std::vector<std::pair<int, iir::Extents>> FieldAccesses;
+
+  /// Statements which have to be executed before (resp. after) this statement
+  std::vector<std::size_t> Predecessors;
+  std::vector<std::size_t> Successors;
+};
+
+/// @brief Live range statistics of an order of the statements
+struct ScheduleStatistics {
+  /// Maximum number of simultaneously live local variables
+  int MaxLive = 0;
+
+  /// Number of live local variables summed over all statements
+  int TotalLive = 0;
+
+  /// Field accesses shared by consecutive statements
+  int SharedAccesses = 0;
+
+  bool isBetterThan(const ScheduleStatistics& other) const {
+    if(MaxLive != other.MaxLive)
+      return MaxLive < other.MaxLive;
+    if(TotalLive != other.TotalLive)
+      return TotalLive < other.TotalLive;
+    return SharedAccesses > other.SharedAccesses;
+  }
+};
+
+/// @brief Check if the sorted ranges `a` and `b` have a common element
+bool intersects(const std::vector<int>& a, const std::vector<int>& b) {
+  for(auto itA = a.begin(), itB = b.begin(); itA != a.end() && itB != b.end();) {
+    if(*itA == *itB)
+      return true;
+    if(*itA < *itB)
+      ++itA;
+    else
+      ++itB;
+  }
+  return false;
+}
+
+/// @brief Number of fields accessed by both statements (accesses with the same extents count
+/// twice)
+int computeSharedAccesses(const StatementInfo& a, const StatementInfo& b) {
+  int shared = 0;
+  for(const auto& accessA : a.FieldAccesses)
+    for(const auto& accessB : b.FieldAccesses)
+      if(accessA.first == accessB.first)
+        shared += accessA.second == accessB.second ? 2 : 1;
+  return shared;
+}
+
+std::vector<StatementInfo> computeStatementInfos(const iir::StencilMetaInformation& metadata,
+                                                 const iir::DoMethod& doMethod) {
+  const auto& stmtAccessesPairs = doMethod.getChildren();
+  std::vector<StatementInfo> infos(stmtAccessesPairs.size());
+
+  for(std::size_t i = 0; i < stmtAccessesPairs.size(); ++i) {
+    const auto& accesses = stmtAccessesPairs[i]->getAccesses();
+    StatementInfo& info = infos[i];
+
+    auto insertAccesses = [&](const iir::AccessMap& accessMap, std::vector<int>& accessIDs,
+                              std::vector<int>& localVariables) {
+      for(const auto& accessPair : accessMap) {
+        accessIDs.push_back(accessPair.first);
+        if(metadata.isAccessType(iir::FieldAccessType::FAT_Field, accessPair.first))
+          info.FieldAccesses.push_back(accessPair);
+        else if(metadata.isAccessType(iir::FieldAccessType::FAT_LocalVariable, accessPair.first))
+          localVariables.push_back(accessPair.first);
+      }
+    };
+    insertAccesses(accesses->getReadAccesses(), info.Reads, info.ReadLocalVariables);
+    insertAccesses(accesses->getWriteAccesses(), info.Writes, info.WrittenLocalVariables);
+
+    // Conflicting accesses to the same AccessID keep their order
+    for(std::size_t j = 0; j < i; ++j) {
+      if(intersects(infos[j].Writes, info.Reads) || intersects(infos[j].Writes, info.Writes) ||
+         intersects(infos[j].Reads, info.Writes)) {
+        info.Predecessors.push_back(j);
+        infos[j].Successors.push_back(i);
+      }
+    }
+  }
+  return infos;
+}
+
+ScheduleStatistics computeStatistics(const std::vector<StatementInfo>& infos,
+                                     const std::vector<std::size_t>& order) {
+  // Number of statements reading each local variable which are not yet executed
+  std::unordered_map<int, int> remainingReads;
+  for(const StatementInfo& info : infos)
+    for(int AccessID : info.ReadLocalVariables)
+      remainingReads[AccessID]++;
+
+  ScheduleStatistics statistics;
+  std::unordered_set<int> definedLocalVariables;
+  for(std::size_t pos = 0; pos < order.size(); ++pos) {
+    const StatementInfo& info = infos[order[pos]];
+    for(int AccessID : info.ReadLocalVariables)
+      remainingReads[AccessID]--;
+    definedLocalVariables.insert(info.WrittenLocalVariables.begin(),
+                                 info.WrittenLocalVariables.end());
+
+    int live = std::count_if(definedLocalVariables.begin(), definedLocalVariables.end(),
+                             [&](int AccessID) { return remainingReads[AccessID] > 0; });
+    statistics.MaxLive = std::max(statistics.MaxLive, live);
+    statistics.TotalLive += live;
+
+    if(pos > 0)
+      statistics.SharedAccesses += computeSharedAccesses(infos[order[pos - 1]], info);
+  }
+  return statistics;
+}
+
+/// @brief Greedy list scheduling of the statements
+std::vector<std::size_t> scheduleStatements(const std::vector<StatementInfo>& infos) {
+  std::unordered_map<int, int> remainingReads;
+  for(const StatementInfo& info : infos)
+    for(int AccessID : info.ReadLocalVariables)
+      remainingReads[AccessID]++;
+
+  std::unordered_set<int> definedLocalVariables;
+  std::vector<std::size_t> numUnscheduledPredecessors(infos.size());
+  std::vector<std::size_t> ready;
+  for(std::size_t i = 0; i < infos.size(); ++i) {
+    numUnscheduledPredecessors[i] = infos[i].Predecessors.size();
+    if(numUnscheduledPredecessors[i] == 0)
+      ready.push_back(i);
+  }
+
+  // Number of live ranges started minus the number of live ranges ended by statement `i`
+  auto computeLiveDelta = [&](std::size_t i) {
+    const StatementInfo& info = infos[i];
+    int delta = 0;
+    for(int AccessID : info.WrittenLocalVariables) {
+      bool readByStmt = std::count(info.ReadLocalVariables.begin(),
+                                   info.ReadLocalVariables.end(), AccessID);
+      if(!definedLocalVariables.count(AccessID) && remainingReads[AccessID] - readByStmt > 0)
+        delta++;
+    }
+    for(int AccessID : info.ReadLocalVariables)
+      if(definedLocalVariables.count(AccessID) && remainingReads[AccessID] == 1)
+        delta--;
+    return delta;
+  };
+
+  std::vector<std::size_t> order;
+  while(!ready.empty()) {
+    auto best = ready.begin();
+    int bestDelta = computeLiveDelta(*best);
+    int bestShared = order.empty() ? 0 : computeSharedAccesses(infos[order.back()], infos[*best]);
+
+    for(auto it = std::next(ready.begin()); it != ready.end(); ++it) {
+      int delta = computeLiveDelta(*it);
+      int shared = order.empty() ? 0 : computeSharedAccesses(infos[order.back()], infos[*it]);
+      if(delta < bestDelta || (delta == bestDelta && shared > bestShared) ||
+         (delta == bestDelta && shared == bestShared && *it < *best)) {
+        best = it;
+        bestDelta = delta;
+        bestShared = shared;
+      }
+    }
+
+    std::size_t i = *best;
+    ready.erase(best);
+    order.push_back(i);
+
+    for(int AccessID : infos[i].ReadLocalVariables)
+      remainingReads[AccessID]--;
+    definedLocalVariables.insert(infos[i].WrittenLocalVariables.begin(),
+                                 infos[i].WrittenLocalVariables.end());
+    for(std::size_t successor : infos[i].Successors)
+      if(--numUnscheduledPredecessors[successor] == 0)
+        ready.push_back(successor);
+  }
+
+  DAWN_ASSERT_MSG(order.size() == infos.size(), "cyclic statement dependencies");
+  return order;
+}
+
+void printStatistics(const ScheduleStatistics& statistics) {
+  std::cout << "max live " << statistics.MaxLive << ", total live " << statistics.TotalLive
+            << ", shared accesses " << statistics.SharedAccesses;
+}
+
+} // anonymous namespace
+
+PassStatementScheduling::PassStatementScheduling() : Pass("PassStatementScheduling") {}
+
+bool PassStatementScheduling::run(
+    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+  OptimizerContext* context = stencilInstantiation->getOptimizerContext();
+  if(!context->getOptions().ScheduleStatements)
+    return true;
+
+  bool report = context->getOptions().ReportPassStatementScheduling;
+  const iir::StencilMetaInformation& metadata = stencilInstantiation->getMetaData();
+  int numScheduled = 0;
+
+  for(const auto& doMethodPtr : iterateIIROver<iir::DoMethod>(*(stencilInstantiation->getIIR()))) {
+    iir::DoMethod& doMethod = *doMethodPtr;
+    if(doMethod.getChildren().size() < 2)
+      continue;
+
+    std::vector<StatementInfo> infos = computeStatementInfos(metadata, doMethod);
+
+    std::vector<std::size_t> sourceOrder(infos.size());
+    for(std::size_t i = 0; i < sourceOrder.size(); ++i)
+      sourceOrder[i] = i;
+    std::vector<std::size_t> order = scheduleStatements(infos);
+
+    ScheduleStatistics before = computeStatistics(infos, sourceOrder);
+    ScheduleStatistics after = computeStatistics(infos, order);
+    if(!after.isBetterThan(before))
+      continue;
+
+    if(report) {
+      std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName()
+                << ": Do-Method " << doMethod.getID() << " " << doMethod.getInterval() << ": ";
+      printStatistics(before);
+      std::cout << " -> ";
+      printStatistics(after);
+      std::cout << "\n";
+    }
+
+    std::vector<std::unique_ptr<iir::StatementAccessesPair>> stmtAccessesPairs;
+    for(std::size_t i : order)
+      stmtAccessesPairs.push_back(std::move(*(doMethod.childrenBegin() + i)));
+    std::move(stmtAccessesPairs.begin(), stmtAccessesPairs.end(), doMethod.childrenBegin());
+
+    doMethod.markDerivedInfoDirty();
+    numScheduled++;
+  }
+  stencilInstantiation->getIIR()->updateDirtyDerivedInfo();
+
+  if(report && numScheduled == 0)
+    std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName()
+              << ": no statements reordered\n";
+  return true;
+}
+
+} // namespace dawn
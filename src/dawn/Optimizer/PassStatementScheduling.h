@@ -0,0 +1,47 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PASSSTATEMENTSCHEDULING_H
+#define DAWN_OPTIMIZER_PASSSTATEMENTSCHEDULING_H
+
+#include "dawn/Optimizer/Pass.h"
+
+namespace dawn {
+
+/// @brief Pass to reorder the statements of each Do-Method to reduce the register pressure
+/// @ingroup optimizer
+///
+/// Two statements of a Do-Method depend on each other if one of them writes an AccessID the other
+/// one accesses, which refines the dependency graph of the Do-Method to the statement level. Among
+/// the statements whose dependencies are scheduled, the list scheduler prefers the one which
+///
+///   1. ends the most live ranges of local variables while starting the fewest new ones and
+///   2. accesses the most fields (with the same extents) as the previously scheduled statement.
+///
+/// The new order is only kept if it reduces the maximum number of simultaneously live local
+/// variables or, if that is unchanged, their total live range or the number of shared field
+/// accesses between consecutive statements.
+///
+/// This pass is not necessary to create legal code and is hence not in the debug-group
+class PassStatementScheduling : public Pass {
+public:
+  PassStatementScheduling();
+
+  /// @brief Pass implementation
+  bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+};
+
+} // namespace dawn
+
+#endif
@@ -72,7 +72,7 @@ bool PassTemporaryFirstAccess::run(
   OptimizerContext* context = stencilInstantiation->getOptimizerContext();
 
   for(const auto& stencilPtr : stencilInstantiation->getStencils()) {
-    std::unordered_map<int, iir::Stencil::FieldInfo> fields = stencilPtr->getFields();
+    iir::Stencil::FieldInfoMap fields = stencilPtr->getFields();
     std::set<int> temporaryFields;
 
     auto tempFields = makeRange(
@@ -87,7 +87,7 @@ bool PassTemporaryMerger::run(
           visitedNodes.insert(FromVertexID);
 
         // Follow edges of the current node and update the node extents
-        for(const Edge& edge : *adjacencyList[FromVertexID]) {
+        for(const Edge& edge : adjacencyList[FromVertexID]) {
           std::size_t ToVertexID = edge.ToVertexID;
           int ToAccessID = AccessesDAG.getIDFromVertexID(ToVertexID);
           int newAccessIDOfLastTemporary = AccessIDOfLastTemporary;
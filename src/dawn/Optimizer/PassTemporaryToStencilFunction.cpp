@@ -63,14 +63,14 @@ class LocalVariablePromotion : public ASTVisitorPostOrder, public NonCopyable {
 protected:
   const iir::StencilMetaInformation& metadata_;
   const iir::Stencil& stencil_;
-  const std::unordered_map<int, iir::Stencil::FieldInfo>& fields_;
+  const iir::Stencil::FieldInfoMap& fields_;
   const SkipIDs& skipIDs_;
   std::unordered_set<int>& localVarAccessIDs_;
   bool activate_ = false;
 
 public:
   LocalVariablePromotion(const iir::StencilMetaInformation& metadata, const iir::Stencil& stencil,
-                         const std::unordered_map<int, iir::Stencil::FieldInfo>& fields,
+                         const iir::Stencil::FieldInfoMap& fields,
                          const SkipIDs& skipIDs, std::unordered_set<int>& localVarAccessIDs)
       : metadata_(metadata), stencil_(stencil), fields_(fields), skipIDs_(skipIDs),
         localVarAccessIDs_(localVarAccessIDs) {}
@@ -111,7 +111,7 @@ bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& in
     // Loop over all accesses
     for(const auto& statementAccessesPair :
         iterateIIROver<iir::StatementAccessesPair>(*stencilPtr)) {
-      auto processAccessMap = [&](const std::unordered_map<int, iir::Extents>& accessMap) {
+      auto processAccessMap = [&](const iir::AccessMap& accessMap) {
         for(const auto& AccessIDExtentPair : accessMap) {
           int AccessID = AccessIDExtentPair.first;
           const iir::Extents& extent = AccessIDExtentPair.second;
@@ -0,0 +1,260 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PerformanceModel.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTVisitor.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Support/StringRef.h"
+#include <algorithm>
+#include <stack>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Count the floating point operations of a statement (including the called stencil
+/// functions)
+class FlopCounter : public ASTVisitorForwarding {
+  const iir::StencilMetaInformation& metadata_;
+  int flops_;
+
+  /// Current stencil function call
+  std::stack<std::shared_ptr<const iir::StencilFunctionInstantiation>> stencilFunCalls_;
+
+  static bool isArithmetic(StringRef op) {
+    return op == "+" || op == "-" || op == "*" || op == "/";
+  }
+
+public:
+  FlopCounter(const iir::StencilMetaInformation& metadata) : metadata_(metadata), flops_(0) {}
+
+  int getFlops() const { return flops_; }
+
+  void visit(const std::shared_ptr<UnaryOperator>& expr) override {
+    if(StringRef(expr->getOp()) == "-")
+      flops_++;
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  void visit(const std::shared_ptr<BinaryOperator>& expr) override {
+    if(isArithmetic(expr->getOp()))
+      flops_++;
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  void visit(const std::shared_ptr<AssignmentExpr>& expr) override {
+    // Compound assignments like `a += 5`
+    StringRef op(expr->getOp());
+    if(op.size() == 2 && isArithmetic(op.substr(0, 1)))
+      flops_++;
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  void visit(const std::shared_ptr<FunCallExpr>& expr) override {
+    // Math functions are counted as a single operation
+    flops_++;
+    ASTVisitorForwarding::visit(expr);
+  }
+
+  void visit(const std::shared_ptr<StencilFunCallExpr>& expr) override {
+    stencilFunCalls_.push(stencilFunCalls_.empty()
+                              ? metadata_.getStencilFunctionInstantiation(expr)
+                              : stencilFunCalls_.top()->getStencilFunctionInstantiation(expr));
+    stencilFunCalls_.top()->getAST()->accept(*this);
+    stencilFunCalls_.pop();
+  }
+};
+
+int computeFlops(const iir::StencilMetaInformation& metadata,
+                 const iir::StatementAccessesPair& stmtAccessesPair) {
+  FlopCounter flopCounter(metadata);
+  stmtAccessesPair.getStatement()->ASTStmt->accept(flopCounter);
+  return flopCounter.getFlops();
+}
+
+/// @brief Number of k-levels of `interval` in a domain of `kSize` levels
+int getNumLevels(const iir::Interval& interval, int kSize) {
+  auto getLevel = [&](int levelMark, int offset) {
+    return (levelMark == sir::Interval::End ? kSize - 1 : std::min(levelMark, kSize - 1)) + offset;
+  };
+  int lower = getLevel(interval.lowerLevel(), interval.lowerOffset());
+  int upper = getLevel(interval.upperLevel(), interval.upperOffset());
+  return std::max(0, std::min(kSize, upper - lower + 1));
+}
+
+} // anonymous namespace
+
+double PerformanceEstimate::getArithmeticIntensity() const {
+  return getBytes() > 0 ? Flops / getBytes() : 0;
+}
+
+double PerformanceEstimate::getRuntime() const { return std::max(MemoryTime, ComputeTime); }
+
+PerformanceEstimate& PerformanceEstimate::operator+=(const PerformanceEstimate& other) {
+  BytesRead += other.BytesRead;
+  BytesWritten += other.BytesWritten;
+  CompulsoryBytes += other.CompulsoryBytes;
+  Flops += other.Flops;
+  WorkingSetBytes = std::max(WorkingSetBytes, other.WorkingSetBytes);
+  FitsInCache = FitsInCache && other.FitsInCache;
+  MemoryTime += other.MemoryTime;
+  ComputeTime += other.ComputeTime;
+  return *this;
+}
+
+json::json PerformanceEstimate::jsonDump() const {
+  json::json node;
+  node["bytes_read"] = BytesRead;
+  node["bytes_written"] = BytesWritten;
+  node["compulsory_bytes"] = CompulsoryBytes;
+  node["flops"] = Flops;
+  node["arithmetic_intensity"] = getArithmeticIntensity();
+  node["working_set_bytes"] = WorkingSetBytes;
+  node["fits_in_cache"] = FitsInCache;
+  node["memory_time_us"] = MemoryTime * 1e6;
+  node["compute_time_us"] = ComputeTime * 1e6;
+  node["runtime_us"] = getRuntime() * 1e6;
+  node["bound"] = isMemoryBound() ? "memory" : "compute";
+  return node;
+}
+
+PerformanceModel::PerformanceModel(const HardwareConfig& machine, const Array3i& domain,
+                                   int elementSize)
+    : machine_(machine), domain_(domain), elementSize_(elementSize) {}
+
+PerformanceEstimate PerformanceModel::estimate(const iir::StencilInstantiation& instantiation,
+                                               const iir::MultiStage& multiStage) const {
+  PerformanceEstimate estimate;
+  const iir::StencilMetaInformation& metadata = instantiation.getMetaData();
+
+  // Memory traffic of each field on its domain extended by the redundant halo
+  auto readWrites = computeReadWriteAccessesMetricPerAccessID(instantiation, multiStage);
+  double compulsoryBytesRead = 0, compulsoryBytesWritten = 0;
+  for(const auto& fieldPair : multiStage.getFields()) {
+    auto it = readWrites.find(fieldPair.first);
+    if(it == readWrites.end())
+      continue;
+
+    const iir::Extents& extents = fieldPair.second.getExtentsRB();
+    double numPlanePoints = static_cast<double>(domain_[0] + extents[0].Plus - extents[0].Minus) *
+                            (domain_[1] + extents[1].Plus - extents[1].Minus);
+    double fieldBytes = numPlanePoints * domain_[2] * elementSize_;
+
+    estimate.BytesRead += it->second.numReads * fieldBytes;
+    estimate.BytesWritten += it->second.numWrites * fieldBytes;
+    compulsoryBytesRead += (it->second.numReads > 0) * fieldBytes;
+    compulsoryBytesWritten += (it->second.numWrites > 0) * fieldBytes;
+    estimate.WorkingSetBytes +=
+        numPlanePoints * (extents[2].Plus - extents[2].Minus + 1) * elementSize_;
+  }
+  estimate.CompulsoryBytes = compulsoryBytesRead + compulsoryBytesWritten;
+
+  // If the k-levels accessed by the stencil fit into the cache, the offset accesses are hits
+  estimate.FitsInCache = estimate.WorkingSetBytes <= machine_.CacheSize * 1024.0;
+  if(estimate.FitsInCache) {
+    estimate.BytesRead = compulsoryBytesRead;
+    estimate.BytesWritten = compulsoryBytesWritten;
+  }
+
+  // Flops of each statement on the extended domain of its stage
+  for(const auto& stagePtr : multiStage.getChildren()) {
+    const iir::Extents& extents = stagePtr->getExtents();
+    double numPlanePoints = static_cast<double>(domain_[0] + extents[0].Plus - extents[0].Minus) *
+                            (domain_[1] + extents[1].Plus - extents[1].Minus);
+
+    for(const auto& doMethodPtr : stagePtr->getChildren()) {
+      int numLevels = getNumLevels(doMethodPtr->getInterval(), domain_[2]);
+      for(const auto& stmtAccessesPair : doMethodPtr->getChildren())
+        estimate.Flops += numPlanePoints * numLevels * computeFlops(metadata, *stmtAccessesPair);
+    }
+  }
+
+  estimate.MemoryTime = estimate.getBytes() / (machine_.Bandwidth * 1e9);
+  estimate.ComputeTime = estimate.Flops / (machine_.PeakFlops * 1e9);
+  return estimate;
+}
+
+PerformanceEstimate PerformanceModel::estimate(const iir::StencilInstantiation& instantiation,
+                                               const iir::Stencil& stencil) const {
+  PerformanceEstimate estimate;
+  for(const auto& multiStagePtr : stencil.getChildren())
+    estimate += this->estimate(instantiation, *multiStagePtr);
+  return estimate;
+}
+
+json::json PerformanceModel::jsonDump(const iir::StencilInstantiation& instantiation) const {
+  json::json node;
+  node["name"] = instantiation.getName();
+
+  PerformanceEstimate instantiationEstimate;
+  auto stencilsArray = json::json::array();
+  for(const auto& stencilPtr : instantiation.getStencils()) {
+    json::json stencilNode;
+    stencilNode["id"] = stencilPtr->getStencilID();
+
+    PerformanceEstimate stencilEstimate;
+    auto multiStagesArray = json::json::array();
+    for(const auto& multiStagePtr : stencilPtr->getChildren()) {
+      PerformanceEstimate multiStageEstimate = estimate(instantiation, *multiStagePtr);
+      stencilEstimate += multiStageEstimate;
+
+      json::json multiStageNode = multiStageEstimate.jsonDump();
+      multiStageNode["id"] = multiStagePtr->getID();
+      multiStageNode["loop_order"] = loopOrderToString(multiStagePtr->getLoopOrder());
+      multiStageNode["num_caches"] = multiStagePtr->getCaches().size();
+      multiStagesArray.push_back(multiStageNode);
+    }
+    instantiationEstimate += stencilEstimate;
+
+    stencilNode["multistages"] = multiStagesArray;
+    stencilNode["total"] = stencilEstimate.jsonDump();
+    stencilsArray.push_back(stencilNode);
+  }
+  node["stencils"] = stencilsArray;
+  node["total"] = instantiationEstimate.jsonDump();
+  return node;
+}
+
+json::json PerformanceModel::jsonDump(
+    const std::map<std::string, std::shared_ptr<iir::StencilInstantiation>>& instantiations)
+    const {
+  json::json node;
+  node["machine"]["bandwidth_gbs"] = machine_.Bandwidth;
+  node["machine"]["peak_gflops"] = machine_.PeakFlops;
+  node["machine"]["cache_size_kib"] = machine_.CacheSize;
+  node["machine"]["ridge_point"] = machine_.PeakFlops / machine_.Bandwidth;
+  node["domain"] = domain_;
+  node["element_size"] = elementSize_;
+
+  auto instantiationsArray = json::json::array();
+  for(const auto& instantiationPair : instantiations)
+    instantiationsArray.push_back(jsonDump(*instantiationPair.second));
+  node["stencil_instantiations"] = instantiationsArray;
+  return node;
+}
+
+int computeFlopsPerGridPoint(const iir::StencilInstantiation& instantiation,
+                             const iir::MultiStage& multiStage) {
+  int flops = 0;
+  for(const auto& stmtAccessesPair : iterateIIROver<iir::StatementAccessesPair>(multiStage))
+    flops += computeFlops(instantiation.getMetaData(), *stmtAccessesPair);
+  return flops;
+}
+
+} // namespace dawn
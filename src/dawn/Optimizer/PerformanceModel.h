@@ -0,0 +1,119 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PERFORMANCEMODEL_H
+#define DAWN_OPTIMIZER_PERFORMANCEMODEL_H
+
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Support/Array.h"
+#include "dawn/Support/Json.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace dawn {
+
+namespace iir {
+class MultiStage;
+class Stencil;
+class StencilInstantiation;
+} // namespace iir
+
+/// @brief Estimated cost of executing a multi-stage (or a sequence of multi-stages)
+/// @ingroup optimizer
+struct PerformanceEstimate {
+  /// Bytes moved from and to main memory
+  double BytesRead = 0;
+  double BytesWritten = 0;
+
+  /// Bytes moved if every field is loaded (resp. stored) only once, i.e all the offset accesses
+  /// are served from the cache
+  double CompulsoryBytes = 0;
+
+  /// Floating point operations
+  double Flops = 0;
+
+  /// Bytes accessed in a single k-level (including the redundant halos), if this exceeds the
+  /// cache the offset accesses go to main memory
+  double WorkingSetBytes = 0;
+  bool FitsInCache = true;
+
+  /// Predicted execution time in seconds
+  double MemoryTime = 0;
+  double ComputeTime = 0;
+
+  double getBytes() const { return BytesRead + BytesWritten; }
+
+  /// @brief Flops per byte moved from or to main memory
+  double getArithmeticIntensity() const;
+
+  /// @brief Predicted runtime (maximum of the memory and compute time) in seconds
+  double getRuntime() const;
+
+  /// @brief Check if the runtime is bound by the memory bandwidth
+  bool isMemoryBound() const { return MemoryTime >= ComputeTime; }
+
+  /// @brief Accumulate the estimate of a subsequent execution
+  PerformanceEstimate& operator+=(const PerformanceEstimate& other);
+
+  json::json jsonDump() const;
+};
+
+/// @brief Analytic roofline model of the stencils
+///
+/// The memory traffic of a multi-stage is derived from the data-locality metric (see
+/// `computeReadWriteAccessesMetricPerAccessID`), which accounts for the caches of the multi-stage,
+/// applied to the domain of each field extended by its redundant halo (`Field::getExtentsRB`). If
+/// the working set of a k-level fits into the cache of the machine only the compulsory traffic is
+/// charged. The flops are counted from the statements (arithmetic operators and function calls
+/// count as one flop each) executed on the extended domain of their stage and the vertical
+/// interval of their Do-Method.
+///
+/// @ingroup optimizer
+class PerformanceModel {
+  HardwareConfig machine_;
+  Array3i domain_;
+  int elementSize_;
+
+public:
+  /// @brief Model the execution on `machine` for a compute domain of size `domain` of fields whose
+  /// elements have `elementSize` bytes
+  PerformanceModel(const HardwareConfig& machine, const Array3i& domain,
+                   int elementSize = sizeof(double));
+
+  /// @brief Estimate the cost of a multi-stage
+  PerformanceEstimate estimate(const iir::StencilInstantiation& instantiation,
+                               const iir::MultiStage& multiStage) const;
+
+  /// @brief Estimate the cost of a stencil (sum of its multi-stages)
+  PerformanceEstimate estimate(const iir::StencilInstantiation& instantiation,
+                               const iir::Stencil& stencil) const;
+
+  /// @brief Convert the estimates of the stencils and multi-stages of `instantiation` to JSON
+  json::json jsonDump(const iir::StencilInstantiation& instantiation) const;
+
+  /// @brief Convert the estimates of all stencil instantiations (and the machine description) to
+  /// JSON
+  json::json
+  jsonDump(const std::map<std::string, std::shared_ptr<iir::StencilInstantiation>>&
+               instantiations) const;
+};
+
+/// @brief Number of floating point operations per grid point of a multi-stage
+int computeFlopsPerGridPoint(const iir::StencilInstantiation& instantiation,
+                             const iir::MultiStage& multiStage);
+
+} // namespace dawn
+
+#endif
@@ -15,6 +15,7 @@
 #include "dawn/Optimizer/ReadBeforeWriteConflict.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
 #include "dawn/IIR/Extents.h"
+#include "dawn/IIR/StatementAccessesPair.h"
 #include "dawn/Support/Assert.h"
 #include <unordered_set>
 #include <utility>
@@ -78,13 +79,13 @@ private:
         visitedNodes.insert(curNode);
 
       // Follow edges of the current node
-      if(!adjacencyList[curNode]->empty()) {
-        for(const auto& edge : *adjacencyList[curNode]) {
+      if(!adjacencyList[curNode].empty()) {
+        for(const auto& edge : adjacencyList[curNode]) {
           const iir::Extents& extent = edge.Data;
 
           if(IsVertical) {
 
-            if(!adjacencyList[edge.ToVertexID]->empty()) {
+            if(!adjacencyList[edge.ToVertexID].empty()) {
 
               // We have an outgoing edge to a non-input field, check the vertical accesses
               auto verticalLoopOrderAccess = extent.getVerticalLoopOrderAccesses(loopOrder_);
@@ -107,7 +108,7 @@ private:
             if(!extent.isHorizontalPointwise()) {
 
               // ... to a non-input field (i.e an intermediate field or variable)
-              if(!adjacencyList[edge.ToVertexID]->empty()) {
+              if(!adjacencyList[edge.ToVertexID].empty()) {
                 // We have a read-after-write conflict -> exit
                 return ReadBeforeWriteConflict(true, true);
               }
@@ -151,4 +152,99 @@ bool hasHorizontalReadBeforeWriteConflict(const iir::DependencyGraphAccesses* gr
       .LoopOrderConflict;
 }
 
+ReadBeforeWriteConflictTracker::ReadBeforeWriteConflictTracker(iir::DependencyGraphAccesses& graph,
+                                                               iir::LoopOrderKind loopOrder)
+    : graph_(graph), loopOrder_(loopOrder), numLoopOrderConflicts_(0),
+      numCounterLoopOrderConflicts_(0), numHorizontalConflicts_(0) {
+  DAWN_ASSERT_MSG(graph_.empty(), "conflicts can only be tracked from an empty graph");
+}
+
+void ReadBeforeWriteConflictTracker::insertStatementAccessesPair(
+    const std::unique_ptr<iir::StatementAccessesPair>& stmtAccessPair) {
+
+  // Mirrors DependencyGraphAccesses::insertStatementAccessesPair
+  if(stmtAccessPair->hasBlockStatements()) {
+    for(const auto& s : stmtAccessPair->getBlockStatements())
+      insertStatementAccessesPair(s);
+  } else {
+
+    for(const auto& writeAccess : stmtAccessPair->getAccesses()->getWriteAccesses()) {
+      graph_.insertNode(writeAccess.first);
+
+      for(const auto& readAccess : stmtAccessPair->getAccesses()->getReadAccesses())
+        insertEdge(writeAccess.first, readAccess.first, readAccess.second);
+    }
+  }
+}
+
+void ReadBeforeWriteConflictTracker::insertEdge(int AccessIDFrom, int AccessIDTo,
+                                                const iir::Extents& extent) {
+  graph_.insertEdge(AccessIDFrom, AccessIDTo, extent);
+
+  std::size_t FromVertexID = graph_.getVertexIDFromValue(AccessIDFrom);
+  std::size_t ToVertexID = graph_.getVertexIDFromValue(AccessIDTo);
+  if(incomingEdges_.size() < graph_.getNumVertices())
+    incomingEdges_.resize(graph_.getNumVertices());
+
+  // A new edge is registered as incoming edge of `To`. If it is the first outgoing edge of `From`,
+  // `From` is no longer an input vertex which changes the conflicts of its incoming edges.
+  std::uint64_t edgeKey = iir::DependencyGraphAccesses::getEdgeKey(FromVertexID, ToVertexID);
+  bool isNewEdge = !edgeConflicts_.count(edgeKey);
+  if(isNewEdge)
+    incomingEdges_[ToVertexID].push_back(FromVertexID);
+
+  updateEdge(FromVertexID, ToVertexID);
+
+  if(isNewEdge && graph_.getAdjacencyList()[FromVertexID].size() == 1)
+    for(std::size_t VertexID : incomingEdges_[FromVertexID])
+      updateEdge(VertexID, FromVertexID);
+}
+
+void ReadBeforeWriteConflictTracker::updateEdge(std::size_t FromVertexID, std::size_t ToVertexID) {
+  const auto* edge = graph_.getEdge(FromVertexID, ToVertexID);
+  DAWN_ASSERT(edge);
+
+  // Only edges to non-input vertices can be conflicts (see ReadBeforeWriteConflictDetector)
+  EdgeConflict conflict{VC_None, false};
+  if(!graph_.getAdjacencyList()[ToVertexID].empty()) {
+    auto verticalLoopOrderAccess = edge->Data.getVerticalLoopOrderAccesses(loopOrder_);
+    if(verticalLoopOrderAccess.CounterLoopOrder)
+      conflict.Vertical = VC_CounterLoopOrder;
+    else if(verticalLoopOrderAccess.LoopOrder)
+      conflict.Vertical = VC_LoopOrder;
+
+    conflict.Horizontal = !edge->Data.isHorizontalPointwise();
+  }
+
+  auto insertPair = edgeConflicts_.emplace(
+      iir::DependencyGraphAccesses::getEdgeKey(FromVertexID, ToVertexID), conflict);
+  EdgeConflict& oldConflict = insertPair.first->second;
+  if(!insertPair.second) {
+    numLoopOrderConflicts_ -= oldConflict.Vertical == VC_LoopOrder;
+    numCounterLoopOrderConflicts_ -= oldConflict.Vertical == VC_CounterLoopOrder;
+    numHorizontalConflicts_ -= oldConflict.Horizontal;
+    oldConflict = conflict;
+  }
+  numLoopOrderConflicts_ += conflict.Vertical == VC_LoopOrder;
+  numCounterLoopOrderConflicts_ += conflict.Vertical == VC_CounterLoopOrder;
+  numHorizontalConflicts_ += conflict.Horizontal;
+}
+
+void ReadBeforeWriteConflictTracker::clear() {
+  graph_.clear();
+  edgeConflicts_.clear();
+  incomingEdges_.clear();
+  numLoopOrderConflicts_ = 0;
+  numCounterLoopOrderConflicts_ = 0;
+  numHorizontalConflicts_ = 0;
+}
+
+ReadBeforeWriteConflict ReadBeforeWriteConflictTracker::getVerticalConflict() const {
+  return ReadBeforeWriteConflict(numLoopOrderConflicts_ > 0, numCounterLoopOrderConflicts_ > 0);
+}
+
+bool ReadBeforeWriteConflictTracker::hasHorizontalConflict() const {
+  return numHorizontalConflicts_ > 0;
+}
+
 } // namespace dawn
@@ -16,11 +16,17 @@
 #define DAWN_OPTIMITZER_READBEFOREWRITECONFLICT_H
 
 #include "dawn/IIR/LoopOrder.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace dawn {
 
 namespace iir {
 class DependencyGraphAccesses;
+class Extents;
+class StatementAccessesPair;
 }
 
 /// @brief Result of the vertical dependency analysis algorithm
@@ -105,6 +111,72 @@ hasVerticalReadBeforeWriteConflict(const iir::DependencyGraphAccesses* graph,
 /// @ingroup optimizer
 extern bool hasHorizontalReadBeforeWriteConflict(const iir::DependencyGraphAccesses* graph);
 
+/// @brief Incrementally maintained read-before-write conflicts of a growing dependency graph
+///
+/// Statements are inserted into the graph through the tracker which updates the conflicts by only
+/// re-examining the edges affected by the insertion: the new (or merged) edges of the statement and
+/// the incoming edges of vertices which are written for the first time (and thus stop being input
+/// vertices). Inserting `N` statements and querying after each one is therefore linear in the
+/// number of accesses instead of quadratic.
+///
+/// The conflicts are those reported by `hasVerticalReadBeforeWriteConflict` and
+/// `hasHorizontalReadBeforeWriteConflict`, except that edges within cycles which cannot be reached
+/// from any output vertex are checked as well (the graph based functions skip them).
+///
+/// @ingroup optimizer
+class ReadBeforeWriteConflictTracker {
+public:
+  /// @brief Track the conflicts of `graph` (which is expected to be empty)
+  ///
+  /// @param graph      Graph to insert the statements into
+  /// @param loopOrder  Loop order used to classify the vertical accesses
+  ReadBeforeWriteConflictTracker(iir::DependencyGraphAccesses& graph,
+                                 iir::LoopOrderKind loopOrder);
+
+  /// @brief Insert the StatementAccessesPair into the graph and update the conflicts
+  ///
+  /// @see iir::DependencyGraphAccesses::insertStatementAccessesPair
+  void
+  insertStatementAccessesPair(const std::unique_ptr<iir::StatementAccessesPair>& stmtAccessPair);
+
+  /// @brief Clear the graph and the conflicts
+  void clear();
+
+  /// @brief Get the vertical read-before-write conflicts of the graph
+  ReadBeforeWriteConflict getVerticalConflict() const;
+
+  /// @brief Check for horizontal read-before-write conflicts in the graph
+  bool hasHorizontalConflict() const;
+
+  /// @brief Get the tracked graph
+  const iir::DependencyGraphAccesses& getGraph() const { return graph_; }
+
+private:
+  enum VerticalConflictKind { VC_None, VC_LoopOrder, VC_CounterLoopOrder };
+
+  /// @brief Conflicts contributed by a single edge
+  struct EdgeConflict {
+    VerticalConflictKind Vertical;
+    bool Horizontal;
+  };
+
+  void insertEdge(int AccessIDFrom, int AccessIDTo, const iir::Extents& extent);
+  void updateEdge(std::size_t FromVertexID, std::size_t ToVertexID);
+
+  iir::DependencyGraphAccesses& graph_;
+  iir::LoopOrderKind loopOrder_;
+
+  /// Conflicts of each edge keyed by its (FromVertexID, ToVertexID) pair
+  std::unordered_map<std::uint64_t, EdgeConflict> edgeConflicts_;
+
+  /// FromVertexIDs of the incoming edges of each vertex
+  std::vector<std::vector<std::size_t>> incomingEdges_;
+
+  int numLoopOrderConflicts_;
+  int numCounterLoopOrderConflicts_;
+  int numHorizontalConflicts_;
+};
+
 } // namespace dawn
 
 #endif
@@ -0,0 +1,78 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/ReorderStrategy.h"
+#include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/MultiStage.h"
+#include "dawn/IIR/Stage.h"
+#include "dawn/Optimizer/ReadBeforeWriteConflict.h"
+#include <vector>
+
+namespace dawn {
+
+std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>
+isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
+           const iir::MultiStage& multiStage) {
+  using ReturnType = std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>;
+  iir::LoopOrderKind multiStageLoopOrder = multiStage.getLoopOrder();
+  auto multiStageDependencyGraph =
+      multiStage.getDependencyGraphOfInterval(stage.getEnclosingExtendedInterval());
+
+  // Merge stage into dependency graph
+  const iir::DoMethod& doMethod = stage.getSingleDoMethod();
+  multiStageDependencyGraph->merge(doMethod.getDependencyGraph().get());
+
+  // Try all possible loop orders while *favoring* a parallel loop order. Note that a parallel loop
+  // order can be changed to forward or backward.
+  //
+  //                 MULTI-STAGE
+  //
+  //             |  P  |  F  |  B  |           P = Parallel
+  //        -----+-----+-----+-----+           F = Foward
+  //    S     P  | PFB    F     B  |           B = Backward
+  //    T   -----+                 +           X = Incompatible
+  //    A     F  |  F     F     X  |
+  //    G   -----+                 +
+  //    E     B  |  B     X     B  |
+  //        -----+-----------------+
+  //
+  std::vector<iir::LoopOrderKind> possibleLoopOrders;
+
+  if(multiStageLoopOrder == iir::LoopOrderKind::LK_Parallel &&
+     stageLoopOrder == iir::LoopOrderKind::LK_Parallel)
+    possibleLoopOrders = {iir::LoopOrderKind::LK_Parallel, iir::LoopOrderKind::LK_Forward,
+                          iir::LoopOrderKind::LK_Backward};
+  else if(stageLoopOrder == iir::LoopOrderKind::LK_Parallel)
+    possibleLoopOrders.push_back(multiStageLoopOrder);
+  else
+    possibleLoopOrders.push_back(stageLoopOrder);
+
+  if(multiStageDependencyGraph->empty())
+    return ReturnType(multiStageDependencyGraph, possibleLoopOrders.front());
+
+  // If the resulting graph isn't a DAG anymore that isn't gonna work
+  if(!multiStageDependencyGraph->isDAG())
+    return ReturnType(nullptr, multiStageLoopOrder);
+
+  // Check all possible loop orders if there aren't any vertical conflicts
+  for(auto loopOrder : possibleLoopOrders) {
+    auto conflict = hasVerticalReadBeforeWriteConflict(multiStageDependencyGraph.get(), loopOrder);
+    if(!conflict.CounterLoopOrderConflict)
+      return ReturnType(multiStageDependencyGraph, loopOrder);
+  }
+
+  return ReturnType(nullptr, multiStageLoopOrder);
+}
+
+} // namespace dawn
@@ -15,7 +15,9 @@
 #ifndef DAWN_OPTIMIZER_REORDERSTRATEGY_H
 #define DAWN_OPTIMIZER_REORDERSTRATEGY_H
 
+#include "dawn/IIR/LoopOrder.h"
 #include <memory>
+#include <utility>
 
 namespace dawn {
 
@@ -23,6 +25,9 @@ namespace iir {
 class Stencil;
 class StencilInstantiation;
 class DependencyGraphStage;
+class DependencyGraphAccesses;
+class MultiStage;
+class Stage;
 } // namespace iir
 
 /// @brief Abstract class for various reodering strategies
@@ -47,6 +52,13 @@ public:
           const std::unique_ptr<iir::Stencil>& stencilPtr) = 0;
 };
 
+/// @brief Check if we can merge the stage into the multi-stage, possibly changing the loop order.
+/// @returns the new dependency graph of the multi-stage (or NULL) and the new loop order
+/// @ingroup optimizer
+extern std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>
+isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
+           const iir::MultiStage& multiStage);
+
 } // namespace dawn
 
 #endif
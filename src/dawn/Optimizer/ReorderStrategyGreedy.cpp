@@ -27,62 +27,6 @@
 
 namespace dawn {
 
-/// @brief Check if we can merge the stage into the multi-stage, possibly changing the loop order.
-/// @returns the the enew dependency graphs of the multi-stage (or NULL) and the new loop order
-template <typename ReturnType =
-              std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>>
-ReturnType isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
-                      const iir::MultiStage& multiStage) {
-  iir::LoopOrderKind multiStageLoopOrder = multiStage.getLoopOrder();
-  auto multiStageDependencyGraph =
-      multiStage.getDependencyGraphOfInterval(stage.getEnclosingExtendedInterval());
-
-  // Merge stage into dependency graph
-  const iir::DoMethod& doMethod = stage.getSingleDoMethod();
-  multiStageDependencyGraph->merge(doMethod.getDependencyGraph().get());
-
-  // Try all possible loop orders while *favoring* a parallel loop order. Note that a parallel loop
-  // order can be changed to forward or backward.
-  //
-  //                 MULTI-STAGE
-  //
-  //             |  P  |  F  |  B  |           P = Parallel
-  //        -----+-----+-----+-----+           F = Foward
-  //    S     P  | PFB    F     B  |           B = Backward
-  //    T   -----+                 +           X = Incompatible
-  //    A     F  |  F     F     X  |
-  //    G   -----+                 +
-  //    E     B  |  B     X     B  |
-  //        -----+-----------------+
-  //
-  std::vector<iir::LoopOrderKind> possibleLoopOrders;
-
-  if(multiStageLoopOrder == iir::LoopOrderKind::LK_Parallel &&
-     stageLoopOrder == iir::LoopOrderKind::LK_Parallel)
-    possibleLoopOrders = {iir::LoopOrderKind::LK_Parallel, iir::LoopOrderKind::LK_Forward,
-                          iir::LoopOrderKind::LK_Backward};
-  else if(stageLoopOrder == iir::LoopOrderKind::LK_Parallel)
-    possibleLoopOrders.push_back(multiStageLoopOrder);
-  else
-    possibleLoopOrders.push_back(stageLoopOrder);
-
-  if(multiStageDependencyGraph->empty())
-    return ReturnType(multiStageDependencyGraph, possibleLoopOrders.front());
-
-  // If the resulting graph isn't a DAG anymore that isn't gonna work
-  if(!multiStageDependencyGraph->isDAG())
-    return ReturnType(nullptr, multiStageLoopOrder);
-
-  // Check all possible loop orders if there aren't any vertical conflicts
-  for(auto loopOrder : possibleLoopOrders) {
-    auto conflict = hasVerticalReadBeforeWriteConflict(multiStageDependencyGraph.get(), loopOrder);
-    if(!conflict.CounterLoopOrderConflict)
-      return ReturnType(multiStageDependencyGraph, loopOrder);
-  }
-
-  return ReturnType(nullptr, multiStageLoopOrder);
-}
-
 std::unique_ptr<iir::Stencil>
 ReoderStrategyGreedy::reorder(iir::StencilInstantiation* instantiation,
                               const std::unique_ptr<iir::Stencil>& stencilPtr) {
@@ -14,16 +14,280 @@
 
 #include "dawn/Optimizer/ReorderStrategyPartitioning.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/DependencyGraphStage.h"
+#include "dawn/IIR/MultiStage.h"
+#include "dawn/IIR/Stencil.h"
 #include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/BoundaryExtent.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace dawn {
 
+namespace {
+
+/// @brief Stage to be reordered
+struct StageInfo {
+  const iir::Stage* Stage;             ///< The stage itself
+  iir::LoopOrderKind LoopOrder;        ///< Loop order of the original multi-stage of the stage
+  std::set<int> AccessIDs;             ///< Fields accessed by the stage
+  std::set<int> Partitions;            ///< Sub-graphs of the access graph touched by the stage
+  std::vector<std::size_t> DependsOn;  ///< Stages (indices) this stage depends on
+};
+
+/// @brief Partitioning of a sequence of stages into multi-stages
+struct Partitioning {
+  /// Multi-stages given as pair of (begin, end) indices into the sequence and loop order
+  std::vector<std::pair<std::pair<std::size_t, std::size_t>, iir::LoopOrderKind>> MultiStages;
+
+  /// Estimated number of main memory accesses
+  long Cost = std::numeric_limits<long>::max();
+
+  bool isLegal() const { return Cost != std::numeric_limits<long>::max(); }
+
+  bool operator<(const Partitioning& other) const {
+    return Cost != other.Cost ? Cost < other.Cost
+                              : MultiStages.size() < other.MultiStages.size();
+  }
+};
+
+template <class T>
+static std::size_t countCommonElements(const std::set<T>& a, const std::set<T>& b) {
+  std::size_t count = 0;
+  for(const T& elem : a)
+    count += b.count(elem);
+  return count;
+}
+
+/// @brief Compute a topological order of the stages which favors data-locality
+///
+/// Among all stages whose dependencies are satisfied, we pick the stage which belongs to the same
+/// sub-graph of the access graph as the previously scheduled stage and shares the most fields with
+/// it. Ties are broken by the original order of the stages.
+std::vector<std::size_t> computeLocalityOrder(const std::vector<StageInfo>& stages) {
+  const std::size_t numStages = stages.size();
+  std::vector<std::size_t> order;
+  std::vector<bool> scheduled(numStages, false);
+
+  std::vector<std::size_t> numUnscheduledDependencies(numStages);
+  for(std::size_t i = 0; i < numStages; ++i)
+    numUnscheduledDependencies[i] = stages[i].DependsOn.size();
+
+  while(order.size() != numStages) {
+    std::size_t best = numStages;
+    std::pair<std::size_t, std::size_t> bestScore(0, 0);
+
+    for(std::size_t i = 0; i < numStages; ++i) {
+      if(scheduled[i] || numUnscheduledDependencies[i] != 0)
+        continue;
+
+      std::pair<std::size_t, std::size_t> score(0, 0);
+      if(!order.empty()) {
+        const StageInfo& last = stages[order.back()];
+        score = std::make_pair(countCommonElements(stages[i].Partitions, last.Partitions) != 0,
+                               countCommonElements(stages[i].AccessIDs, last.AccessIDs));
+      }
+
+      if(best == numStages || score > bestScore) {
+        best = i;
+        bestScore = score;
+      }
+    }
+    DAWN_ASSERT_MSG(best != numStages, "stage dependency graph contains cycles");
+
+    scheduled[best] = true;
+    order.push_back(best);
+    for(std::size_t i = 0; i < numStages; ++i)
+      for(std::size_t dependency : stages[i].DependsOn)
+        if(dependency == best)
+          numUnscheduledDependencies[i]--;
+  }
+  return order;
+}
+
+/// @brief Find the partitioning of `order` into multi-stages of consecutive stages with minimal
+/// cost
+///
+/// `bestCost[j]` is the minimal cost of the first `j` stages of the sequence. For every start `i`
+/// we grow a multi-stage stage by stage until merging is no longer legal, which yields the cost of
+/// all legal multi-stages `[i, j)`. The cost of a multi-stage is given by the data-locality metric,
+/// where temporaries which are only accessed within the multi-stage are assumed to be cached (see
+/// `PassSetCaches`) and hence do not cause any main memory traffic.
+///
+/// @returns the partitioning or an illegal partitioning if a single stage exceeds the maximum
+/// number of halo points
+Partitioning computePartitioning(iir::StencilInstantiation& instantiation,
+                                 const std::vector<StageInfo>& stages,
+                                 const std::vector<std::size_t>& order) {
+  iir::StencilMetaInformation& metadata = instantiation.getMetaData();
+  const int maxBoundaryExtent = instantiation.getOptimizerContext()->getOptions().MaxHaloPoints;
+  const long infinity = std::numeric_limits<long>::max();
+
+  const std::size_t numStages = order.size();
+  std::vector<long> bestCost(numStages + 1, infinity);
+  std::vector<std::size_t> bestNumMultiStages(numStages + 1, 0);
+  std::vector<std::size_t> bestBegin(numStages + 1, 0);
+  std::vector<iir::LoopOrderKind> bestLoopOrder(numStages + 1, iir::LoopOrderKind::LK_Parallel);
+  bestCost[0] = 0;
+
+  // First and last position in `order` of the stages accessing each temporary
+  std::unordered_map<int, std::pair<std::size_t, std::size_t>> temporaryLifetimes;
+  for(std::size_t pos = 0; pos < numStages; ++pos) {
+    for(int AccessID : stages[order[pos]].AccessIDs) {
+      if(!metadata.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, AccessID))
+        continue;
+      auto it = temporaryLifetimes.emplace(AccessID, std::make_pair(pos, pos)).first;
+      it->second.second = pos;
+    }
+  }
+
+  for(std::size_t i = 0; i < numStages; ++i) {
+    if(bestCost[i] == infinity)
+      continue;
+
+    auto multiStage = make_unique<iir::MultiStage>(metadata, iir::LoopOrderKind::LK_Parallel);
+    for(std::size_t j = i; j < numStages; ++j) {
+      const StageInfo& stage = stages[order[j]];
+
+      if(!loopOrdersAreCompatible(stage.LoopOrder, multiStage->getLoopOrder()))
+        break;
+
+      auto dependencyGraphLoopOrderPair = isMergable(*stage.Stage, stage.LoopOrder, *multiStage);
+      auto multiStageDependencyGraph = dependencyGraphLoopOrderPair.first;
+      if(!multiStageDependencyGraph ||
+         exceedsMaxBoundaryPoints(multiStageDependencyGraph.get(), maxBoundaryExtent)) {
+        // Merging a stage into an empty multi-stage only fails if the stage itself exceeds the
+        // maximum number of halo points
+        if(j == i)
+          return Partitioning();
+        break;
+      }
+
+      multiStage->setLoopOrder(dependencyGraphLoopOrderPair.second);
+      multiStage->insertChild(stage.Stage->clone());
+      multiStage->update(iir::NodeUpdateType::level);
+
+      long cost = bestCost[i];
+      for(const auto& AccessIDReadWritePair :
+          computeReadWriteAccessesMetricPerAccessID(instantiation, *multiStage)) {
+        auto it = temporaryLifetimes.find(AccessIDReadWritePair.first);
+        if(it != temporaryLifetimes.end() && it->second.first >= i && it->second.second <= j)
+          continue;
+        cost += AccessIDReadWritePair.second.totalAccesses();
+      }
+      std::size_t numMultiStages = bestNumMultiStages[i] + 1;
+
+      if(cost < bestCost[j + 1] ||
+         (cost == bestCost[j + 1] && numMultiStages < bestNumMultiStages[j + 1])) {
+        bestCost[j + 1] = cost;
+        bestNumMultiStages[j + 1] = numMultiStages;
+        bestBegin[j + 1] = i;
+        bestLoopOrder[j + 1] = multiStage->getLoopOrder();
+      }
+    }
+  }
+
+  DAWN_ASSERT_MSG(bestCost[numStages] != infinity, "stages cannot be partitioned");
+
+  Partitioning partitioning;
+  partitioning.Cost = bestCost[numStages];
+  for(std::size_t end = numStages; end != 0; end = bestBegin[end])
+    partitioning.MultiStages.emplace_back(std::make_pair(bestBegin[end], end), bestLoopOrder[end]);
+  std::reverse(partitioning.MultiStages.begin(), partitioning.MultiStages.end());
+  return partitioning;
+}
+
+} // anonymous namespace
+
 std::unique_ptr<iir::Stencil>
 ReoderStrategyPartitioning::reorder(iir::StencilInstantiation* instantiation,
                                     const std::unique_ptr<iir::Stencil>& stencilPtr) {
-  DAWN_ASSERT("ReoderStrategyPartitioning is not yet implemented");
-  return nullptr;
+  iir::Stencil& stencil = *stencilPtr;
+  iir::DependencyGraphStage& stageDAG = *stencil.getStageDependencyGraph();
+  auto& metadata = instantiation->getMetaData();
+
+  // Compute the sub-graphs of the access graph of the whole stencil. Stages of different sub-graphs
+  // do not share any data and gain nothing from being fused.
+  iir::DependencyGraphAccesses accessGraph(metadata);
+  for(const auto& multiStagePtr : stencil.getChildren())
+    for(const auto& stagePtr : multiStagePtr->getChildren())
+      for(const auto& doMethodPtr : stagePtr->getChildren())
+        if(doMethodPtr->getDependencyGraph())
+          accessGraph.merge(doMethodPtr->getDependencyGraph().get());
+
+  std::unordered_map<int, int> accessIDToPartitionMap;
+  auto partitions = accessGraph.partitionInSubGraphs();
+  for(std::size_t partitionIdx = 0; partitionIdx < partitions.size(); ++partitionIdx)
+    for(std::size_t VertexID : partitions[partitionIdx])
+      accessIDToPartitionMap.emplace(accessGraph.getIDFromVertexID(VertexID), partitionIdx);
+
+  // Gather the stages in their original order
+  std::vector<StageInfo> stages;
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    for(const auto& stagePtr : multiStagePtr->getChildren()) {
+      StageInfo stage;
+      stage.Stage = stagePtr.get();
+      stage.LoopOrder = multiStagePtr->getLoopOrder();
+
+      for(const auto& AccessIDFieldPair : stagePtr->getFields()) {
+        stage.AccessIDs.insert(AccessIDFieldPair.first);
+        auto it = accessIDToPartitionMap.find(AccessIDFieldPair.first);
+        if(it != accessIDToPartitionMap.end())
+          stage.Partitions.insert(it->second);
+      }
+
+      for(std::size_t i = 0; i < stages.size(); ++i)
+        if(stageDAG.depends(stagePtr->getStageID(), stages[i].Stage->getStageID()))
+          stage.DependsOn.push_back(i);
+
+      stages.push_back(std::move(stage));
+    }
+  }
+
+  // Partition the original and the locality driven order of the stages and keep the better one
+  std::vector<std::size_t> originalOrder(stages.size());
+  for(std::size_t i = 0; i < stages.size(); ++i)
+    originalOrder[i] = i;
+  std::vector<std::size_t> localityOrder = computeLocalityOrder(stages);
+
+  Partitioning partitioning = computePartitioning(*instantiation, stages, originalOrder);
+  if(!partitioning.isLegal()) {
+    DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+    diag << "stencil '" << instantiation->getName()
+         << "' exceeds maximum number of allowed halo lines ("
+         << instantiation->getOptimizerContext()->getOptions().MaxHaloPoints << ")";
+    instantiation->getOptimizerContext()->getDiagnostics().report(diag);
+    return nullptr;
+  }
+
+  const std::vector<std::size_t>* order = &originalOrder;
+  if(localityOrder != originalOrder) {
+    Partitioning localityPartitioning = computePartitioning(*instantiation, stages, localityOrder);
+    if(localityPartitioning < partitioning) {
+      partitioning = std::move(localityPartitioning);
+      order = &localityOrder;
+    }
+  }
+
+  // Assemble the new stencil
+  std::unique_ptr<iir::Stencil> newStencil = make_unique<iir::Stencil>(
+      metadata, stencil.getStencilAttributes(), stencilPtr->getStencilID());
+  newStencil->setStageDependencyGraph(stencil.getStageDependencyGraph());
+
+  for(const auto& multiStageDesc : partitioning.MultiStages) {
+    auto multiStage = make_unique<iir::MultiStage>(metadata, multiStageDesc.second);
+    for(std::size_t i = multiStageDesc.first.first; i < multiStageDesc.first.second; ++i)
+      multiStage->insertChild(stages[(*order)[i]].Stage->clone());
+    multiStage->update(iir::NodeUpdateType::level);
+    newStencil->insertChild(std::move(multiStage));
+  }
+
+  return newStencil;
 }
 
 } // namespace dawn
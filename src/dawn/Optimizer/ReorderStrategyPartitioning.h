@@ -21,6 +21,17 @@ namespace dawn {
 
 /// @brief Reordering strategy which uses S-cut graph partitioning to reorder the stages and
 /// statements
+///
+/// The stages are first arranged in a topological order of the stage dependency graph which keeps
+/// stages of the same sub-graph of the access dependency graph (see
+/// `DependencyGraphAccesses::partitionInSubGraphs`) and stages sharing fields next to each other.
+/// This sequence is then cut into multi-stages such that the total number of main memory accesses,
+/// as estimated by the data-locality metric (see `PassDataLocalityMetric`), is minimal under the
+/// constraints that the loop orders are compatible, no vertical read-before-write conflicts arise
+/// and the maximum number of halo points is not exceeded. The optimal cuts are computed by dynamic
+/// programming over all legal multi-stages of consecutive stages. The original order of the
+/// stages is considered as well and the cheaper of the two partitionings is kept.
+///
 /// @ingroup optimizer
 class ReoderStrategyPartitioning : public ReorderStrategy {
 public:
@@ -15,6 +15,7 @@
 #include "dawn/SIR/ASTExpr.h"
 #include "dawn/SIR/ASTUtil.h"
 #include "dawn/SIR/ASTVisitor.h"
+#include "dawn/Support/Arena.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Casting.h"
 #include "dawn/Support/StringRef.h"
@@ -43,7 +44,7 @@ UnaryOperator& UnaryOperator::operator=(UnaryOperator expr) {
 UnaryOperator::~UnaryOperator() {}
 
 std::shared_ptr<Expr> UnaryOperator::clone() const {
-  return std::make_shared<UnaryOperator>(*this);
+  return makeArenaShared<UnaryOperator>(*this);
 }
 
 bool UnaryOperator::equals(const Expr* other) const {
@@ -82,7 +83,7 @@ BinaryOperator& BinaryOperator::operator=(BinaryOperator expr) {
 BinaryOperator::~BinaryOperator() {}
 
 std::shared_ptr<Expr> BinaryOperator::clone() const {
-  return std::make_shared<BinaryOperator>(*this);
+  return makeArenaShared<BinaryOperator>(*this);
 }
 
 bool BinaryOperator::equals(const Expr* other) const {
@@ -126,7 +127,7 @@ AssignmentExpr& AssignmentExpr::operator=(AssignmentExpr expr) {
 AssignmentExpr::~AssignmentExpr() {}
 
 std::shared_ptr<Expr> AssignmentExpr::clone() const {
-  return std::make_shared<AssignmentExpr>(*this);
+  return makeArenaShared<AssignmentExpr>(*this);
 }
 
 bool AssignmentExpr::equals(const Expr* other) const {
@@ -153,7 +154,7 @@ NOPExpr& NOPExpr::operator=(NOPExpr expr) {
 
 NOPExpr::~NOPExpr() {}
 
-std::shared_ptr<Expr> NOPExpr::clone() const { return std::make_shared<NOPExpr>(*this); }
+std::shared_ptr<Expr> NOPExpr::clone() const { return makeArenaShared<NOPExpr>(*this); }
 
 bool NOPExpr::equals(const Expr* other) const { return true; }
 
@@ -182,7 +183,7 @@ TernaryOperator& TernaryOperator::operator=(TernaryOperator expr) {
 TernaryOperator::~TernaryOperator() {}
 
 std::shared_ptr<Expr> TernaryOperator::clone() const {
-  return std::make_shared<TernaryOperator>(*this);
+  return makeArenaShared<TernaryOperator>(*this);
 }
 
 bool TernaryOperator::equals(const Expr* other) const {
@@ -221,7 +222,7 @@ FunCallExpr& FunCallExpr::operator=(FunCallExpr expr) {
 
 FunCallExpr::~FunCallExpr() {}
 
-std::shared_ptr<Expr> FunCallExpr::clone() const { return std::make_shared<FunCallExpr>(*this); }
+std::shared_ptr<Expr> FunCallExpr::clone() const { return makeArenaShared<FunCallExpr>(*this); }
 
 bool FunCallExpr::equals(const Expr* other) const {
   const FunCallExpr* otherPtr = dyn_cast<FunCallExpr>(other);
@@ -267,7 +268,7 @@ StencilFunCallExpr& StencilFunCallExpr::operator=(StencilFunCallExpr expr) {
 StencilFunCallExpr::~StencilFunCallExpr() {}
 
 std::shared_ptr<Expr> StencilFunCallExpr::clone() const {
-  return std::make_shared<StencilFunCallExpr>(*this);
+  return makeArenaShared<StencilFunCallExpr>(*this);
 }
 
 bool StencilFunCallExpr::equals(const Expr* other) const {
@@ -304,7 +305,7 @@ StencilFunArgExpr& StencilFunArgExpr::operator=(StencilFunArgExpr expr) {
 StencilFunArgExpr::~StencilFunArgExpr() {}
 
 std::shared_ptr<Expr> StencilFunArgExpr::clone() const {
-  return std::make_shared<StencilFunArgExpr>(*this);
+  return makeArenaShared<StencilFunArgExpr>(*this);
 }
 
 bool StencilFunArgExpr::equals(const Expr* other) const {
@@ -336,7 +337,7 @@ VarAccessExpr& VarAccessExpr::operator=(VarAccessExpr expr) {
 VarAccessExpr::~VarAccessExpr() {}
 
 std::shared_ptr<Expr> VarAccessExpr::clone() const {
-  return std::make_shared<VarAccessExpr>(*this);
+  return makeArenaShared<VarAccessExpr>(*this);
 }
 
 bool VarAccessExpr::equals(const Expr* other) const {
@@ -390,7 +391,7 @@ void FieldAccessExpr::setPureOffset(const Array3i& offset) {
 }
 
 std::shared_ptr<Expr> FieldAccessExpr::clone() const {
-  return std::make_shared<FieldAccessExpr>(*this);
+  return makeArenaShared<FieldAccessExpr>(*this);
 }
 
 bool FieldAccessExpr::equals(const Expr* other) const {
@@ -422,7 +423,7 @@ LiteralAccessExpr& LiteralAccessExpr::operator=(LiteralAccessExpr expr) {
 LiteralAccessExpr::~LiteralAccessExpr() {}
 
 std::shared_ptr<Expr> LiteralAccessExpr::clone() const {
-  return std::make_shared<LiteralAccessExpr>(*this);
+  return makeArenaShared<LiteralAccessExpr>(*this);
 }
 
 bool LiteralAccessExpr::equals(const Expr* other) const {
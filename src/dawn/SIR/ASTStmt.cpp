@@ -17,6 +17,7 @@
 #include "dawn/SIR/ASTUtil.h"
 #include "dawn/SIR/ASTVisitor.h"
 #include "dawn/SIR/SIR.h"
+#include "dawn/Support/Arena.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Casting.h"
 
@@ -43,7 +44,7 @@ BlockStmt& BlockStmt::operator=(BlockStmt const& stmt) {
 
 BlockStmt::~BlockStmt() {}
 
-std::shared_ptr<Stmt> BlockStmt::clone() const { return std::make_shared<BlockStmt>(*this); }
+std::shared_ptr<Stmt> BlockStmt::clone() const { return makeArenaShared<BlockStmt>(*this); }
 
 bool BlockStmt::equals(const Stmt* other) const {
   const BlockStmt* otherPtr = dyn_cast<BlockStmt>(other);
@@ -78,7 +79,7 @@ ExprStmt& ExprStmt::operator=(ExprStmt stmt) {
 
 ExprStmt::~ExprStmt() {}
 
-std::shared_ptr<Stmt> ExprStmt::clone() const { return std::make_shared<ExprStmt>(*this); }
+std::shared_ptr<Stmt> ExprStmt::clone() const { return makeArenaShared<ExprStmt>(*this); }
 
 bool ExprStmt::equals(const Stmt* other) const {
   const ExprStmt* otherPtr = dyn_cast<ExprStmt>(other);
@@ -110,7 +111,7 @@ ReturnStmt& ReturnStmt::operator=(ReturnStmt stmt) {
 
 ReturnStmt::~ReturnStmt() {}
 
-std::shared_ptr<Stmt> ReturnStmt::clone() const { return std::make_shared<ReturnStmt>(*this); }
+std::shared_ptr<Stmt> ReturnStmt::clone() const { return makeArenaShared<ReturnStmt>(*this); }
 
 bool ReturnStmt::equals(const Stmt* other) const {
   const ReturnStmt* otherPtr = dyn_cast<ReturnStmt>(other);
@@ -151,7 +152,7 @@ VarDeclStmt& VarDeclStmt::operator=(VarDeclStmt stmt) {
 
 VarDeclStmt::~VarDeclStmt() {}
 
-std::shared_ptr<Stmt> VarDeclStmt::clone() const { return std::make_shared<VarDeclStmt>(*this); }
+std::shared_ptr<Stmt> VarDeclStmt::clone() const { return makeArenaShared<VarDeclStmt>(*this); }
 
 bool VarDeclStmt::equals(const Stmt* other) const {
   const VarDeclStmt* otherPtr = dyn_cast<VarDeclStmt>(other);
@@ -191,7 +192,7 @@ VerticalRegionDeclStmt& VerticalRegionDeclStmt::operator=(VerticalRegionDeclStmt
 VerticalRegionDeclStmt::~VerticalRegionDeclStmt() {}
 
 std::shared_ptr<Stmt> VerticalRegionDeclStmt::clone() const {
-  return std::make_shared<VerticalRegionDeclStmt>(*this);
+  return makeArenaShared<VerticalRegionDeclStmt>(*this);
 }
 
 bool VerticalRegionDeclStmt::equals(const Stmt* other) const {
@@ -221,7 +222,7 @@ StencilCallDeclStmt& StencilCallDeclStmt::operator=(StencilCallDeclStmt stmt) {
 StencilCallDeclStmt::~StencilCallDeclStmt() {}
 
 std::shared_ptr<Stmt> StencilCallDeclStmt::clone() const {
-  return std::make_shared<StencilCallDeclStmt>(*this);
+  return makeArenaShared<StencilCallDeclStmt>(*this);
 }
 
 bool StencilCallDeclStmt::equals(const Stmt* other) const {
@@ -259,7 +260,7 @@ BoundaryConditionDeclStmt& BoundaryConditionDeclStmt::operator=(BoundaryConditio
 BoundaryConditionDeclStmt::~BoundaryConditionDeclStmt() {}
 
 std::shared_ptr<Stmt> BoundaryConditionDeclStmt::clone() const {
-  return std::make_shared<BoundaryConditionDeclStmt>(*this);
+  return makeArenaShared<BoundaryConditionDeclStmt>(*this);
 }
 
 bool BoundaryConditionDeclStmt::equals(const Stmt* other) const {
@@ -297,7 +298,7 @@ IfStmt& IfStmt::operator=(IfStmt stmt) {
 
 IfStmt::~IfStmt() {}
 
-std::shared_ptr<Stmt> IfStmt::clone() const { return std::make_shared<IfStmt>(*this); }
+std::shared_ptr<Stmt> IfStmt::clone() const { return makeArenaShared<IfStmt>(*this); }
 
 bool IfStmt::equals(const Stmt* other) const {
   const IfStmt* otherPtr = dyn_cast<IfStmt>(other);
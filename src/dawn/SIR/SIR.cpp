@@ -644,7 +644,7 @@ std::string sir::Value::toString() const {
     ss << getValue<int>();
     break;
   case Double:
-    ss << getValue<double>();
+    ss << doubleToString(getValue<double>());
     break;
   case String:
     ss << "\"" << getValue<std::string>() << "\"";
@@ -22,8 +22,18 @@
 #include "dawn/SIR/ASTVisitor.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/Serialization/ASTSerializer.h"
+#include "dawn/Serialization/MappedIIR.h"
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/type_resolver.h>
+#include <google/protobuf/util/type_resolver_util.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <limits>
+#include <memory>
 
 namespace dawn {
 static void setAccesses(proto::iir::Accesses* protoAccesses,
@@ -201,13 +211,117 @@ static iir::Cache makeCache(const proto::iir::Cache* protoCache) {
   return iir::Cache(cacheType, cachePolicy, ID, interval, enclosingInverval, cacheWindow);
 }
 
+// The iteration order of protobuf maps is unspecified, the map entries are hence sorted by key to
+// make the serialized IIR reproducible
+static bool serializeDeterministically(const google::protobuf::Message& message, std::string& str) {
+  str.clear();
+  google::protobuf::io::StringOutputStream stream(&str);
+  google::protobuf::io::CodedOutputStream output(&stream);
+  output.SetSerializationDeterministic(true);
+  return message.SerializeToCodedStream(&output) && !output.HadError();
+}
+
+static void
+serializeDeterministicallyToJson(const google::protobuf::Message& message, std::string& str,
+                                 const google::protobuf::util::JsonPrintOptions& options) {
+  std::string binary;
+  if(!serializeDeterministically(message, binary))
+    throw std::runtime_error(dawn::format("cannot serialize IIR:"));
+
+  const char* typeURLPrefix = "type.googleapis.com";
+  std::unique_ptr<google::protobuf::util::TypeResolver> resolver(
+      google::protobuf::util::NewTypeResolverForDescriptorPool(
+          typeURLPrefix, message.GetDescriptor()->file()->pool()));
+  auto status = google::protobuf::util::BinaryToJsonString(
+      resolver.get(), std::string(typeURLPrefix) + "/" + message.GetDescriptor()->full_name(),
+      binary, &str, options);
+  if(!status.ok())
+    throw std::runtime_error(dawn::format("cannot serialize IIR: %s", status.ToString()));
+}
+
+// The `SK_MappedByte` format starts with a magic number and the sizes of the summary, metadata and
+// IIR sections (as 64-bit little-endian integers), followed by the sections themselves
+static const char mappedByteMagic[8] = {'D', 'A', 'W', 'N', 'I', 'I', 'R', '1'};
+static const std::size_t mappedByteHeaderSize = sizeof(mappedByteMagic) + 3 * 8;
+
+static void appendSectionSize(std::string& str, std::uint64_t size) {
+  for(int byte = 0; byte < 8; ++byte)
+    str.push_back(static_cast<char>((size >> (8 * byte)) & 0xff));
+}
+
+static std::uint64_t readSectionSize(const char* data) {
+  std::uint64_t size = 0;
+  for(int byte = 0; byte < 8; ++byte)
+    size |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[byte])) << (8 * byte);
+  return size;
+}
+
+static proto::iir::StencilInstantiationSummary
+makeSummary(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
+  const auto& metaData = instantiation->getMetaData();
+  proto::iir::StencilInstantiationSummary protoSummary;
+  protoSummary.set_stencilname(metaData.getStencilName());
+  protoSummary.set_filename(metaData.getFileName());
+  for(int AccessID : metaData.getAccessesOfType<iir::FieldAccessType::FAT_APIField>())
+    protoSummary.add_apifields(metaData.getFieldNameFromAccessID(AccessID));
+
+  for(const auto& stencil : instantiation->getStencils()) {
+    auto protoStencil = protoSummary.add_stencils();
+    protoStencil->set_stencilid(stencil->getStencilID());
+    for(const auto& AccessIDFieldInfoPair : stencil->getFields()) {
+      const iir::Stencil::FieldInfo& fieldInfo = AccessIDFieldInfoPair.second;
+      auto protoField = protoStencil->add_fields();
+      protoField->set_accessid(AccessIDFieldInfoPair.first);
+      protoField->set_name(fieldInfo.Name);
+      protoField->set_istemporary(fieldInfo.IsTemporary);
+      for(auto extent : fieldInfo.field.getExtents().getExtents()) {
+        auto protoExtent = protoField->mutable_extents()->add_extents();
+        protoExtent->set_minus(extent.Minus);
+        protoExtent->set_plus(extent.Plus);
+      }
+    }
+    int numStatements = 0;
+    for(const auto& doMethod : iterateIIROver<iir::DoMethod>(*stencil))
+      numStatements += doMethod->getChildren().size();
+    protoStencil->set_nummultistages(stencil->getChildren().size());
+    protoStencil->set_numstages(stencil->getNumStages());
+    protoStencil->set_numstatements(numStatements);
+  }
+  return protoSummary;
+}
+
+/// @brief Read the filename of the serialized StencilInstantiationSummary, skipping all the other
+/// fields instead of decoding them
+static std::string readSummaryFilename(const char* data, std::size_t size) {
+  using google::protobuf::internal::WireFormatLite;
+  google::protobuf::io::CodedInputStream input(reinterpret_cast<const std::uint8_t*>(data),
+                                               static_cast<int>(size));
+  std::string filename;
+  while(std::uint32_t tag = input.ReadTag()) {
+    if(WireFormatLite::GetTagFieldNumber(tag) ==
+           proto::iir::StencilInstantiationSummary::kFilenameFieldNumber &&
+       WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if(!WireFormatLite::ReadString(&input, &filename))
+        throw std::runtime_error("cannot deserialize StencilInstantiation: invalid summary");
+    } else if(!WireFormatLite::SkipField(&input, tag)) {
+      throw std::runtime_error("cannot deserialize StencilInstantiation: invalid summary");
+    }
+  }
+  // A zero tag also marks malformed input, only the end of the summary is valid
+  if(input.CurrentPosition() != static_cast<int>(size))
+    throw std::runtime_error("cannot deserialize StencilInstantiation: invalid summary");
+  return filename;
+}
+
 static void computeInitialDerivedInfo(const std::shared_ptr<iir::StencilInstantiation>& target) {
   for(const auto& leaf : iterateIIROver<iir::StatementAccessesPair>(*target->getIIR())) {
     leaf->update(iir::NodeUpdateType::level);
   }
   for(const auto& leaf : iterateIIROver<iir::DoMethod>(*target->getIIR())) {
-    leaf->update(iir::NodeUpdateType::levelAndTreeAbove);
+    leaf->update(iir::NodeUpdateType::level);
+    leaf->invalidateTreeAbove();
   }
+  target->getIIR()->updateDirtyDerivedInfo();
 }
 
 void IIRSerializer::serializeMetaData(proto::iir::StencilInstantiation& target,
@@ -480,17 +594,31 @@ IIRSerializer::serializeImpl(const std::shared_ptr<iir::StencilInstantiation>& i
     options.add_whitespace = true;
     options.always_print_primitive_fields = true;
     options.preserve_proto_field_names = true;
-    auto status =
-        google::protobuf::util::MessageToJsonString(protoStencilInstantiation, &str, options);
-    if(!status.ok())
-      throw std::runtime_error(dawn::format("cannot serialize IIR: %s", status.ToString()));
+    serializeDeterministicallyToJson(protoStencilInstantiation, str, options);
     break;
   }
   case dawn::IIRSerializer::SK_Byte: {
-    if(!protoStencilInstantiation.SerializeToString(&str))
+    if(!serializeDeterministically(protoStencilInstantiation, str))
       throw std::runtime_error(dawn::format("cannot serialize IIR:"));
     break;
   }
+  case dawn::IIRSerializer::SK_MappedByte: {
+    std::string summary, metaData, internalIR;
+    if(!serializeDeterministically(makeSummary(instantiation), summary) ||
+       !serializeDeterministically(protoStencilInstantiation.metadata(), metaData) ||
+       !serializeDeterministically(protoStencilInstantiation.internalir(), internalIR))
+      throw std::runtime_error(dawn::format("cannot serialize IIR:"));
+
+    str.reserve(mappedByteHeaderSize + summary.size() + metaData.size() + internalIR.size());
+    str.append(mappedByteMagic, sizeof(mappedByteMagic));
+    appendSectionSize(str, summary.size());
+    appendSectionSize(str, metaData.size());
+    appendSectionSize(str, internalIR.size());
+    str += summary;
+    str += metaData;
+    str += internalIR;
+    break;
+  }
   default:
     dawn_unreachable("invalid SerializationKind");
   }
@@ -689,8 +817,66 @@ void IIRSerializer::deserializeIIR(std::shared_ptr<iir::StencilInstantiation>& t
   }
 }
 
+IIRSerializer::MappedSections IIRSerializer::getMappedSections(const char* data,
+                                                              std::size_t size) {
+  if(size < mappedByteHeaderSize ||
+     std::memcmp(data, mappedByteMagic, sizeof(mappedByteMagic)) != 0)
+    throw std::runtime_error("cannot deserialize IIR: invalid header");
+
+  const std::uint64_t maxSectionSize = std::numeric_limits<int>::max();
+  std::uint64_t sizes[3];
+  std::uint64_t totalSize = mappedByteHeaderSize;
+  for(int section = 0; section < 3; ++section) {
+    sizes[section] = readSectionSize(data + sizeof(mappedByteMagic) + 8 * section);
+    if(sizes[section] > maxSectionSize)
+      throw std::runtime_error("cannot deserialize IIR: section too large");
+    totalSize += sizes[section];
+  }
+  if(totalSize > size)
+    throw std::runtime_error("cannot deserialize IIR: truncated data");
+
+  MappedSections sections;
+  sections.Summary = data + mappedByteHeaderSize;
+  sections.SummarySize = sizes[0];
+  sections.MetaData = sections.Summary + sections.SummarySize;
+  sections.MetaDataSize = sizes[1];
+  sections.InternalIR = sections.MetaData + sections.MetaDataSize;
+  sections.InternalIRSize = sizes[2];
+  return sections;
+}
+
+void IIRSerializer::deserializeMappedImpl(const char* data, std::size_t size,
+                                          std::shared_ptr<iir::StencilInstantiation>& target) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+  MappedSections sections = getMappedSections(data, size);
+
+  // The messages are decoded straight from the (mapped) buffer, only the filename is needed from
+  // the summary
+  const std::string filename = readSummaryFilename(sections.Summary, sections.SummarySize);
+  proto::iir::StencilMetaInfo protoMetaData;
+  proto::iir::IIR protoIIR;
+  if(!protoMetaData.ParseFromArray(sections.MetaData, sections.MetaDataSize) ||
+     !protoIIR.ParseFromArray(sections.InternalIR, sections.InternalIRSize))
+    throw std::runtime_error("cannot deserialize StencilInstantiation: invalid section");
+
+  std::shared_ptr<iir::StencilInstantiation> instantiation =
+      std::make_shared<iir::StencilInstantiation>(target->getOptimizerContext());
+
+  deserializeMetaData(instantiation, protoMetaData);
+  deserializeIIR(instantiation, protoIIR);
+  instantiation->getMetaData().fileName_ = filename;
+  computeInitialDerivedInfo(instantiation);
+
+  target = instantiation;
+}
+
 void IIRSerializer::deserializeImpl(const std::string& str, IIRSerializer::SerializationKind kind,
                                     std::shared_ptr<iir::StencilInstantiation>& target) {
+  if(kind == dawn::IIRSerializer::SK_MappedByte) {
+    deserializeMappedImpl(str.data(), str.size(), target);
+    return;
+  }
+
   GOOGLE_PROTOBUF_VERIFY_VERSION;
   // Decode the string
   proto::iir::StencilInstantiation protoStencilInstantiation;
@@ -725,6 +911,9 @@ void IIRSerializer::deserializeImpl(const std::string& str, IIRSerializer::Seria
 std::shared_ptr<iir::StencilInstantiation>
 IIRSerializer::deserialize(const std::string& file, OptimizerContext* context,
                            IIRSerializer::SerializationKind kind) {
+  if(kind == dawn::IIRSerializer::SK_MappedByte)
+    return MappedIIR(file).materialize(context);
+
   std::ifstream ifs(file);
   if(!ifs.is_open())
     throw std::runtime_error(
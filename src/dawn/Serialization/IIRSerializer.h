@@ -18,6 +18,7 @@
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/IIR.pb.h"
 #include "dawn/IIR/StencilMetaInformation.h"
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -28,6 +29,8 @@ namespace iir {
 class StencilInstantiation;
 }
 
+class MappedIIR;
+
 /// @brief Serialize/Deserialize the internal representation of the user stencils
 class IIRSerializer {
 public:
@@ -35,8 +38,10 @@ public:
 
   /// @brief Type of serialization algorithm to use
   enum SerializationKind {
-    SK_Json, ///< JSON serialization
-    SK_Byte  ///< Protobuf's internal byte format
+    SK_Json,      ///< JSON serialization
+    SK_Byte,      ///< Protobuf's internal byte format
+    SK_MappedByte ///< Sections of protobuf's byte format which can be memory-mapped and decoded
+                  ///  separately (@see MappedIIR)
   };
 
   /// @brief Deserialize the StencilInstantiaion from `file`
@@ -81,6 +86,26 @@ public:
                     SerializationKind kind = SK_Json);
 
 private:
+  friend class MappedIIR;
+
+  /// @brief Location of the sections of a buffer in the `SK_MappedByte` format
+  struct MappedSections {
+    const char* Summary;
+    std::size_t SummarySize;
+    const char* MetaData;
+    std::size_t MetaDataSize;
+    const char* InternalIR;
+    std::size_t InternalIRSize;
+  };
+
+  /// @brief Check the header of the `SK_MappedByte` formatted buffer and locate its sections
+  /// @throws std::exception    Invalid header or truncated buffer
+  static MappedSections getMappedSections(const char* data, std::size_t size);
+
+  /// @brief Deserialize the `SK_MappedByte` formatted buffer into `target`, directly from `data`
+  static void deserializeMappedImpl(const char* data, std::size_t size,
+                                    std::shared_ptr<iir::StencilInstantiation>& target);
+
   /// @brief The implementation of deserialisation used for string and file. This delegates to the
   /// separate implementations of deserializing the IIR and the Metadata
   ///
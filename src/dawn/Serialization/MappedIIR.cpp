@@ -0,0 +1,99 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#include "dawn/Serialization/MappedIIR.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/Format.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef DAWN_ON_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dawn {
+
+MappedIIR::MappedIIR(const std::string& file) : data_(nullptr), size_(0), mappedSize_(0) {
+#ifdef DAWN_ON_UNIX
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw std::runtime_error(
+        dawn::format("cannot deserialize IIR: failed to open file \"%s\"", file));
+
+  struct stat fileStat;
+  if(::fstat(fd, &fileStat) != 0) {
+    ::close(fd);
+    throw std::runtime_error(
+        dawn::format("cannot deserialize IIR: failed to stat file \"%s\"", file));
+  }
+
+  size_ = static_cast<std::size_t>(fileStat.st_size);
+  if(size_ > 0) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(addr == MAP_FAILED)
+      throw std::runtime_error(
+          dawn::format("cannot deserialize IIR: failed to map file \"%s\"", file));
+    data_ = static_cast<const char*>(addr);
+    mappedSize_ = size_;
+  } else {
+    ::close(fd);
+  }
+#else
+  std::ifstream ifs(file, std::ios::binary);
+  if(!ifs.is_open())
+    throw std::runtime_error(
+        dawn::format("cannot deserialize IIR: failed to open file \"%s\"", file));
+  buffer_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  try {
+    auto sections = IIRSerializer::getMappedSections(data_, size_);
+    if(!summary_.ParseFromArray(sections.Summary, sections.SummarySize))
+      throw std::runtime_error("cannot deserialize IIR: invalid summary");
+  } catch(...) {
+    unmap();
+    throw;
+  }
+}
+
+MappedIIR::~MappedIIR() { unmap(); }
+
+void MappedIIR::unmap() {
+#ifdef DAWN_ON_UNIX
+  if(mappedSize_ != 0) {
+    ::munmap(const_cast<char*>(data_), mappedSize_);
+    mappedSize_ = 0;
+  }
+#endif
+}
+
+std::shared_ptr<iir::StencilInstantiation>
+MappedIIR::materialize(OptimizerContext* context) const {
+  std::shared_ptr<iir::StencilInstantiation> instantiation =
+      std::make_shared<iir::StencilInstantiation>(context);
+  IIRSerializer::deserializeMappedImpl(data_, size_, instantiation);
+  return instantiation;
+}
+
+} // namespace dawn
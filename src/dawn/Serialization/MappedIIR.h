@@ -0,0 +1,68 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#ifndef DAWN_SERIALIZATION_MAPPEDIIR_H
+#define DAWN_SERIALIZATION_MAPPEDIIR_H
+
+#include "dawn/IIR/IIR.pb.h"
+#include "dawn/Support/NonCopyable.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace dawn {
+
+class OptimizerContext;
+namespace iir {
+class StencilInstantiation;
+}
+
+/// @brief Read-only view of a file serialized in the `IIRSerializer::SK_MappedByte` format
+///
+/// The file is memory-mapped and decoded lazily: only the summary of the StencilInstantiation
+/// (stencil name, fields and their extents) is decoded when the file is opened, the metadata and
+/// the IIR tree only by `materialize`. Tools which only inspect the summary never decode the
+/// statements of the IIR. The view is immutable once constructed, hence safe to share between
+/// threads.
+class MappedIIR : public NonCopyable {
+  const char* data_;
+  std::size_t size_;
+
+  /// Length of the mapping, 0 if the file was read into `buffer_` instead
+  std::size_t mappedSize_;
+  std::string buffer_;
+
+  proto::iir::StencilInstantiationSummary summary_;
+
+  void unmap();
+
+public:
+  /// @brief Map `file` into memory and decode its summary
+  /// @throws std::exception    Failed to open or map `file`, `file` is not in the `SK_MappedByte`
+  ///                           format or its summary is invalid
+  explicit MappedIIR(const std::string& file);
+  ~MappedIIR();
+
+  /// @brief Get the summary of the StencilInstantiation
+  const proto::iir::StencilInstantiationSummary& getSummary() const { return summary_; }
+
+  /// @brief Decode the complete StencilInstantiation and register it in `context`
+  /// @throws std::exception    Failed to decode the StencilInstantiation
+  std::shared_ptr<iir::StencilInstantiation> materialize(OptimizerContext* context) const;
+};
+
+} // namespace dawn
+
+#endif // DAWN_SERIALIZATION_MAPPEDIIR_H
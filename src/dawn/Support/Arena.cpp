@@ -0,0 +1,58 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/Arena.h"
+#include "dawn/Support/Assert.h"
+#include <algorithm>
+
+namespace dawn {
+
+namespace {
+
+/// Innermost scope of the current thread (may be NULL)
+thread_local ArenaScope* currentScope = nullptr;
+
+} // anonymous namespace
+
+constexpr std::size_t Arena::Granularity;
+constexpr std::size_t Arena::MaxRecycledSize;
+
+Arena::~Arena() {
+  DAWN_ASSERT_MSG(bytesInUse_ == 0, "objects allocated in the arena outlive it");
+}
+
+void* Arena::allocateSlow(std::size_t size, std::size_t alignment) {
+  // Oversized requests get a chunk of their own, the current chunk stays in use
+  std::size_t chunkSize = std::max(chunkSize_, size + alignment);
+  chunks_.emplace_back(new char[chunkSize]);
+  char* chunk = chunks_.back().get();
+
+  std::size_t adjust = (alignment - reinterpret_cast<std::size_t>(chunk)) & (alignment - 1);
+  char* ptr = chunk + adjust;
+  if(chunkSize == chunkSize_ || !cur_) {
+    cur_ = ptr + size;
+    end_ = chunk + chunkSize;
+  }
+  return ptr;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : arena_(arena), parent_(currentScope) {
+  currentScope = this;
+}
+
+ArenaScope::~ArenaScope() { currentScope = parent_; }
+
+Arena* ArenaScope::getCurrentArena() { return currentScope ? currentScope->arena_ : nullptr; }
+
+} // namespace dawn
@@ -0,0 +1,189 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_ARENA_H
+#define DAWN_SUPPORT_ARENA_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+/// @brief Bump pointer allocator recycling the memory of released objects
+///
+/// Memory is carved out of large chunks. Released blocks of up to `MaxRecycledSize` bytes are kept
+/// in free lists (one per multiple of the alignment of `std::max_align_t`) and handed out again by
+/// later allocations of the same size class, larger blocks are only reclaimed with the arena. The
+/// chunks are freed at once when the arena is destroyed, which requires all the objects allocated
+/// in it to be released before. The arena is not thread-safe.
+///
+/// @ingroup support
+class Arena : NonCopyable {
+public:
+  static constexpr std::size_t Granularity = alignof(std::max_align_t);
+  static constexpr std::size_t MaxRecycledSize = 32 * Granularity;
+
+private:
+  struct FreeBlock {
+    FreeBlock* Next;
+  };
+
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  std::array<FreeBlock*, MaxRecycledSize / Granularity> freeLists_;
+  char* cur_ = nullptr;
+  char* end_ = nullptr;
+  std::size_t chunkSize_;
+  std::size_t bytesAllocated_ = 0;
+  std::size_t bytesInUse_ = 0;
+
+public:
+  explicit Arena(std::size_t chunkSize = 64 * 1024) : chunkSize_(chunkSize) {
+    freeLists_.fill(nullptr);
+  }
+  ~Arena();
+
+  /// @brief Allocate `size` bytes aligned to `alignment` (a power of two)
+  void* allocate(std::size_t size, std::size_t alignment) {
+    bytesAllocated_ += size;
+    bytesInUse_ += size;
+
+    std::size_t freeList = getFreeList(size, alignment);
+    if(freeList == freeLists_.size())
+      return bump(size, alignment);
+
+    if(FreeBlock* block = freeLists_[freeList]) {
+      freeLists_[freeList] = block->Next;
+      return block;
+    }
+
+    // Blocks of a size class may be reused by any allocation of the class
+    return bump((freeList + 1) * Granularity, Granularity);
+  }
+
+  /// @brief Release `size` bytes allocated with `alignment` at `ptr`
+  void deallocate(void* ptr, std::size_t size, std::size_t alignment) {
+    bytesInUse_ -= size;
+
+    std::size_t freeList = getFreeList(size, alignment);
+    if(freeList == freeLists_.size())
+      return;
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->Next = freeLists_[freeList];
+    freeLists_[freeList] = block;
+  }
+
+  /// @brief Number of bytes handed out by the arena
+  std::size_t getBytesAllocated() const { return bytesAllocated_; }
+
+  /// @brief Number of bytes handed out by the arena and not released yet
+  std::size_t getBytesInUse() const { return bytesInUse_; }
+
+  /// @brief Number of chunks allocated from the heap
+  std::size_t getNumChunks() const { return chunks_.size(); }
+
+private:
+  /// @brief Index of the free list of the size class of `size`, or the number of free lists if
+  /// the block is not recycled
+  std::size_t getFreeList(std::size_t size, std::size_t alignment) const {
+    if(size == 0 || size > MaxRecycledSize || alignment > Granularity)
+      return freeLists_.size();
+    return (size - 1) / Granularity;
+  }
+
+  void* bump(std::size_t size, std::size_t alignment) {
+    std::size_t adjust = (alignment - reinterpret_cast<std::size_t>(cur_)) & (alignment - 1);
+    if(cur_ && adjust + size <= static_cast<std::size_t>(end_ - cur_)) {
+      char* ptr = cur_ + adjust;
+      cur_ = ptr + size;
+      return ptr;
+    }
+    return allocateSlow(size, alignment);
+  }
+
+  void* allocateSlow(std::size_t size, std::size_t alignment);
+};
+
+/// @brief STL allocator drawing its memory from an `Arena`
+///
+/// The allocator does not own the arena: objects created with `std::allocate_shared` return their
+/// memory to the arena when they are destroyed, hence the owner of the arena has to guarantee that
+/// they do not outlive it.
+///
+/// @ingroup support
+template <typename T>
+class ArenaAllocator {
+  template <typename U>
+  friend class ArenaAllocator;
+
+  Arena* arena_;
+
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* ptr, std::size_t n) { arena_->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+  Arena* getArena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+};
+
+/// @brief Arena used by `makeArenaShared` on the current thread
+///
+/// While the scope is alive, objects created with `makeArenaShared` on the calling thread are
+/// allocated in the given arena (NULL falls back to the heap). Scopes may be nested.
+///
+/// @ingroup support
+class ArenaScope : NonCopyable {
+  Arena* arena_;
+  ArenaScope* parent_;
+
+public:
+  explicit ArenaScope(Arena* arena);
+  ~ArenaScope();
+
+  /// @brief Get the arena of the innermost scope of the current thread (may be NULL)
+  static Arena* getCurrentArena();
+};
+
+/// @brief Create a `std::shared_ptr<T>` in the arena of the current `ArenaScope`, or on the heap
+/// if there is none
+template <typename T, typename... Args>
+std::shared_ptr<T> makeArenaShared(Args&&... args) {
+  if(Arena* arena = ArenaScope::getCurrentArena())
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace dawn
+
+#endif
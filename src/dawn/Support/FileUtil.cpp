@@ -13,6 +13,17 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Support/FileUtil.h"
+#include "dawn/Support/Config.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#ifdef DAWN_ON_UNIX
+#include <cerrno>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace dawn {
 
@@ -27,4 +38,47 @@ StringRef getExtension(StringRef filename) {
   return filename.substr(filename.find_last_of(".") - 1);
 }
 
+bool createDirectories(const std::string& path) {
+#ifdef DAWN_ON_UNIX
+  for(std::size_t pos = path.find('/', 1);; pos = path.find('/', pos + 1)) {
+    std::string dir = path.substr(0, pos);
+    if(!dir.empty() && ::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+      return false;
+    if(pos == std::string::npos)
+      return true;
+  }
+#else
+  return true;
+#endif
+}
+
+static std::string getUniqueSuffix() {
+  std::size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+#ifdef DAWN_ON_UNIX
+  return ".tmp." + std::to_string(::getpid()) + "." + std::to_string(id);
+#else
+  return ".tmp." + std::to_string(id);
+#endif
+}
+
+bool writeFileAtomically(const std::string& path, const std::string& content) {
+  const std::string tmpPath = path + getUniqueSuffix();
+  {
+    std::ofstream ofs(tmpPath);
+    if(!ofs.is_open())
+      return false;
+    ofs << content;
+    if(!ofs.good()) {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  if(std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
 } // namespace dawn
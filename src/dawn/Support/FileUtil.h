@@ -16,6 +16,7 @@
 #define DAWN_SUPPORT_FILEUTIL_H
 
 #include "dawn/Support/StringRef.h"
+#include <string>
 
 namespace dawn {
 
@@ -34,6 +35,20 @@ extern StringRef getExtension(StringRef filename);
 /// @ingroup support
 extern StringRef getFilenameWithoutExtension(StringRef path);
 
+/// @brief Create the directory `path` including all its parent directories
+///
+/// This will only work on UNIX like platforms.
+///
+/// @returns `true` on success or if the directory already exists
+/// @ingroup support
+extern bool createDirectories(const std::string& path);
+
+/// @brief Write `content` to `path` by renaming a temporary file (concurrent readers hence never
+/// see a partially written file)
+/// @returns `true` on success
+/// @ingroup support
+extern bool writeFileAtomically(const std::string& path, const std::string& content);
+
 } // namespace dawn
 
 #endif
@@ -27,6 +27,18 @@ internal::LoggerProxy::~LoggerProxy() {
   ss_.get().clear();
 }
 
+namespace {
+
+/// Stream used to assemble the message of the current thread
+std::stringstream& getThreadLocalStream() {
+  static thread_local std::stringstream ss;
+  return ss;
+}
+
+std::once_flag instanceFlag;
+
+} // anonymous namespace
+
 Logger* Logger::instance_ = nullptr;
 
 Logger::Logger() : logger_(nullptr) {}
@@ -36,31 +48,30 @@ void Logger::registerLogger(LoggerInterface* logger) { logger_ = logger; }
 LoggerInterface* Logger::getLogger() { return logger_; }
 
 internal::LoggerProxy Logger::logInfo(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Info, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Info, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logWarning(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Warning, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Warning, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logError(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Error, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Error, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logFatal(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Fatal, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Fatal, getThreadLocalStream(), file, line);
 }
 
 void Logger::log(LoggingLevel level, const std::string& message, const char* file, int line) {
   if(logger_ != nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
     logger_->log(level, message, file, line);
   }
 }
 
 Logger& Logger::getSingleton() {
-  if(instance_ == nullptr) {
-    instance_ = new Logger;
-  }
+  std::call_once(instanceFlag, []() { instance_ = new Logger; });
   return *instance_;
 }
 
@@ -16,6 +16,7 @@
 #define DAWN_SUPPORT_LOGGING_H
 
 #include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -92,11 +93,14 @@ public:
 ///   }
 /// @endcode
 ///
+/// Messages are assembled per thread and forwarded to the registered Logger one at a time, hence
+/// `DAWN_LOG` may be used concurrently from multiple threads.
+///
 /// @ingroup support
 class Logger {
   static Logger* instance_;
   LoggerInterface* logger_;
-  std::stringstream ss_;
+  std::mutex mutex_;
 
 public:
   /// @brief Initialize Logger object
@@ -0,0 +1,180 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_SMALLINTMAP_H
+#define DAWN_SUPPORT_SMALLINTMAP_H
+
+#include "dawn/Support/Assert.h"
+#include "dawn/Support/SmallVector.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace dawn {
+
+/// @brief Map from integer keys to `T` stored as a vector of key/value pairs sorted by key
+///
+/// Intended for small maps keyed by dense IDs (e.g AccessIDs): the first `N` elements are stored
+/// inline, lookups are binary searches and merging two maps is a single linear pass. The interface
+/// mirrors the subset of `std::unordered_map` used by the IIR, iteration visits the elements in
+/// increasing key order.
+///
+/// Inserting or erasing elements invalidates all iterators and references into the map.
+///
+/// @ingroup support
+template <typename T, unsigned N = 4>
+class SmallIntMap {
+public:
+  using key_type = int;
+  using mapped_type = T;
+  using value_type = std::pair<int, T>;
+  using size_type = std::size_t;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+private:
+  SmallVector<value_type, N> data_;
+
+  struct KeyLess {
+    bool operator()(const value_type& a, const value_type& b) const { return a.first < b.first; }
+    bool operator()(const value_type& a, int key) const { return a.first < key; }
+  };
+
+public:
+  SmallIntMap() = default;
+  SmallIntMap(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+  template <typename InputIt>
+  SmallIntMap(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  iterator begin() { return data_.begin(); }
+  iterator end() { return data_.end(); }
+  const_iterator begin() const { return data_.begin(); }
+  const_iterator end() const { return data_.end(); }
+
+  bool empty() const { return data_.empty(); }
+  size_type size() const { return data_.size(); }
+  void clear() { data_.clear(); }
+  void reserve(size_type n) { data_.reserve(n); }
+
+  iterator lower_bound(int key) { return std::lower_bound(begin(), end(), key, KeyLess()); }
+  const_iterator lower_bound(int key) const {
+    return std::lower_bound(begin(), end(), key, KeyLess());
+  }
+
+  iterator find(int key) {
+    iterator it = lower_bound(key);
+    return (it != end() && it->first == key) ? it : end();
+  }
+  const_iterator find(int key) const {
+    const_iterator it = lower_bound(key);
+    return (it != end() && it->first == key) ? it : end();
+  }
+
+  size_type count(int key) const { return find(key) != end(); }
+
+  T& at(int key) {
+    iterator it = find(key);
+    DAWN_ASSERT_MSG(it != end(), "key not in map");
+    return it->second;
+  }
+  const T& at(int key) const {
+    const_iterator it = find(key);
+    DAWN_ASSERT_MSG(it != end(), "key not in map");
+    return it->second;
+  }
+
+  T& operator[](int key) { return emplace(key).first->second; }
+
+  /// @brief Insert `T(args...)` with the given key if the key is not yet present
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(int key, Args&&... args) {
+    iterator it = lower_bound(key);
+    if(it != end() && it->first == key)
+      return std::make_pair(it, false);
+    return std::make_pair(data_.insert(it, value_type(key, T(std::forward<Args>(args)...))), true);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value.first, value.second);
+  }
+
+  /// @brief Insert the elements of [first, last) whose key is not yet present
+  ///
+  /// If the range is sorted by key (e.g it is another `SmallIntMap`), this runs in linear time.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type oldSize = size();
+    for(; first != last; ++first)
+      data_.push_back(value_type(first->first, first->second));
+    if(size() == oldSize)
+      return;
+
+    // Existing elements precede new ones with the same key, as do earlier elements of the range
+    iterator mid = begin() + oldSize;
+    if(!std::is_sorted(mid, end(), KeyLess()))
+      std::stable_sort(mid, end(), KeyLess());
+    std::inplace_merge(begin(), mid, end(), KeyLess());
+    data_.erase(std::unique(begin(), end(),
+                            [](const value_type& a, const value_type& b) {
+                              return a.first == b.first;
+                            }),
+                end());
+  }
+
+  /// @brief Merge `other` into this map in a single linear pass
+  ///
+  /// Elements whose key is not yet present are copied, otherwise `mergeFunc(T& thisValue, const
+  /// T& otherValue)` is called.
+  template <unsigned M, typename MergeFuncType>
+  void merge(const SmallIntMap<T, M>& other, MergeFuncType&& mergeFunc) {
+    if(other.empty())
+      return;
+
+    size_type oldSize = size();
+    data_.append(other.begin(), other.end());
+    std::inplace_merge(begin(), begin() + oldSize, end(), KeyLess());
+
+    // Fold the elements of `other` into the preceding element with the same key
+    iterator out = begin();
+    for(iterator it = begin() + 1, last = end(); it != last; ++it) {
+      if(it->first == out->first)
+        mergeFunc(out->second, static_cast<const T&>(it->second));
+      else if(++out != it)
+        *out = std::move(*it);
+    }
+    data_.erase(out + 1, end());
+  }
+
+  size_type erase(int key) {
+    iterator it = find(key);
+    if(it == end())
+      return 0;
+    data_.erase(it);
+    return 1;
+  }
+  iterator erase(const_iterator it) { return data_.erase(it); }
+
+  bool operator==(const SmallIntMap& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+  }
+  bool operator!=(const SmallIntMap& other) const { return !(*this == other); }
+};
+
+} // namespace dawn
+
+#endif
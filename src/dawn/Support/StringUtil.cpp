@@ -13,6 +13,8 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Support/StringUtil.h"
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 
 namespace dawn {
@@ -41,6 +43,18 @@ extern std::string decimalToOrdinal(int dec) {
   return decimal + suffix;
 }
 
+std::string doubleToString(double value) {
+  std::ostringstream ss;
+  for(int precision = 6; precision <= std::numeric_limits<double>::max_digits10; ++precision) {
+    ss.str("");
+    ss.precision(precision);
+    ss << value;
+    if(std::strtod(ss.str().c_str(), nullptr) == value)
+      break;
+  }
+  return ss.str();
+}
+
 std::string indent(const std::string& string, int amount) {
   // This could probably be done faster (it's not really speed-critical though)
   std::istringstream iss(string);
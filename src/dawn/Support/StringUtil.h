@@ -128,6 +128,18 @@ extern std::string indent(const std::string& string, int amount = 2);
 /// @ingroup support
 extern std::string decimalToOrdinal(int dec);
 
+/// @brief Convert a floating point number to the shortest string (with at least 6 significant
+/// digits) which reads back as the same number
+///
+/// @b Example
+/// @code
+///   std::string a = doubleToString(0.5);          // == "0.5"
+///   std::string b = doubleToString(0.1234567891); // == "0.1234567891"
+/// @endcode
+///
+/// @ingroup support
+extern std::string doubleToString(double value);
+
 /// @}
 
 } // namespace dawn
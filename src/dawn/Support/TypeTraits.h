@@ -46,11 +46,8 @@ struct isPodLike {
 #endif
 };
 
-// std::pair's are pod-like if their elements are.
-template <typename T, typename U>
-struct isPodLike<std::pair<T, U>> {
-  static const bool value = isPodLike<T>::value && isPodLike<U>::value;
-};
+// std::pair's are never pod-like: their copy-assignment is user-provided, hence copying them with
+// memcpy is undefined (and triggers -Wclass-memaccess with GCC).
 /// @}
 
 /// @brief If `T` is a pointer, just return it. If it is not, return `T&`
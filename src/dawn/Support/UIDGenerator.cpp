@@ -13,18 +13,67 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Support/UIDGenerator.h"
+#include "dawn/Support/Assert.h"
+#include <limits>
+#include <mutex>
 
 namespace dawn {
 
+namespace {
+
+/// Innermost scope of the current thread (may be NULL)
+thread_local UIDScope* currentScope = nullptr;
+
+std::mutex instanceMutex;
+
+} // anonymous namespace
+
 /* Null, because instance will be initialized on demand. */
-UIDGenerator* UIDGenerator::instance_ = 0;
+std::atomic<UIDGenerator*> UIDGenerator::instance_(nullptr);
 
 UIDGenerator* UIDGenerator::getInstance() {
-  if(instance_ == 0) {
-    instance_ = new UIDGenerator();
+  UIDGenerator* instance = instance_.load();
+  if(instance == nullptr) {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    instance = instance_.load();
+    if(instance == nullptr) {
+      instance = new UIDGenerator();
+      instance_.store(instance);
+    }
+  }
+
+  return instance;
+}
+
+int UIDGenerator::get() {
+  if(currentScope) {
+    if(currentScope->next_ < currentScope->end_)
+      return currentScope->next_++;
+    currentScope->exhausted_ = true;
+  }
+  return counter_++;
+}
+
+int UIDGenerator::reserve(int size) {
+  if(currentScope) {
+    if(currentScope->end_ - currentScope->next_ >= size) {
+      int first = currentScope->next_;
+      currentScope->next_ += size;
+      return first;
+    }
+    currentScope->exhausted_ = true;
   }
 
-  return instance_;
+  int first = counter_.fetch_add(size);
+  DAWN_ASSERT_MSG(first <= std::numeric_limits<int>::max() - size, "out of unique identifiers");
+  return first;
 }
 
+UIDScope::UIDScope(int first, int size)
+    : next_(first), end_(first + size), exhausted_(false), parent_(currentScope) {
+  currentScope = this;
+}
+
+UIDScope::~UIDScope() { currentScope = parent_; }
+
 } // namespace dawn
@@ -16,14 +16,20 @@
 #define DAWN_SUPPORT_UIDGENERATOR
 
 #include "dawn/Support/NonCopyable.h"
+#include <atomic>
 
 namespace dawn {
 
 /// @brief Unique identifier generator (starting from @b 1)
+///
+/// The generator is thread-safe. To make the identifiers handed out during a unit of work
+/// independent of concurrently running threads, a range of identifiers can be reserved up front and
+/// activated on the current thread via a `UIDScope`.
+///
 /// @ingroup support
 class UIDGenerator : NonCopyable {
-  int counter_;
-  static UIDGenerator* instance_;
+  std::atomic<int> counter_;
+  static std::atomic<UIDGenerator*> instance_;
 
   UIDGenerator() : counter_(1) {}
 
@@ -31,7 +37,43 @@ public:
   static UIDGenerator* getInstance();
 
   /// @brief Get a unique *strictly* positive identifer
-  int get() { return (counter_++); }
+  ///
+  /// If a `UIDScope` is active on the calling thread, the identifier is taken from its range.
+  int get();
+
+  /// @brief Reserve `size` consecutive identifiers and return the first one
+  ///
+  /// If a `UIDScope` is active on the calling thread, the identifiers are taken from its range.
+  int reserve(int size);
+};
+
+/// @brief Range of identifiers used by `UIDGenerator::get` on the current thread
+///
+/// While the scope is alive, the calling thread draws its identifiers from `[first, first + size)`
+/// (which should have been obtained via `UIDGenerator::reserve`, unless the identifiers handed out
+/// within the scope never meet identifiers handed out elsewhere). Once the range is exhausted,
+/// identifiers are drawn from the shared counter again; they remain unique but no longer depend
+/// solely on the work done on this thread. Scopes may be nested.
+///
+/// @ingroup support
+class UIDScope : NonCopyable {
+  int next_;
+  int end_;
+  bool exhausted_;
+  UIDScope* parent_;
+
+  friend class UIDGenerator;
+
+public:
+  UIDScope(int first, int size);
+  ~UIDScope();
+
+  /// @brief Number of identifiers of the range which have not been handed out yet
+  int getNumRemaining() const { return end_ - next_; }
+
+  /// @brief Check if an identifier was requested after the range was exhausted (and hence drawn
+  /// from the shared counter)
+  bool isExhausted() const { return exhausted_; }
 };
 
 } // namespace dawn
@@ -0,0 +1,54 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_TEST_BENCHMARK_BENCHMARK_H
+#define DAWN_TEST_BENCHMARK_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace dawn {
+namespace benchmark {
+
+/// @brief Median wall time in microseconds of `numRepetitions` calls of `function`
+template <class FunctionType>
+double measure(int numRepetitions, FunctionType&& function) {
+  std::vector<double> times;
+  for(int i = 0; i < numRepetitions; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                              start)
+                        .count());
+  }
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2];
+}
+
+/// @brief Print the time of a benchmark run over `size` elements
+///
+/// The time per element stays roughly constant across the sizes if the benchmarked code scales
+/// linearly.
+inline void report(const std::string& name, std::size_t size, double microseconds) {
+  std::printf("%-40s %10zu %14.1f us %12.1f ns/element\n", name.c_str(), size, microseconds,
+              1000.0 * microseconds / size);
+}
+
+} // namespace benchmark
+} // namespace dawn
+
+#endif
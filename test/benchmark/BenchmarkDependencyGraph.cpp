@@ -0,0 +1,90 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+#include "test/benchmark/Benchmark.h"
+#include <cstdlib>
+#include <string>
+
+using namespace dawn;
+
+namespace {
+
+/// @brief Synthetic graph: every vertex writes to the next `numEdges` vertices and every edge is
+/// inserted `numDuplicates` times (which are merged into the existing edge)
+void buildGraph(iir::DependencyGraphAccesses& graph, int numVertices, int numEdges,
+                int numDuplicates) {
+  for(int duplicate = 0; duplicate < numDuplicates; ++duplicate)
+    for(int from = 0; from < numVertices; ++from) {
+      graph.insertNode(from);
+      for(int i = 1; i <= numEdges; ++i)
+        graph.insertEdge(from, (from + i) % numVertices, iir::Extents{0, 0, 0, 0, 0, 0});
+    }
+}
+
+/// @brief Benchmark the construction of the graph and the lookups of its vertices and edges
+/// @returns `false` if a lookup failed
+bool benchmarkGraph(const iir::StencilMetaInformation& metadata, int numVertices, int numEdges) {
+  const int numDuplicates = 4;
+  const int numRepetitions = 5;
+  const std::string degree = " (degree " + std::to_string(numEdges) + ")";
+
+  auto build = [&]() {
+    iir::DependencyGraphAccesses graph(metadata);
+    buildGraph(graph, numVertices, numEdges, numDuplicates);
+  };
+  benchmark::report("insertEdge" + degree, std::size_t(numVertices) * numEdges * numDuplicates,
+                    benchmark::measure(numRepetitions, build));
+
+  iir::DependencyGraphAccesses graph(metadata);
+  buildGraph(graph, numVertices, numEdges, numDuplicates);
+  std::size_t numFound = 0;
+  auto lookupVertices = [&]() {
+    for(std::size_t VertexID = 0; VertexID < graph.getNumVertices(); ++VertexID)
+      numFound += graph.getVertexIDFromValue(graph.getValueFromVertexID(VertexID)) == VertexID;
+  };
+  benchmark::report("getVertexIDFromValue/getValueFromVertexID", graph.getNumVertices(),
+                    benchmark::measure(numRepetitions, lookupVertices));
+
+  auto lookupEdges = [&]() {
+    for(int from = 0; from < numVertices; ++from)
+      for(int i = 1; i <= numEdges; ++i)
+        numFound += graph.hasEdge(from, (from + i) % numVertices);
+  };
+  benchmark::report("hasEdge" + degree, std::size_t(numVertices) * numEdges,
+                    benchmark::measure(numRepetitions, lookupEdges));
+
+  // Checking the lookups also keeps them from being optimized away
+  return numFound == numRepetitions * graph.getNumVertices() * (1 + numEdges);
+}
+
+} // anonymous namespace
+
+int main() {
+  sir::GlobalVariableMap globals;
+  iir::StencilMetaInformation metadata(globals);
+
+  // Growing number of vertices
+  for(int numVertices : {500, 1000, 2000, 4000, 8000})
+    if(!benchmarkGraph(metadata, numVertices, 32))
+      return EXIT_FAILURE;
+
+  // Growing number of edges per vertex
+  for(int numEdges : {64, 128, 256, 512})
+    if(!benchmarkGraph(metadata, 1000, numEdges))
+      return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
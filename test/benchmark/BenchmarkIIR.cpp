@@ -0,0 +1,96 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/Stencil.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+#include "dawn/SIR/ASTExpr.h"
+#include "dawn/SIR/ASTStmt.h"
+#include "dawn/Support/STLExtras.h"
+#include "test/benchmark/Benchmark.h"
+#include <cstdlib>
+#include <string>
+
+using namespace dawn;
+
+namespace {
+
+/// @brief Build an IIR whose nodes are inserted one at a time into a tree which is already
+/// attached to the root, as the optimizer passes do
+/// @returns `false` if the tree is inconsistent
+bool buildIIR(const sir::GlobalVariableMap& globals, int numMultiStages,
+              int numStagesPerMultiStage, int numStatementsPerStage) {
+  iir::StencilMetaInformation metadata(globals);
+  auto IIR =
+      make_unique<iir::IIR>(globals, std::vector<std::shared_ptr<sir::StencilFunction>>());
+
+  IIR->insertChild(make_unique<iir::Stencil>(metadata, sir::Attr(), 0), IIR);
+  const auto& stencil = IIR->getChildren().back();
+  int stageID = 0;
+  for(int msIdx = 0; msIdx < numMultiStages; ++msIdx) {
+    stencil->insertChild(make_unique<iir::MultiStage>(metadata, iir::LoopOrderKind::LK_Parallel));
+    const auto& multiStage = stencil->getChildren().back();
+
+    for(int stageIdx = 0; stageIdx < numStagesPerMultiStage; ++stageIdx) {
+      multiStage->insertChild(make_unique<iir::Stage>(metadata, stageID++, iir::Interval(0, 10)));
+      iir::DoMethod& doMethod = multiStage->getChildren().back()->getSingleDoMethod();
+
+      for(int stmtIdx = 0; stmtIdx < numStatementsPerStage; ++stmtIdx) {
+        auto stmt = std::make_shared<ExprStmt>(std::make_shared<VarAccessExpr>("var"));
+        auto stmtAccessesPair =
+            make_unique<iir::StatementAccessesPair>(std::make_shared<Statement>(stmt, nullptr));
+        stmtAccessesPair->setAccesses(std::make_shared<iir::Accesses>());
+        doMethod.insertChild(std::move(stmtAccessesPair));
+      }
+    }
+  }
+
+  return stencil->getNumStages() == numMultiStages * numStagesPerMultiStage;
+}
+
+/// @brief Benchmark the construction of an IIR with 10 multi-stages
+/// @returns `false` if a tree is inconsistent
+bool benchmarkIIR(int numStagesPerMultiStage, int numStatementsPerStage) {
+  const int numMultiStages = 10;
+  const int numRepetitions = 5;
+
+  sir::GlobalVariableMap globals;
+  bool consistent = true;
+  auto build = [&]() {
+    consistent &= buildIIR(globals, numMultiStages, numStagesPerMultiStage, numStatementsPerStage);
+  };
+  benchmark::report("insertChild (" + std::to_string(numStagesPerMultiStage) +
+                        " stages per multi-stage)",
+                    std::size_t(numMultiStages) * numStagesPerMultiStage * numStatementsPerStage,
+                    benchmark::measure(numRepetitions, build));
+  return consistent;
+}
+
+} // anonymous namespace
+
+int main() {
+  // Growing number of statements per stage (10k statements with 100 statements per stage)
+  for(int numStatementsPerStage : {10, 100, 1000})
+    if(!benchmarkIIR(10, numStatementsPerStage))
+      return EXIT_FAILURE;
+
+  // Growing number of stages per multi-stage
+  for(int numStagesPerMultiStage : {100, 1000})
+    if(!benchmarkIIR(numStagesPerMultiStage, 10))
+      return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassComputeStageExtents.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/SIR/SIRSerializer.h"
+#include "test/benchmark/Benchmark.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+using namespace dawn;
+
+namespace {
+
+/// @brief Load the SIR `sirFilename` and repeat the statements of its stencil `numCopies` times
+std::shared_ptr<SIR> loadScaledSIR(const std::string& sirFilename, int numCopies) {
+  std::ifstream file(sirFilename);
+  if(!file.good())
+    return nullptr;
+
+  std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  std::shared_ptr<SIR> sir = SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+  std::shared_ptr<BlockStmt>& root = sir->Stencils.front()->StencilDescAst->getRoot();
+  std::vector<std::shared_ptr<Stmt>> statements = root->getStatements();
+  for(int copy = 1; copy < numCopies; ++copy)
+    for(const auto& stmt : statements)
+      root->push_back(stmt->clone());
+  return sir;
+}
+
+/// @brief Benchmark PassComputeStageExtents on the scaled sample `sirFilename`
+/// @returns `false` if the sample could not be compiled
+bool benchmarkStageExtents(const std::string& sirFilename, int numCopies) {
+  const int numRepetitions = 5;
+
+  std::shared_ptr<SIR> sir = loadScaledSIR(sirFilename, numCopies);
+  if(!sir) {
+    std::cerr << "cannot open " << sirFilename << std::endl;
+    return false;
+  }
+
+  DawnCompiler compiler(nullptr);
+  std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(sir);
+  if(compiler.getDiagnostics().hasDiags()) {
+    for(const auto& diag : compiler.getDiagnostics().getQueue())
+      std::cerr << "Compilation Error " << diag->getMessage() << std::endl;
+    return false;
+  }
+
+  for(const auto& instantiationPair : optimizer->getStencilInstantiationMap()) {
+    const auto& instantiation = instantiationPair.second;
+    std::size_t numStages = 0;
+    for(const auto& stencil : instantiation->getStencils())
+      numStages += stencil->getNumStages();
+
+    auto computeExtents = [&]() {
+      PassComputeStageExtents pass;
+      pass.run(instantiation);
+    };
+    benchmark::report(sirFilename.substr(sirFilename.find_last_of('/') + 1) + " (stages)",
+                      numStages, benchmark::measure(numRepetitions, computeExtents));
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  if(argc != 2) {
+    std::cerr << "usage: " << argv[0] << " <directory of compute_extent_test_stencil_*.sir>"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Growing number of stages: the vertical regions of the samples are repeated
+  for(int numCopies : {25, 50, 100, 200, 400})
+    for(const char* sirFilename :
+        {"compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+         "compute_extent_test_stencil_03.sir", "compute_extent_test_stencil_04.sir",
+         "compute_extent_test_stencil_05.sir"})
+      if(!benchmarkStageExtents(std::string(argv[1]) + "/" + sirFilename, numCopies))
+        return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -13,11 +13,18 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn-c/Compiler.h"
+#include "dawn-c/Diagnostics.h"
+#include "dawn-c/Options.h"
 #include "dawn-c/TranslationUnit.h"
+#include "dawn/Compiler/CompilationCache.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/SIR/SIRSerializer.h"
+#include "dawn/Support/Json.h"
 #include "dawn/Unittest/ASTSimplifier.h"
+#include <cstdio>
 #include <cstring>
+#include <dirent.h>
+#include <fstream>
 #include <gtest/gtest.h>
 
 namespace {
@@ -44,7 +51,7 @@ TEST(CompilerTest, CompileEmptySIR) {
   dawnTranslationUnitDestroy(TU);
 }
 
-TEST(CompilerTest, CompileCopyStencil) {
+static std::string makeCopyStencilSIR() {
   using namespace dawn::astgen;
 
   // Build copy stencil
@@ -71,8 +78,11 @@ TEST(CompilerTest, CompileCopyStencil) {
   stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
   sir->Stencils.emplace_back(stencil);
 
-  std::string sirStr =
-      dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+  return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+}
+
+TEST(CompilerTest, CompileCopyStencil) {
+  std::string sirStr = makeCopyStencilSIR();
   dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), nullptr);
 
   char* copyCode = dawnTranslationUnitGetStencil(TU, "copy");
@@ -89,4 +99,888 @@ TEST(CompilerTest, CompileCopyStencil) {
   dawnTranslationUnitDestroy(TU);
 }
 
+static std::string makeSmoothingStencilSIR() {
+  using namespace dawn::astgen;
+
+  // Build a stencil whose second stage reads the temporary of the first one with an offset
+  //
+  //  smooth {
+  //    storage in, out;
+  //    temporary_storage tmp;
+  //
+  //    vertical_region(start, end) {
+  //      tmp = in[i-1] + in[i+1];
+  //      out = tmp[i-1] + tmp[i+1];
+  //    }
+  //  }
+  //
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "smooth";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("tmp"));
+  stencil->Fields.back()->IsTemporary = true;
+
+  auto ast = std::make_shared<dawn::AST>(
+      block(assign(field("tmp"), binop(field("in", {{-1, 0, 0}}), "+", field("in", {{1, 0, 0}}))),
+            assign(field("out"),
+                   binop(field("tmp", {{-1, 0, 0}}), "+", field("tmp", {{1, 0, 0}})))));
+  auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+      ast,
+      std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start, dawn::sir::Interval::End),
+      dawn::sir::VerticalRegion::LK_Forward);
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
+  sir->Stencils.emplace_back(stencil);
+
+  return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+}
+
+TEST(CompilerTest, CompileSmoothingStencilOptimizedCXX) {
+  std::string sirStr = makeSmoothingStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-opt");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  ASSERT_NE(smoothCode, nullptr);
+
+  // The stages are fused within the tiles and the IJ-cached temporary is stored in one IJ-plane
+  // per tile
+  std::string code(smoothCode);
+  EXPECT_NE(code.find("#pragma omp for collapse(2)"), std::string::npos);
+  EXPECT_NE(code.find("m_tile_tmp(m_tile_scratch_meta_data_1)"), std::string::npos);
+  EXPECT_NE(code.find("tmp(i+-1+tmp_offsets[0],j+0+tmp_offsets[1],0)"), std::string::npos);
+
+  // The stencil itself does not allocate the tile-local temporary
+  EXPECT_EQ(code.find("m_scratch_meta_data_1"), std::string::npos);
+  EXPECT_EQ(code.find("make_host_view(m_tmp)"), std::string::npos);
+  EXPECT_EQ(code.find("m_tmp("), std::string::npos);
+
+  // The tiles use the CPU default size unless a block size is given
+  EXPECT_NE(code.find("tile_isize = 64"), std::string::npos);
+  EXPECT_NE(code.find("tile_jsize = 4"), std::string::npos);
+  std::free(smoothCode);
+  dawnTranslationUnitDestroy(TU);
+
+  entry = dawnOptionsEntryCreateString("16,2,1");
+  dawnOptionsSet(options, "block_size", entry);
+  dawnOptionsEntryDestroy(entry);
+  TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  ASSERT_NE(smoothCode, nullptr);
+  code = smoothCode;
+  EXPECT_NE(code.find("tile_isize = 16"), std::string::npos);
+  EXPECT_NE(code.find("tile_jsize = 2"), std::string::npos);
+
+  std::free(smoothCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileStagewiseStencilOptimizedCXX) {
+  using namespace dawn::astgen;
+
+  // Build a stencil whose second stage reads a field written by the first one with an offset,
+  // which prevents the fusion of the stages in tiles
+  //
+  //  shift {
+  //    storage in, mid, out;
+  //
+  //    vertical_region(start, end) {
+  //      mid = in;
+  //      out = mid[i-1] + mid[i+1];
+  //    }
+  //  }
+  //
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "shift";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("mid"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+
+  auto ast = std::make_shared<dawn::AST>(
+      block(assign(field("mid"), field("in")),
+            assign(field("out"),
+                   binop(field("mid", {{-1, 0, 0}}), "+", field("mid", {{1, 0, 0}})))));
+  auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+      ast,
+      std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start, dawn::sir::Interval::End),
+      dawn::sir::VerticalRegion::LK_Forward);
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
+  sir->Stencils.emplace_back(stencil);
+  std::string sirStr =
+      dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-opt");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* shiftCode = dawnTranslationUnitGetStencil(TU, "shift");
+  ASSERT_NE(shiftCode, nullptr);
+
+  // The threads are created once outside of the vertical loop and the stages are distributed among
+  // them with work-sharing loops
+  std::string code(shiftCode);
+  auto region = code.find("#pragma omp parallel\n");
+  ASSERT_NE(region, std::string::npos);
+  EXPECT_EQ(code.find("#pragma omp parallel", region + 1), std::string::npos);
+  auto kLoop = code.find("for(int k = ", region);
+  auto firstStage = code.find("#pragma omp for collapse(2) schedule(static)", region);
+  ASSERT_NE(kLoop, std::string::npos);
+  ASSERT_NE(firstStage, std::string::npos);
+  EXPECT_LT(kLoop, firstStage);
+  EXPECT_NE(code.find("#pragma omp for collapse(2) schedule(static)", firstStage + 1),
+            std::string::npos);
+
+  std::free(shiftCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+static std::string makeAbsStencilSIR() {
+  using namespace dawn::astgen;
+
+  // Build a stencil with a branch
+  //
+  //  abs {
+  //    storage in, out;
+  //
+  //    vertical_region(start, end) {
+  //      if(in > 0)
+  //        out = in;
+  //      else
+  //        out = -in;
+  //    }
+  //  }
+  //
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "abs";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+
+  auto ast = std::make_shared<dawn::AST>(
+      block(ifstmt(expr(binop(field("in"), ">", lit("0"))), block(assign(field("out"), field("in"))),
+                   block(assign(field("out"), unop(field("in"), "-"))))));
+  auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+      ast,
+      std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start, dawn::sir::Interval::End),
+      dawn::sir::VerticalRegion::LK_Forward);
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
+  sir->Stencils.emplace_back(stencil);
+
+  return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+}
+
+TEST(CompilerTest, CompileAbsStencilVectorizedCXX) {
+  std::string sirStr = makeAbsStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "Vectorize", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* absCode = dawnTranslationUnitGetStencil(TU, "abs");
+  ASSERT_NE(absCode, nullptr);
+
+  // The innermost loop accesses the fields through raw pointers and the branch is converted to
+  // selects
+  std::string code(absCode);
+  EXPECT_NE(code.find("#pragma omp simd"), std::string::npos);
+  EXPECT_NE(code.find("const int out_jstride"), std::string::npos);
+  EXPECT_NE(code.find("const bool mask_0 = "), std::string::npos);
+  EXPECT_NE(code.find("out_ptr[(i+0)*out_istride + (j+0)*out_jstride + (k+0)*out_kstride] = "
+                      "(!mask_0) ? "),
+            std::string::npos);
+
+  // The loop order is chosen at runtime such that the unit-stride dimension is the innermost loop
+  EXPECT_NE(code.find("const int unit_stride_dim = (in_istride == 1 && out_istride == 1) ? 0 : "
+                      "(in_kstride == 1 && out_kstride == 1) ? 2 : 1;"),
+            std::string::npos);
+  EXPECT_NE(code.find("if(unit_stride_dim == 0)"), std::string::npos);
+  EXPECT_NE(code.find("if(unit_stride_dim == 2)"), std::string::npos);
+
+  std::free(absCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileSideEffectBranchVectorizedCXX) {
+  using namespace dawn::astgen;
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "incr";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+
+  auto ast = std::make_shared<dawn::AST>(block(ifstmt(
+      expr(binop(field("in"), ">", lit("0"))), block(assign(field("out"), unop(field("in"), "++"))),
+      block(assign(field("out"), field("in"))))));
+  auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+      ast,
+      std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start, dawn::sir::Interval::End),
+      dawn::sir::VerticalRegion::LK_Forward);
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
+  sir->Stencils.emplace_back(stencil);
+  std::string sirStr =
+      dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "Vectorize", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* incrCode = dawnTranslationUnitGetStencil(TU, "incr");
+  ASSERT_NE(incrCode, nullptr);
+
+  // The increment must not be evaluated where the condition does not hold, the branch is kept
+  std::string code(incrCode);
+  EXPECT_EQ(code.find("const bool mask_"), std::string::npos);
+  EXPECT_NE(code.find("if(("), std::string::npos);
+
+  std::free(incrCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+static std::string makeTwoStageStencilSIR() {
+  using namespace dawn::astgen;
+
+  // Build a stencil of two stages which only depend pointwise on each other
+  //
+  //  two_stages {
+  //    storage in, out;
+  //    temporary_storage tmp;
+  //
+  //    vertical_region(start, end) {
+  //      tmp = in + in;
+  //    }
+  //    vertical_region(start, end) {
+  //      out = tmp + in[i+1];
+  //    }
+  //  }
+  //
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "two_stages";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("tmp"));
+  stencil->Fields.back()->IsTemporary = true;
+
+  auto makeVerticalRegion = [](const std::shared_ptr<dawn::Stmt>& stmt) {
+    auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+        std::make_shared<dawn::AST>(block(stmt)),
+        std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start,
+                                              dawn::sir::Interval::End),
+        dawn::sir::VerticalRegion::LK_Forward);
+    return verticalRegion(vr);
+  };
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(
+      block(makeVerticalRegion(expr(assign(field("tmp"), binop(field("in"), "+", field("in"))))),
+            makeVerticalRegion(expr(
+                assign(field("out"), binop(field("tmp"), "+", field("in", {{1, 0, 0}})))))));
+  sir->Stencils.emplace_back(stencil);
+
+  return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+}
+
+TEST(CompilerTest, CompileTwoStageStencilFusedCXX) {
+  std::string sirStr = makeTwoStageStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "FuseHorizontalLoops", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* twoStagesCode = dawnTranslationUnitGetStencil(TU, "two_stages");
+  ASSERT_NE(twoStagesCode, nullptr);
+
+  // Both stages are computed in the same horizontal loops and the temporary is kept in a local
+  // variable
+  std::string code(twoStagesCode);
+  auto firstLoop = code.find("for(int j");
+  ASSERT_NE(firstLoop, std::string::npos);
+  EXPECT_EQ(code.find("for(int j", firstLoop + 1), std::string::npos);
+  EXPECT_NE(code.find("gridtools::clang::float_type tmp_reg;"), std::string::npos);
+  EXPECT_NE(code.find("out(i+0,j+0,k+0) = (tmp_reg + "), std::string::npos);
+
+  std::free(twoStagesCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileSmoothingStencilFusedCXX) {
+  std::string sirStr = makeSmoothingStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "FuseHorizontalLoops", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  ASSERT_NE(smoothCode, nullptr);
+
+  // The temporary read with offsets is recomputed around every column of the fused loops and
+  // stored in a per-column buffer
+  std::string code(smoothCode);
+  auto firstLoop = code.find("for(int j");
+  ASSERT_NE(firstLoop, std::string::npos);
+  EXPECT_EQ(code.find("for(int j", firstLoop + 1), std::string::npos);
+  EXPECT_NE(code.find("gridtools::clang::float_type tmp_buf[3][1];"), std::string::npos);
+  EXPECT_NE(code.find("for(int i_off = -1; i_off <= 1; ++i_off)"), std::string::npos);
+  EXPECT_NE(code.find("const int i = i_col + i_off;"), std::string::npos);
+  EXPECT_NE(code.find("tmp_buf[i+0-i_col+1][0] = "), std::string::npos);
+  EXPECT_NE(code.find("out(i+0,j+0,k+0) = (tmp_buf[i+-1-i_col+1][0] + tmp_buf[i+1-i_col+1][0])"),
+            std::string::npos);
+
+  std::free(smoothCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileTwoStageStencilInstrumentedCXX) {
+  std::string sirStr = makeTwoStageStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "Instrument", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* twoStagesCode = dawnTranslationUnitGetStencil(TU, "two_stages");
+  char* globalsCode = dawnTranslationUnitGetGlobals(TU);
+  ASSERT_NE(twoStagesCode, nullptr);
+  ASSERT_NE(globalsCode, nullptr);
+
+  // The hook interface is emitted with the globals and the stencil as well as its multi-stage are
+  // wrapped in probes
+  std::string globals(globalsCode);
+  EXPECT_NE(globals.find("namespace dawn_instrumentation"), std::string::npos);
+  EXPECT_NE(globals.find("#ifdef DAWN_DISABLE_INSTRUMENTATION"), std::string::npos);
+
+  std::string code(twoStagesCode);
+  auto stencilBegin = code.find("dawn_instrumentation::begin(stencil_probe)");
+  auto multiStageBegin = code.find("dawn_instrumentation::begin(multistage_probe)");
+  auto multiStageEnd = code.find("dawn_instrumentation::end(multistage_probe)");
+  auto stencilEnd = code.find("dawn_instrumentation::end(stencil_probe)");
+  ASSERT_NE(stencilEnd, std::string::npos);
+  EXPECT_LT(stencilBegin, multiStageBegin);
+  EXPECT_LT(multiStageBegin, multiStageEnd);
+  EXPECT_LT(multiStageEnd, stencilEnd);
+  EXPECT_NE(code.find("dawn_instrumentation::probe stencil_probe{\"two_stages\", "),
+            std::string::npos);
+
+  std::free(twoStagesCode);
+  std::free(globalsCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileSmoothingStencilBenchmarkCXX) {
+  std::string sirStr = makeSmoothingStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "Benchmark", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  char* globalsCode = dawnTranslationUnitGetGlobals(TU);
+  ASSERT_NE(smoothCode, nullptr);
+  ASSERT_NE(globalsCode, nullptr);
+
+  // The benchmark runtime is emitted with the globals
+  std::string globals(globalsCode);
+  EXPECT_NE(globals.find("namespace dawn_benchmark"), std::string::npos);
+  EXPECT_NE(globals.find("#ifdef DAWN_BENCHMARK_MAIN"), std::string::npos);
+
+  // The driver follows the stencil wrapper, the domain has the halo of the accesses to `in` (the
+  // stages are computed on the extended domain of `tmp`)
+  std::string code(smoothCode);
+  auto wrapper = code.find("class smooth");
+  auto driver = code.find("inline void benchmark_smooth(const config& cfg)");
+  ASSERT_NE(driver, std::string::npos);
+  EXPECT_LT(wrapper, driver);
+  EXPECT_NE(code.find("domain dom(cfg.isize + 4, cfg.jsize + 0, cfg.ksize)"), std::string::npos);
+  EXPECT_NE(code.find("dom.set_halos(2, 2, 0, 0, 0, 0)"), std::string::npos);
+  EXPECT_NE(code.find("fill_field(in, 0, dom.isize(), dom.jsize(), dom.ksize())"),
+            std::string::npos);
+  EXPECT_NE(code.find("fill_field(out, 1, dom.isize(), dom.jsize(), dom.ksize())"),
+            std::string::npos);
+  EXPECT_NE(code.find("cxxnaive::smooth stencil(dom, in, out)"), std::string::npos);
+  EXPECT_NE(code.find("static registrar register_smooth(\"smooth\", benchmark_smooth)"),
+            std::string::npos);
+
+  std::free(smoothCode);
+  std::free(globalsCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileSmoothingStencilBenchmarkOptimizedCXX) {
+  std::string sirStr = makeSmoothingStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-opt");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(options, "Benchmark", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  char* globalsCode = dawnTranslationUnitGetGlobals(TU);
+  ASSERT_NE(smoothCode, nullptr);
+  ASSERT_NE(globalsCode, nullptr);
+  EXPECT_NE(std::string(globalsCode).find("namespace dawn_benchmark"), std::string::npos);
+
+  // The tiled stencil wrapper is emitted in the namespace of the naive backend, which is the one
+  // referred to by the driver
+  std::string code(smoothCode);
+  auto wrapperNamespace = code.find("namespace cxxnaive");
+  auto wrapper = code.find("class smooth");
+  auto tiles = code.find("#pragma omp for collapse(2)");
+  auto driver = code.find("inline void benchmark_smooth(const config& cfg)");
+  ASSERT_NE(wrapperNamespace, std::string::npos);
+  ASSERT_NE(tiles, std::string::npos);
+  ASSERT_NE(driver, std::string::npos);
+  EXPECT_LT(wrapperNamespace, wrapper);
+  EXPECT_LT(tiles, driver);
+  EXPECT_NE(code.find("domain dom(cfg.isize + 4, cfg.jsize + 0, cfg.ksize)"), std::string::npos);
+  EXPECT_NE(code.find("cxxnaive::smooth stencil(dom, in, out)", driver), std::string::npos);
+  EXPECT_NE(code.find("static registrar register_smooth(\"smooth\", benchmark_smooth)", driver),
+            std::string::npos);
+
+  std::free(smoothCode);
+  std::free(globalsCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+static std::string makeVerticalShiftStencilSIR() {
+  using namespace dawn::astgen;
+
+  // Build a stencil which reads the temporary at the level below
+  //
+  //  vertical_shift {
+  //    storage in, out;
+  //    temporary_storage tmp;
+  //
+  //    vertical_region(start, end) {
+  //      tmp = in;
+  //      out = tmp[k-1] + tmp;
+  //    }
+  //  }
+  //
+  auto sir = std::make_shared<dawn::SIR>();
+  auto stencil = std::make_shared<dawn::sir::Stencil>();
+  stencil->Name = "vertical_shift";
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("in"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("out"));
+  stencil->Fields.emplace_back(std::make_shared<dawn::sir::Field>("tmp"));
+  stencil->Fields.back()->IsTemporary = true;
+
+  auto ast = std::make_shared<dawn::AST>(
+      block(assign(field("tmp"), field("in")),
+            assign(field("out"), binop(field("tmp", {{0, 0, -1}}), "+", field("tmp")))));
+  auto vr = std::make_shared<dawn::sir::VerticalRegion>(
+      ast,
+      std::make_shared<dawn::sir::Interval>(dawn::sir::Interval::Start, dawn::sir::Interval::End),
+      dawn::sir::VerticalRegion::LK_Forward);
+  stencil->StencilDescAst = std::make_shared<dawn::AST>(block(verticalRegion(vr)));
+  sir->Stencils.emplace_back(stencil);
+
+  return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+}
+
+TEST(CompilerTest, CompileVerticalShiftStencilScratchBufferCXX) {
+  std::string sirStr = makeVerticalShiftStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString("c++-naive");
+  dawnOptionsSet(options, "Backend", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* shiftCode = dawnTranslationUnitGetStencil(TU, "vertical_shift");
+  ASSERT_NE(shiftCode, nullptr);
+
+  // The K-cached temporary is stored in a ring buffer of two IJ-planes
+  std::string code(shiftCode);
+  EXPECT_EQ(code.find("m_tmp_meta_data"), std::string::npos);
+  EXPECT_NE(code.find("m_scratch_meta_data_2(dom_.isize(), dom_.jsize(), 2)"), std::string::npos);
+  EXPECT_NE(code.find("tmp(i+0,j+0,((k+-1)%2+2)%2)"), std::string::npos);
+
+  std::free(shiftCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+/// @brief Tests of the compilation cache, the cache directory is removed after each test
+class CompilationCacheTest : public ::testing::Test {
+protected:
+  const char* cacheDir_ = "dawn_compilation_cache_test";
+
+  virtual void TearDown() override {
+    if(DIR* dir = opendir(cacheDir_)) {
+      while(dirent* dirEntry = readdir(dir)) {
+        const std::string name = dirEntry->d_name;
+        if(name != "." && name != "..")
+          std::remove((std::string(cacheDir_) + "/" + name).c_str());
+      }
+      closedir(dir);
+    }
+    std::remove(cacheDir_);
+  }
+};
+
+TEST_F(CompilationCacheTest, CompileCopyStencil) {
+  std::string sirStr = makeCopyStencilSIR();
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString(cacheDir_);
+  dawnOptionsSet(options, "CacheDir", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  std::string key = dawn::CompilationCache::computeKey(sirStr, dawn::Options{});
+  dawn::CompilationCache cache(cacheDir_);
+
+  // Cache miss: compile and populate the cache
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* copyCode = dawnTranslationUnitGetStencil(TU, "copy");
+  ASSERT_NE(copyCode, nullptr);
+  dawn::DiagnosticsQueue diagnostics;
+  ASSERT_NE(cache.lookup(sirStr, dawn::Options{}, diagnostics), nullptr);
+
+  // Cache hit: the translation unit is restored from the cache
+  dawnTranslationUnit_t* cachedTU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* cachedCopyCode = dawnTranslationUnitGetStencil(cachedTU, "copy");
+  ASSERT_NE(cachedCopyCode, nullptr);
+  EXPECT_STREQ(copyCode, cachedCopyCode);
+
+  // Different options yield a different key
+  dawn::Options otherOptions;
+  otherOptions.Backend = "c++-naive";
+  EXPECT_NE(dawn::CompilationCache::computeKey(sirStr, otherOptions), key);
+  EXPECT_NE(dawn::CompilationCache::computeKey(sirStr + " ", dawn::Options{}), key);
+
+  std::free(copyCode);
+  std::free(cachedCopyCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnTranslationUnitDestroy(cachedTU);
+  dawnOptionsDestroy(options);
+}
+
+TEST_F(CompilationCacheTest, ReplaysDiagnostics) {
+  dawn::CompilationCache cache(cacheDir_);
+
+  dawn::codegen::TranslationUnit TU("file.cpp", {"#define A 1"}, {{"copy", "code"}}, "globals");
+  dawn::DiagnosticsQueue diagnostics;
+  diagnostics.push_back(dawn::DiagnosticsMessage(
+      dawn::DiagnosticsKind::Warning, dawn::SourceLocation(3, 7), "file.cpp", "unused field"));
+  ASSERT_TRUE(cache.insert("diagnostics", dawn::Options{}, TU, diagnostics));
+
+  dawn::DiagnosticsQueue replayed;
+  auto cachedTU = cache.lookup("diagnostics", dawn::Options{}, replayed);
+  ASSERT_NE(cachedTU, nullptr);
+  EXPECT_EQ(cachedTU->getStencils().at("copy"), "code");
+  ASSERT_EQ(replayed.queue().size(), 1u);
+  const dawn::DiagnosticsMessage& diag = *replayed.queue().front();
+  EXPECT_EQ(diag.getDiagKind(), dawn::DiagnosticsKind::Warning);
+  EXPECT_EQ(diag.getSourceLocation().Line, 3);
+  EXPECT_EQ(diag.getSourceLocation().Column, 7);
+  EXPECT_EQ(diag.getFilename(), "file.cpp");
+  EXPECT_EQ(diag.getMessage(), "unused field");
+  EXPECT_TRUE(replayed.hasWarnings());
+}
+
+TEST_F(CompilationCacheTest, RejectsEntryOfDifferentInputs) {
+  dawn::CompilationCache cache(cacheDir_);
+  dawn::codegen::TranslationUnit TU("file.cpp", {}, {{"copy", "code"}}, "globals");
+  ASSERT_TRUE(cache.insert("sir", dawn::Options{}, TU, dawn::DiagnosticsQueue{}));
+
+  // Store the entry under the key of other inputs, as a hash collision would
+  const std::string otherKey = dawn::CompilationCache::computeKey("other sir", dawn::Options{});
+  dawn::json::json node;
+  std::ifstream ifs(cache.getEntryPath(dawn::CompilationCache::computeKey("sir", dawn::Options{})));
+  ifs >> node;
+  node["key"] = otherKey;
+  std::ofstream ofs(cache.getEntryPath(otherKey));
+  ofs << node.dump();
+  ofs.close();
+
+  dawn::DiagnosticsQueue diagnostics;
+  EXPECT_NE(cache.lookup("sir", dawn::Options{}, diagnostics), nullptr);
+  EXPECT_EQ(cache.lookup("other sir", dawn::Options{}, diagnostics), nullptr);
+}
+
+TEST_F(CompilationCacheTest, SkipsSideEffects) {
+  EXPECT_TRUE(dawn::CompilationCache::isCacheable(dawn::Options{}));
+
+  dawn::Options options;
+  options.Backend = "c++-naive";
+  options.MergeStages = true;
+  EXPECT_TRUE(dawn::CompilationCache::isCacheable(options));
+
+  // Options writing files or reports
+  options = dawn::Options{};
+  options.SerializeIIR = true;
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+  options = dawn::Options{};
+  options.ReportAccesses = true;
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+  options = dawn::Options{};
+  options.DumpStageGraph = true;
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+  options = dawn::Options{};
+  options.ProfilePasses = "profile.json";
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+  options = dawn::Options{};
+  options.PerformanceModel = "model.json";
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+
+  // Tuned compilations
+  options = dawn::Options{};
+  options.TuningDB = "tuning.json";
+  EXPECT_FALSE(dawn::CompilationCache::isCacheable(options));
+
+  // A compilation with a report does not populate the cache
+  std::string sirStr = makeCopyStencilSIR();
+  dawnOptions_t* cOptions = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString(cacheDir_);
+  dawnOptionsSet(cOptions, "CacheDir", entry);
+  dawnOptionsEntryDestroy(entry);
+  entry = dawnOptionsEntryCreateInteger(1);
+  dawnOptionsSet(cOptions, "ReportDataLocalityMetric", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  options = dawn::Options{};
+  options.ReportDataLocalityMetric = true;
+  dawn::CompilationCache cache(cacheDir_);
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), cOptions);
+  ASSERT_NE(TU, nullptr);
+  dawn::DiagnosticsQueue diagnostics;
+  EXPECT_EQ(cache.lookup(sirStr, options, diagnostics), nullptr);
+
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(cOptions);
+}
+
+static void setStringOption(dawnOptions_t* options, const char* name, const char* value) {
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateString(value);
+  dawnOptionsSet(options, name, entry);
+  dawnOptionsEntryDestroy(entry);
+}
+
+TEST(CompilerTest, CompileAutotunedCXX) {
+  // Tune the copy and the smoothing stencil of the same SIR
+  auto sir = dawn::SIRSerializer::deserializeFromString(makeCopyStencilSIR(),
+                                                        dawn::SIRSerializer::SK_Byte);
+  auto smoothSIR = dawn::SIRSerializer::deserializeFromString(makeSmoothingStencilSIR(),
+                                                              dawn::SIRSerializer::SK_Byte);
+  sir->Stencils.push_back(smoothSIR->Stencils.front());
+  std::string sirStr =
+      dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+
+  const char* tuningDB = "dawn_tuning_db_test.json";
+  std::remove(tuningDB);
+
+  // The benchmark harness reports the lowest runtime for tiles of 16 points in i-direction
+  dawnOptions_t* options = dawnOptionsCreate();
+  setStringOption(options, "Backend", "c++-opt");
+  setStringOption(options, "TuningDB", tuningDB);
+  setStringOption(options, "TuningSpace", "block-size=64,4,4|16,4,4|32,4,4");
+  setStringOption(options, "Autotune",
+                  "sh -c 'grep -q \"tile_isize = 16\" \"$0\" && echo 0.5 || echo 2.0'");
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* copyCode = dawnTranslationUnitGetStencil(TU, "copy");
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  ASSERT_NE(copyCode, nullptr);
+  ASSERT_NE(smoothCode, nullptr);
+  EXPECT_NE(std::string(smoothCode).find("tile_isize = 16"), std::string::npos);
+
+  // The fastest configuration of each stencil is recorded
+  std::ifstream ifs(tuningDB);
+  dawn::json::json database;
+  ifs >> database;
+  ASSERT_EQ(database["entries"].size(), 2);
+  for(const auto& entry : database["entries"]) {
+    EXPECT_EQ(entry["backend"], "c++-opt");
+    EXPECT_EQ(entry["runtime"], 0.5);
+    EXPECT_EQ(entry["options"]["block-size"], "16,4,4");
+  }
+
+  // Later compilations use the recorded configuration without benchmarking
+  setStringOption(options, "Autotune", "");
+  dawnTranslationUnit_t* tunedTU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* tunedSmoothCode = dawnTranslationUnitGetStencil(tunedTU, "smooth");
+  ASSERT_NE(tunedSmoothCode, nullptr);
+  EXPECT_NE(std::string(tunedSmoothCode).find("tile_isize = 16"), std::string::npos);
+
+  // A failing benchmark harness is reported as error
+  setStringOption(options, "Autotune", "false");
+  const char* SIRs[] = {sirStr.data()};
+  const size_t sizes[] = {sirStr.size()};
+  dawnTranslationUnit_t* failedTU;
+  dawnDiagnostics_t* diagnostics;
+  EXPECT_EQ(dawnCompileBatch(1, SIRs, sizes, options, &failedTU, &diagnostics), 1);
+  EXPECT_EQ(failedTU, nullptr);
+  EXPECT_TRUE(dawnDiagnosticsHasErrors(diagnostics));
+
+  std::remove(tuningDB);
+  std::free(copyCode);
+  std::free(smoothCode);
+  std::free(tunedSmoothCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnTranslationUnitDestroy(tunedTU);
+  dawnDiagnosticsDestroy(diagnostics);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileAutotunedCXXReport) {
+  std::string sirStr = makeSmoothingStencilSIR();
+  const char* tuningDB = "dawn_tuning_db_report_test.json";
+  const char* report = "dawn_tuning_performance_model_test.json";
+  std::remove(tuningDB);
+  std::remove(report);
+
+  // The benchmark harness fails if the report was written by the benchmarked compilations
+  dawnOptions_t* options = dawnOptionsCreate();
+  setStringOption(options, "Backend", "c++-opt");
+  setStringOption(options, "TuningDB", tuningDB);
+  setStringOption(options, "TuningSpace", "block-size=64,4,4|16,4,4");
+  setStringOption(options, "PerformanceModel", report);
+  const std::string harness = std::string("sh -c 'test -e ") + report +
+                              " && exit 1; grep -q \"tile_isize = 16\" \"$0\" && echo 0.5 || "
+                              "echo 2.0'";
+  setStringOption(options, "Autotune", harness.c_str());
+
+  dawnTranslationUnit_t* TU = dawnCompile(sirStr.data(), sirStr.size(), options);
+  char* smoothCode = dawnTranslationUnitGetStencil(TU, "smooth");
+  ASSERT_NE(smoothCode, nullptr);
+  EXPECT_NE(std::string(smoothCode).find("tile_isize = 16"), std::string::npos);
+
+  // The report is written once for the fastest configuration
+  std::ifstream ifs(report);
+  ASSERT_TRUE(ifs.good());
+  dawn::json::json node;
+  ifs >> node;
+  EXPECT_EQ(node["stencil_instantiations"].size(), 1);
+
+  std::remove(tuningDB);
+  std::remove(report);
+  std::free(smoothCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileBatch) {
+  std::string copySIR = makeCopyStencilSIR();
+  std::string smoothSIR = makeSmoothingStencilSIR();
+  std::string invalidSIR = "not a serialized SIR";
+
+  const char* SIRs[] = {copySIR.data(), invalidSIR.data(), smoothSIR.data()};
+  const size_t sizes[] = {copySIR.size(), invalidSIR.size(), smoothSIR.size()};
+
+  dawnOptions_t* options = dawnOptionsCreate();
+  dawnOptionsEntry_t* entry = dawnOptionsEntryCreateInteger(2);
+  dawnOptionsSet(options, "Jobs", entry);
+  dawnOptionsEntryDestroy(entry);
+
+  // The invalid SIR is reported to its diagnostics instead of the FatalErrorHandler
+  dawnTranslationUnit_t* TUs[3];
+  dawnDiagnostics_t* diagnostics[3];
+  EXPECT_EQ(dawnCompileBatch(3, SIRs, sizes, options, TUs, diagnostics), 1);
+
+  ASSERT_NE(TUs[0], nullptr);
+  char* copyCode = dawnTranslationUnitGetStencil(TUs[0], "copy");
+  EXPECT_NE(copyCode, nullptr);
+  EXPECT_FALSE(dawnDiagnosticsHasErrors(diagnostics[0]));
+
+  EXPECT_EQ(TUs[1], nullptr);
+  ASSERT_TRUE(dawnDiagnosticsHasErrors(diagnostics[1]));
+  ASSERT_EQ(dawnDiagnosticsGetNumDiagnostics(diagnostics[1]), 1);
+  DawnDiagnosticsKind diag;
+  char* msg;
+  dawnDiagnosticsGet(diagnostics[1], 0, &diag, nullptr, nullptr, nullptr, &msg);
+  EXPECT_EQ(diag, DD_Error);
+  EXPECT_NE(std::strlen(msg), 0);
+
+  ASSERT_NE(TUs[2], nullptr);
+  char* smoothCode = dawnTranslationUnitGetStencil(TUs[2], "smooth");
+  EXPECT_NE(smoothCode, nullptr);
+
+  // The code equals the one of a serial compilation
+  dawnTranslationUnit_t* serialTU = dawnCompile(smoothSIR.data(), smoothSIR.size(), options);
+  char* serialSmoothCode = dawnTranslationUnitGetStencil(serialTU, "smooth");
+  EXPECT_STREQ(smoothCode, serialSmoothCode);
+
+  std::free(copyCode);
+  std::free(smoothCode);
+  std::free(serialSmoothCode);
+  std::free(msg);
+  dawnTranslationUnitDestroy(serialTU);
+  for(int i = 0; i < 3; ++i) {
+    dawnTranslationUnitDestroy(TUs[i]);
+    dawnDiagnosticsDestroy(diagnostics[i]);
+  }
+  dawnOptionsDestroy(options);
+}
+
+TEST(CompilerTest, CompileAsync) {
+  std::string sirStr = makeCopyStencilSIR();
+  dawnCompilation_t* compilation = dawnCompileAsync(sirStr.data(), sirStr.size(), nullptr);
+
+  // The SIR has been copied
+  sirStr.clear();
+
+  dawnDiagnostics_t* diagnostics;
+  dawnTranslationUnit_t* TU = dawnCompilationGet(compilation, &diagnostics);
+  EXPECT_TRUE(dawnCompilationIsReady(compilation));
+  EXPECT_FALSE(dawnDiagnosticsHasErrors(diagnostics));
+
+  ASSERT_NE(TU, nullptr);
+  char* copyCode = dawnTranslationUnitGetStencil(TU, "copy");
+  EXPECT_NE(copyCode, nullptr);
+
+  std::free(copyCode);
+  dawnTranslationUnitDestroy(TU);
+  dawnDiagnosticsDestroy(diagnostics);
+  dawnCompilationDestroy(compilation);
+}
+
 } // anonymous namespace
@@ -47,7 +47,9 @@ public:
   static constexpr const char* name = "Node4";
   Node4(int val) : val_(val) {}
   Node4(Node4&& other) : val_(other.val_) {}
+  virtual void updateLevel() override { ++numUpdateLevel_; }
   int val_;
+  int numUpdateLevel_ = 0;
 };
 }
 
@@ -337,4 +339,53 @@ TEST_F(IIRNode, ReverseIterators) {
 }
 
 TEST_F(IIRNode, getChild) {}
+
+// test that the deferred update recomputes every dirty ancestor exactly once
+TEST_F(IIRNode, updateDirtyDerivedInfo) {
+  for(const auto& n2 : root_->getChildren()) {
+    for(const auto& n3 : n2->getChildren()) {
+      EXPECT_FALSE(n3->isDerivedInfoDirty());
+      n3->invalidateTreeAbove();
+      EXPECT_FALSE(n3->isDerivedInfoDirty());
+    }
+    EXPECT_TRUE(n2->isDerivedInfoDirty());
+  }
+  EXPECT_TRUE(root_->isDerivedInfoDirty());
+
+  auto& statistics = iir::NodeUpdateStatistics::getThreadLocal();
+  unsigned long numUpdates = statistics.NumUpdateFromChildren;
+  root_->updateDirtyDerivedInfo();
+  // the two Node2 and the root
+  EXPECT_EQ(statistics.NumUpdateFromChildren - numUpdates, 3);
+
+  EXPECT_FALSE(root_->isDerivedInfoDirty());
+  for(const auto& n2 : root_->getChildren())
+    EXPECT_FALSE(n2->isDerivedInfoDirty());
+
+  // only the path from the invalidated node to the root is recomputed
+  const auto& n2_1 = root_->getChildren()[1];
+  (*n2_1->childrenBegin())->invalidateTreeAbove();
+  numUpdates = statistics.NumUpdateFromChildren;
+  root_->updateDirtyDerivedInfo();
+  EXPECT_EQ(statistics.NumUpdateFromChildren - numUpdates, 2);
+}
+
+// test that a dirty node is recomputed from its own level, as `update(level)` would
+TEST_F(IIRNode, markDerivedInfoDirty) {
+  const auto& n2_1 = root_->getChildren()[1];
+  const auto& n3_4 = *std::next(n2_1->childrenBegin());
+  const auto& n4_16 = *std::next(n3_4->childrenBegin());
+
+  n4_16->markDerivedInfoDirty();
+  EXPECT_TRUE(n4_16->isDerivedInfoDirty());
+  EXPECT_TRUE(n3_4->isDerivedInfoDirty());
+  EXPECT_TRUE(root_->isDerivedInfoDirty());
+  EXPECT_FALSE(root_->getChildren()[0]->isDerivedInfoDirty());
+
+  root_->updateDirtyDerivedInfo();
+  EXPECT_EQ(n4_16->numUpdateLevel_, 1);
+  EXPECT_EQ((*n3_4->childrenBegin())->numUpdateLevel_, 0);
+  EXPECT_FALSE(n4_16->isDerivedInfoDirty());
+  EXPECT_FALSE(root_->isDerivedInfoDirty());
+}
 }
@@ -19,6 +19,8 @@
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Serialization/MappedIIR.h"
+#include <cstdio>
 #include <gtest/gtest.h>
 
 using namespace dawn;
@@ -327,4 +329,62 @@ TEST_F(IIRSerializerTest, IIRTests) {
   (IIRDoMethod)->insertChild(std::move(stmtAccessPair));
 }
 
+TEST_F(IIRSerializerTest, MappedByte) {
+  referenceInstantiaton->getMetaData().setFileName("fileName");
+  referenceInstantiaton->getMetaData().setStencilname("stencilName");
+  referenceInstantiaton->getMetaData().insertAccessOfType(iir::FieldAccessType::FAT_APIField, 10,
+                                                          "field");
+  referenceInstantiaton->getIIR()->insertChild(
+      make_unique<iir::Stencil>(referenceInstantiaton->getMetaData(), sir::Attr(), 10),
+      referenceInstantiaton->getIIR());
+  const auto& IIRStencil = referenceInstantiaton->getIIR()->getChild(0);
+  IIRStencil->insertChild(make_unique<iir::MultiStage>(referenceInstantiaton->getMetaData(),
+                                                       iir::LoopOrderKind::LK_Forward));
+  IIRStencil->getChild(0)->insertChild(
+      make_unique<iir::Stage>(referenceInstantiaton->getMetaData(), 12));
+
+  auto deserialized = IIRSerializer::deserializeFromString(
+      IIRSerializer::serializeToString(referenceInstantiaton, IIRSerializer::SK_MappedByte),
+      context_, IIRSerializer::SK_MappedByte);
+  IIR_EXPECT_EQ(deserialized, referenceInstantiaton);
+
+  EXPECT_THROW(IIRSerializer::deserializeFromString("DAWNIIR1", context_,
+                                                    IIRSerializer::SK_MappedByte),
+               std::runtime_error);
+}
+
+TEST_F(IIRSerializerTest, MappedIIRSummary) {
+  referenceInstantiaton->getMetaData().setFileName("fileName");
+  referenceInstantiaton->getMetaData().setStencilname("stencilName");
+  referenceInstantiaton->getMetaData().insertAccessOfType(iir::FieldAccessType::FAT_APIField, 10,
+                                                          "field1");
+  referenceInstantiaton->getMetaData().insertAccessOfType(iir::FieldAccessType::FAT_APIField, 12,
+                                                          "field2");
+  referenceInstantiaton->getIIR()->insertChild(
+      make_unique<iir::Stencil>(referenceInstantiaton->getMetaData(), sir::Attr(), 10),
+      referenceInstantiaton->getIIR());
+
+  const std::string file = "IIRSerializerTest.MappedIIRSummary.iir";
+  IIRSerializer::serialize(file, referenceInstantiaton, IIRSerializer::SK_MappedByte);
+  {
+    MappedIIR mappedIIR(file);
+    const auto& summary = mappedIIR.getSummary();
+    EXPECT_EQ(summary.stencilname(), "stencilName");
+    EXPECT_EQ(summary.filename(), "fileName");
+    ASSERT_EQ(summary.apifields_size(), 2);
+    EXPECT_EQ(summary.apifields(0), "field1");
+    EXPECT_EQ(summary.apifields(1), "field2");
+    ASSERT_EQ(summary.stencils_size(), 1);
+    EXPECT_EQ(summary.stencils(0).stencilid(), 10);
+    EXPECT_EQ(summary.stencils(0).nummultistages(), 0);
+
+    IIR_EXPECT_EQ(mappedIIR.materialize(context_), referenceInstantiaton);
+  }
+  IIR_EXPECT_EQ(IIRSerializer::deserialize(file, context_, IIRSerializer::SK_MappedByte),
+                referenceInstantiaton);
+  std::remove(file.c_str());
+
+  EXPECT_THROW(MappedIIR("IIRSerializerTest.nonexistent.iir"), std::runtime_error);
+}
+
 } // anonymous namespace
@@ -12,7 +12,14 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
 #include "dawn/IIR/Stencil.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+#include "dawn/SIR/ASTExpr.h"
+#include "dawn/SIR/ASTStmt.h"
+#include "dawn/Support/STLExtras.h"
 #include <gtest/gtest.h>
 
 using namespace dawn;
@@ -89,4 +96,48 @@ TEST(StencilTest, LifeTime) {
   EXPECT_FALSE(lt3.overlaps(lt4));
 }
 
+TEST(StencilTest, BuildLargeIIR) {
+  // The statements are inserted one at a time into a tree which is already attached to the root,
+  // as the optimizer passes do
+  const int numMultiStages = 10;
+  const int numStagesPerMultiStage = 10;
+  const int numStatementsPerStage = 100;
+
+  sir::GlobalVariableMap globals;
+  iir::StencilMetaInformation metadata(globals);
+  auto IIR =
+      make_unique<iir::IIR>(globals, std::vector<std::shared_ptr<sir::StencilFunction>>());
+
+  IIR->insertChild(make_unique<iir::Stencil>(metadata, sir::Attr(), 0), IIR);
+  const auto& stencil = IIR->getChildren().back();
+  int stageID = 0;
+  for(int msIdx = 0; msIdx < numMultiStages; ++msIdx) {
+    stencil->insertChild(make_unique<iir::MultiStage>(metadata, iir::LoopOrderKind::LK_Parallel));
+    const auto& multiStage = stencil->getChildren().back();
+
+    for(int stageIdx = 0; stageIdx < numStagesPerMultiStage; ++stageIdx) {
+      multiStage->insertChild(make_unique<iir::Stage>(metadata, stageID++, iir::Interval(0, 10)));
+      iir::DoMethod& doMethod = multiStage->getChildren().back()->getSingleDoMethod();
+
+      for(int stmtIdx = 0; stmtIdx < numStatementsPerStage; ++stmtIdx) {
+        auto stmt = std::make_shared<ExprStmt>(std::make_shared<VarAccessExpr>("var"));
+        auto stmtAccessesPair =
+            make_unique<iir::StatementAccessesPair>(std::make_shared<Statement>(stmt, nullptr));
+        stmtAccessesPair->setAccesses(std::make_shared<iir::Accesses>());
+        doMethod.insertChild(std::move(stmtAccessesPair));
+      }
+    }
+  }
+
+  EXPECT_TRUE(IIR->checkTreeConsistency());
+
+  int numStatements = 0;
+  for(const auto& stmtAccessesPair : iterateIIROver<iir::StatementAccessesPair>(*IIR)) {
+    EXPECT_EQ(stmtAccessesPair->getParent()->getParent()->getParent()->getParent(), stencil.get());
+    ++numStatements;
+  }
+  EXPECT_EQ(numStatements, numMultiStages * numStagesPerMultiStage * numStatementsPerStage);
+  EXPECT_EQ(stencil->getNumStages(), numMultiStages * numStagesPerMultiStage);
+}
+
 } // anonymous namespace
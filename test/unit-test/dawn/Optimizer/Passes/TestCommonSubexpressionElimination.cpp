@@ -0,0 +1,116 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestUtils.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class CommonSubexpressionEliminationTest : public OptimizerTest {
+protected:
+  /// @brief Build the stencil
+  ///
+  ///  cse_test_stencil {
+  ///    storage in, c, out1, out2, out3, out4, out5;
+  ///
+  ///    vertical_region(start, end) {
+  ///      out1 = (in[i+1] - in[i-1]) * c;
+  ///      out2 = (in[i+1] - in[i-1]) * c + in;
+  ///      double a = in * c;
+  ///      out3 = a + c;
+  ///      a = c * 3;
+  ///      out4 = a + c;
+  ///      out5 = c * in;
+  ///    }
+  ///  }
+  std::shared_ptr<SIR> makeSIR() {
+    using namespace dawn::astgen;
+
+    auto gradient = [] {
+      return binop(binop(field("in", {{1, 0, 0}}), "-", field("in", {{-1, 0, 0}})), "*",
+                   field("c"));
+    };
+    return makeStencilSIR(
+        "cse_test_stencil", {"in", "c", "out1", "out2", "out3", "out4", "out5"},
+        block(assign(field("out1"), gradient()),
+              assign(field("out2"), binop(gradient(), "+", field("in"))),
+              vardecl("double", "a", binop(field("in"), "*", field("c"))),
+              assign(field("out3"), binop(var("a"), "+", field("c"))),
+              assign(var("a"), binop(field("c"), "*", lit("3", BuiltinTypeID::Integer))),
+              assign(field("out4"), binop(var("a"), "+", field("c"))),
+              assign(field("out5"), binop(field("c"), "*", field("in")))));
+  }
+};
+
+TEST_F(CommonSubexpressionEliminationTest, Disabled) {
+  std::vector<std::string> statements = runOptimizer(Options(), makeSIR());
+  EXPECT_EQ(statements.size(), 7);
+  EXPECT_EQ(count(statements, "__local_cse"), 0);
+}
+
+TEST_F(CommonSubexpressionEliminationTest, Eliminate) {
+  Options options;
+  options.CSE = true;
+  std::vector<std::string> statements = runOptimizer(options, makeSIR());
+
+  // One variable for the gradient and one for `in * c`
+  ASSERT_EQ(statements.size(), 9);
+  EXPECT_EQ(count(statements, "const auto __local_cse"), 2);
+  EXPECT_EQ(count(statements, "in[1, 0, 0]"), 1);
+  EXPECT_EQ(count(statements, "in[-1, 0, 0]"), 1);
+
+  // `a` is modified in between, both sums are kept
+  EXPECT_EQ(count(statements, "a + c"), 2);
+}
+
+TEST_F(CommonSubexpressionEliminationTest, FunctionCalls) {
+  using namespace dawn::astgen;
+
+  //  out1 = std::sqrt(in[i+1] - in);
+  //  out2 = std::sqrt(in[i+1] - in);
+  //  out3 = random(c + in);
+  //  out4 = random(c + in);
+  auto call = [](const std::string& callee, const std::shared_ptr<Expr>& arg) {
+    auto expr = fcall(callee);
+    expr->insertArgument(arg);
+    return expr;
+  };
+  auto sqrtDiff = [&] {
+    return call("std::sqrt", binop(field("in", {{1, 0, 0}}), "-", field("in")));
+  };
+  auto randomSum = [&] { return call("random", binop(field("c"), "+", field("in"))); };
+  std::shared_ptr<SIR> sir = makeStencilSIR(
+      "cse_test_stencil", {"in", "c", "out1", "out2", "out3", "out4"},
+      block(assign(field("out1"), sqrtDiff()), assign(field("out2"), sqrtDiff()),
+            assign(field("out3"), randomSum()), assign(field("out4"), randomSum())));
+
+  Options options;
+  options.CSE = true;
+  std::vector<std::string> statements = runOptimizer(options, sir);
+
+  // Functions of the math library are reused, other functions may have side-effects and are called
+  // every time, only their arguments are reused
+  ASSERT_EQ(statements.size(), 6);
+  EXPECT_EQ(count(statements, "const auto __local_cse"), 2);
+  EXPECT_EQ(count(statements, "std::sqrt("), 1);
+  EXPECT_EQ(count(statements, "random("), 2);
+  EXPECT_EQ(count(statements, "c[0, 0, 0] + in[0, 0, 0]"), 1);
+}
+
+} // anonymous namespace
@@ -0,0 +1,140 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestUtils.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class ConstantFoldingTest : public OptimizerTest {
+protected:
+  /// @brief Build the stencil
+  ///
+  ///  globals {
+  ///    bool use_diffusion = true;
+  ///    double coeff = 0.5;
+  ///    int n = 1;
+  ///  }
+  ///
+  ///  constant_folding_test_stencil {
+  ///    storage in, out1, out2;
+  ///
+  ///    vertical_region(start, end) {
+  ///      out1 = in * (2 * 3 + 1);
+  ///      if(use_diffusion) {
+  ///        out1 = out1 + coeff * (in[i+1] - in);
+  ///      } else {
+  ///        out1 = -(1.5 - 0.5);
+  ///      }
+  ///      if(n > 2)
+  ///        out2 = in;
+  ///      out2 = n == 3 ? in : out1;
+  ///    }
+  ///  }
+  std::shared_ptr<SIR> makeSIR() {
+    using namespace dawn::astgen;
+
+    auto global = [](const std::string& name) {
+      auto expr = var(name);
+      expr->setIsExternal(true);
+      return expr;
+    };
+
+    auto sir = makeStencilSIR(
+        "constant_folding_test_stencil", {"in", "out1", "out2"},
+        block(assign(field("out1"),
+                     binop(field("in"), "*",
+                           binop(binop(lit("2", BuiltinTypeID::Integer), "*",
+                                       lit("3", BuiltinTypeID::Integer)),
+                                 "+", lit("1", BuiltinTypeID::Integer)))),
+              ifstmt(expr(global("use_diffusion")),
+                     block(assign(field("out1"),
+                                  binop(field("out1"), "+",
+                                        binop(global("coeff"), "*",
+                                              binop(field("in", {{1, 0, 0}}), "-", field("in")))))),
+                     block(assign(field("out1"), unop(binop(lit("1.5"), "-", lit("0.5")), "-")))),
+              ifstmt(expr(binop(global("n"), ">", lit("2", BuiltinTypeID::Integer))),
+                     block(assign(field("out2"), field("in")))),
+              assign(field("out2"),
+                     ternop(binop(global("n"), "==", lit("3", BuiltinTypeID::Integer)),
+                            field("in"), field("out1")))));
+    sir->GlobalVariableMap->emplace("use_diffusion", std::make_shared<sir::Value>(true));
+    sir->GlobalVariableMap->emplace("coeff", std::make_shared<sir::Value>(0.5));
+    sir->GlobalVariableMap->emplace("n", std::make_shared<sir::Value>(1));
+    return sir;
+  }
+};
+
+TEST_F(ConstantFoldingTest, Disabled) {
+  DawnCompiler compiler;
+  std::vector<std::string> statements = runOptimizer(compiler, makeSIR());
+  ASSERT_EQ(statements.size(), 4);
+  EXPECT_NE(statements[0].find("(2 * 3)"), std::string::npos);
+}
+
+TEST_F(ConstantFoldingTest, FoldConstants) {
+  Options options;
+  options.FoldConstants = true;
+  DawnCompiler compiler(&options);
+
+  // The globals are not constant, only the literal arithmetic is folded
+  std::vector<std::string> statements = runOptimizer(compiler, makeSIR());
+  ASSERT_EQ(statements.size(), 4);
+  EXPECT_EQ(statements[0], "out1[0, 0, 0] = (in[0, 0, 0] * 7);");
+  EXPECT_NE(statements[1].find("use_diffusion"), std::string::npos);
+  EXPECT_NE(statements[1].find("out1[0, 0, 0] = -1;"), std::string::npos);
+}
+
+TEST_F(ConstantFoldingTest, SpecializeGlobals) {
+  Options options;
+  options.SpecializeGlobals = "use_diffusion=false, coeff=0.1234567891, n=3";
+  DawnCompiler compiler(&options);
+
+  // The if-statements are replaced by the branch which is taken
+  std::vector<std::string> statements = runOptimizer(compiler, makeSIR());
+  ASSERT_EQ(statements.size(), 4);
+  EXPECT_EQ(statements[0], "out1[0, 0, 0] = (in[0, 0, 0] * 7);");
+  EXPECT_EQ(statements[1], "out1[0, 0, 0] = -1;");
+  EXPECT_EQ(statements[2], "out2[0, 0, 0] = in[0, 0, 0];");
+  EXPECT_EQ(statements[3], "out2[0, 0, 0] = in[0, 0, 0];");
+}
+
+TEST_F(ConstantFoldingTest, SpecializeGlobalsValue) {
+  Options options;
+  options.SpecializeGlobals = "use_diffusion=true,coeff=0.1234567891";
+  DawnCompiler compiler(&options);
+
+  std::vector<std::string> statements = runOptimizer(compiler, makeSIR());
+  ASSERT_EQ(statements.size(), 4);
+  EXPECT_NE(statements[1].find("0.1234567891 *"), std::string::npos);
+  EXPECT_EQ(statements[1].find("if"), std::string::npos);
+}
+
+TEST_F(ConstantFoldingTest, SpecializeGlobalsInvalid) {
+  for(const char* specialization : {"unknown=1", "n=1.5", "use_diffusion=yes"}) {
+    Options options;
+    options.SpecializeGlobals = specialization;
+    DawnCompiler compiler(&options);
+
+    EXPECT_TRUE(runOptimizer(compiler, makeSIR()).empty());
+    EXPECT_TRUE(compiler.getDiagnostics().hasErrors());
+  }
+}
+
+} // anonymous namespace
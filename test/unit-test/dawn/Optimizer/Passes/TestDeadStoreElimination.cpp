@@ -0,0 +1,95 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestUtils.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class DeadStoreEliminationTest : public OptimizerTest {
+protected:
+  /// @brief Build the stencil
+  ///
+  ///  dse_test_stencil {
+  ///    storage in, out;
+  ///    var tmp, dead1, dead2;
+  ///
+  ///    vertical_region(start, end) {
+  ///      tmp = in * 2;
+  ///      dead1 = in + 1;
+  ///      dead2 = dead1 * 2;
+  ///      double a = in;
+  ///      double b = in * 3;
+  ///      b = b + a;
+  ///      double c = 1;
+  ///      c = in;
+  ///      out = tmp + a + c;
+  ///    }
+  ///  }
+  std::shared_ptr<SIR> makeSIR() {
+    using namespace dawn::astgen;
+
+    return makeStencilSIR(
+        "dse_test_stencil", {"in", "out"},
+        block(assign(field("tmp"), binop(field("in"), "*", lit("2", BuiltinTypeID::Integer))),
+              assign(field("dead1"), binop(field("in"), "+", lit("1", BuiltinTypeID::Integer))),
+              assign(field("dead2"), binop(field("dead1"), "*", lit("2", BuiltinTypeID::Integer))),
+              vardecl("double", "a", field("in")),
+              vardecl("double", "b", binop(field("in"), "*", lit("3", BuiltinTypeID::Integer))),
+              assign(var("b"), binop(var("b"), "+", var("a"))),
+              vardecl("double", "c", lit("1", BuiltinTypeID::Integer)),
+              assign(var("c"), field("in")),
+              assign(field("out"), binop(binop(field("tmp"), "+", var("a")), "+", var("c")))),
+        {"tmp", "dead1", "dead2"});
+  }
+};
+
+TEST_F(DeadStoreEliminationTest, Disabled) {
+  std::vector<std::string> statements = runOptimizer(Options(), makeSIR());
+  EXPECT_EQ(statements.size(), 9);
+  EXPECT_EQ(count(statements, "dead"), 3);
+}
+
+TEST_F(DeadStoreEliminationTest, Eliminate) {
+  Options options;
+  options.DeadStoreElimination = true;
+  std::vector<std::string> statements = runOptimizer(options, makeSIR());
+
+  // The chain of dead temporaries and both statements computing `b` are removed
+  ASSERT_EQ(statements.size(), 5);
+  EXPECT_EQ(count(statements, "dead"), 0);
+  EXPECT_EQ(count(statements, "b ="), 0);
+
+  // `c` is used after being overwritten, its declaration is kept
+  EXPECT_EQ(count(statements, "c ="), 2);
+}
+
+TEST_F(DeadStoreEliminationTest, InvalidateStageGraph) {
+  Options options;
+  options.DeadStoreElimination = true;
+  DawnCompiler compiler(&options);
+
+  std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(makeSIR());
+  ASSERT_NE(optimizer, nullptr);
+  const auto& instantiation = optimizer->getStencilInstantiationMap().at("dse_test_stencil");
+  for(const auto& stencil : instantiation->getStencils())
+    EXPECT_EQ(stencil->getStageDependencyGraph(), nullptr);
+}
+
+} // anonymous namespace
@@ -0,0 +1,157 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Unittest/ASTSimplifier.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace dawn;
+
+namespace {
+
+class ParallelOptimizationTest : public ::testing::Test {
+protected:
+  /// @brief Build `numStencils` stencils `stencil_<n>` of the form
+  ///
+  ///  stencil_<n> {
+  ///    storage in, out;
+  ///    temporary_storage tmp_0, ..., tmp_<numTemporaries - 1>;
+  ///
+  ///    vertical_region(start, end) {
+  ///      tmp_0 = in[i-1] + in[i+1];
+  ///      tmp_1 = tmp_0[j-1] + tmp_0[j+1];
+  ///      tmp_2 = tmp_1[i-1] + tmp_1[i+1];
+  ///      ...
+  ///      out = tmp_<numTemporaries - 1>[j-1] + tmp_<numTemporaries - 1>[j+1];
+  ///    }
+  ///  }
+  ///
+  /// Every statement reads the result of the previous one with an offset, hence the stencils are
+  /// split into many stages.
+  std::shared_ptr<SIR> makeSIR(int numStencils, int numTemporaries) {
+    using namespace dawn::astgen;
+
+    auto sir = std::make_shared<SIR>();
+    for(int n = 0; n < numStencils; ++n) {
+      auto stencil = std::make_shared<sir::Stencil>();
+      stencil->Name = "stencil_" + std::to_string(n);
+      stencil->Fields.emplace_back(std::make_shared<sir::Field>("in"));
+      stencil->Fields.emplace_back(std::make_shared<sir::Field>("out"));
+
+      std::vector<std::shared_ptr<Stmt>> statements;
+      std::string input = "in";
+      for(int t = 0; t <= numTemporaries; ++t) {
+        std::string output = t < numTemporaries ? "tmp_" + std::to_string(t) : "out";
+        if(t < numTemporaries) {
+          stencil->Fields.emplace_back(std::make_shared<sir::Field>(output));
+          stencil->Fields.back()->IsTemporary = true;
+        }
+        Array3i minus = t % 2 == 0 ? Array3i{{-1, 0, 0}} : Array3i{{0, -1, 0}};
+        Array3i plus = t % 2 == 0 ? Array3i{{1, 0, 0}} : Array3i{{0, 1, 0}};
+        statements.push_back(
+            expr(assign(field(output), binop(field(input, minus), "+", field(input, plus)))));
+        input = output;
+      }
+
+      auto vr = std::make_shared<sir::VerticalRegion>(
+          std::make_shared<AST>(std::make_shared<BlockStmt>(statements)),
+          std::make_shared<sir::Interval>(sir::Interval::Start, sir::Interval::End),
+          sir::VerticalRegion::LK_Forward);
+      stencil->StencilDescAst = std::make_shared<AST>(block(verticalRegion(vr)));
+      sir->Stencils.emplace_back(stencil);
+    }
+    return sir;
+  }
+
+  /// @brief Serialized IIR and generated code of all stencils, optimized using `jobs` threads
+  std::string compile(const std::shared_ptr<SIR>& sir, int jobs) {
+    Options options;
+    options.Jobs = jobs;
+    DawnCompiler compiler(&options);
+
+    std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(sir);
+    if(!optimizer)
+      return "";
+
+    std::string result;
+    for(const auto& instantiationPair : optimizer->getStencilInstantiationMap())
+      result += IIRSerializer::serializeToString(instantiationPair.second, IIRSerializer::SK_Json);
+
+    codegen::cxxnaive::CXXNaiveCodeGen codeGen(optimizer.get());
+    std::unique_ptr<codegen::TranslationUnit> translationUnit = codeGen.generateCode();
+    if(!translationUnit)
+      return "";
+    for(const auto& stencilPair : translationUnit->getStencils())
+      result += stencilPair.second;
+    return result;
+  }
+
+  /// @brief Run `compile` in a child process
+  ///
+  /// The identifiers of a compilation depend on the ones handed out before in the same process,
+  /// every compilation hence starts from a fresh copy of this process.
+  std::string compileInChildProcess(const std::shared_ptr<SIR>& sir, int jobs) {
+    int fds[2];
+    if(pipe(fds) != 0)
+      return "";
+
+    pid_t pid = fork();
+    if(pid == 0) {
+      close(fds[0]);
+      std::string result = compile(sir, jobs);
+      std::size_t written = 0;
+      while(written < result.size()) {
+        ssize_t n = write(fds[1], result.data() + written, result.size() - written);
+        if(n <= 0)
+          _exit(1);
+        written += n;
+      }
+      close(fds[1]);
+      _exit(0);
+    }
+
+    close(fds[1]);
+    std::string result;
+    char buffer[4096];
+    ssize_t n;
+    while((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+      result.append(buffer, n);
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? result : "";
+  }
+};
+
+TEST_F(ParallelOptimizationTest, IndependentOfNumberOfJobs) {
+  std::shared_ptr<SIR> sir = makeSIR(16, 8);
+
+  std::string serial = compileInChildProcess(sir, 1);
+  std::string parallel = compileInChildProcess(sir, 4);
+
+  ASSERT_FALSE(serial.empty());
+  EXPECT_NE(serial.find("stencil_15"), std::string::npos);
+  EXPECT_EQ(serial, parallel);
+}
+
+} // anonymous namespace
@@ -16,12 +16,14 @@
 #include "dawn/Compiler/Options.h"
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/PassComputeStageExtents.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/SIR/SIRSerializer.h"
 #include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
 #include <fstream>
 #include <gtest/gtest.h>
 #include <streambuf>
+#include <vector>
 
 using namespace dawn;
 
@@ -36,17 +38,16 @@ protected:
   ComputeStageExtents() : compiler_(compileOptions_.get()) {}
   virtual void SetUp() {}
 
-  std::unique_ptr<iir::IIR> loadTest(std::string sirFilename) {
-
+  std::shared_ptr<SIR> loadSIR(std::string sirFilename) {
     std::string filename = TestEnvironment::path_ + "/" + sirFilename;
     std::ifstream file(filename);
     DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
 
     std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+  }
 
-    std::shared_ptr<SIR> sir =
-        SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
-
+  std::unique_ptr<OptimizerContext> runOptimizer(const std::shared_ptr<SIR>& sir) {
     std::unique_ptr<OptimizerContext> optimizer = compiler_.runOptimizer(sir);
     // Report diganostics
     if(compiler_.getDiagnostics().hasDiags()) {
@@ -57,13 +58,44 @@ protected:
 
     DAWN_ASSERT_MSG((optimizer->getStencilInstantiationMap().count("compute_extent_test_stencil")),
                     "compute_extent_test_stencil not found in sir");
+    return optimizer;
+  }
 
+  std::unique_ptr<iir::IIR> loadTest(std::string sirFilename) {
+    std::unique_ptr<OptimizerContext> optimizer = runOptimizer(loadSIR(sirFilename));
     const std::unique_ptr<iir::IIR>& iir =
         optimizer->getStencilInstantiationMap()["compute_extent_test_stencil"]->getIIR();
     return iir->clone();
   }
 };
 
+/// @brief Stage extents computed by the original algorithm of the pass, which scans all the
+/// preceding stages for every field of a stage (quadratic in the number of stages)
+std::vector<iir::Extents> computeReferenceExtents(const iir::Stencil& stencil) {
+  std::vector<const iir::Stage*> stages;
+  for(const auto& multiStage : stencil.getChildren())
+    for(const auto& stage : multiStage->getChildren())
+      stages.push_back(stage.get());
+
+  std::vector<iir::Extents> extents(stages.size(), iir::Extents{0, 0, 0, 0, 0, 0});
+  for(int i = stages.size() - 1; i >= 0; --i) {
+    for(const auto& fromFieldPair : stages[i]->getFields()) {
+      iir::Extents fieldExtent = fromFieldPair.second.getExtents();
+      fieldExtent.expand(extents[i]);
+
+      for(int j = i - 1; j >= 0; --j) {
+        const auto& toFields = stages[j]->getFields();
+        auto it = toFields.find(fromFieldPair.first);
+        if(it == toFields.end() || it->second.getIntend() == iir::Field::IntendKind::IK_Input)
+          continue;
+        extents[j].merge(fieldExtent);
+        extents[j][2] = iir::Extent{0, 0};
+      }
+    }
+  }
+  return extents;
+}
+
 TEST_F(ComputeStageExtents, test_stencil_01) {
   std::unique_ptr<iir::IIR> IIR = loadTest("compute_extent_test_stencil_01.sir");
   const auto& stencils = IIR->getChildren();
@@ -128,4 +160,47 @@ TEST_F(ComputeStageExtents, test_stencil_05) {
   EXPECT_EQ(stencil->getStage(3)->getExtents(), (iir::Extents{0, 0, 0, 0, 0, 0}));
 }
 
+TEST_F(ComputeStageExtents, scaled_test_stencils) {
+  // The vertical regions of the samples are repeated to obtain stencils with hundreds of stages,
+  // the extents are compared to the original algorithm
+  const int numCopies = 100;
+
+  for(const char* sirFilename :
+      {"compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+       "compute_extent_test_stencil_03.sir", "compute_extent_test_stencil_04.sir",
+       "compute_extent_test_stencil_05.sir"}) {
+    std::shared_ptr<SIR> sir = loadSIR(sirFilename);
+    std::shared_ptr<BlockStmt>& root = sir->Stencils.front()->StencilDescAst->getRoot();
+    std::vector<std::shared_ptr<Stmt>> statements = root->getStatements();
+    for(int copy = 1; copy < numCopies; ++copy)
+      for(const auto& stmt : statements)
+        root->push_back(stmt->clone());
+
+    std::unique_ptr<OptimizerContext> optimizer = runOptimizer(sir);
+    const auto& instantiation =
+        optimizer->getStencilInstantiationMap().at("compute_extent_test_stencil");
+
+    // Recompute the extents from scratch
+    int numStages = 0;
+    for(const auto& stencil : instantiation->getStencils()) {
+      numStages += stencil->getNumStages();
+      for(const auto& multiStage : stencil->getChildren())
+        for(const auto& stage : multiStage->getChildren())
+          stage->setExtents(iir::Extents{0, 0, 0, 0, 0, 0});
+    }
+    EXPECT_GE(numStages, numCopies);
+
+    PassComputeStageExtents pass;
+    pass.run(instantiation);
+
+    for(const auto& stencil : instantiation->getStencils()) {
+      std::vector<iir::Extents> referenceExtents = computeReferenceExtents(*stencil);
+      std::size_t stageIdx = 0;
+      for(const auto& multiStage : stencil->getChildren())
+        for(const auto& stage : multiStage->getChildren())
+          EXPECT_EQ(stage->getExtents(), referenceExtents[stageIdx++]) << sirFilename;
+    }
+  }
+}
+
 } // anonymous namespace
@@ -0,0 +1,51 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/PassManager.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/SIR/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+TEST(PassManagerTest, ReuseASTArena) {
+  DawnCompiler compiler;
+  std::unique_ptr<OptimizerContext> optimizer =
+      compiler.runOptimizer(SIRSerializer::deserialize(
+          TestEnvironment::path_ + "/compute_extent_test_stencil_01.sir", SIRSerializer::SK_Json));
+  ASSERT_NE(optimizer, nullptr);
+  const auto& instantiation =
+      optimizer->getStencilInstantiationMap().at("compute_extent_test_stencil");
+
+  // The nodes of the instantiation live in its arena, which is reused by every run and released
+  // after all the nodes with the instantiation
+  Arena* arena = instantiation->getASTArena();
+  EXPECT_GT(arena->getBytesInUse(), 0);
+  PassManager manager;
+  EXPECT_TRUE(manager.runAllPassesOnStecilInstantiation(instantiation));
+  std::size_t bytesInUse = arena->getBytesInUse();
+  std::size_t numChunks = arena->getNumChunks();
+  for(int i = 0; i < 10; ++i)
+    EXPECT_TRUE(manager.runAllPassesOnStecilInstantiation(instantiation));
+  EXPECT_EQ(instantiation->getASTArena(), arena);
+  EXPECT_EQ(arena->getBytesInUse(), bytesInUse);
+  EXPECT_EQ(arena->getNumChunks(), numChunks);
+}
+
+} // anonymous namespace
@@ -0,0 +1,117 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/SIR/SIRSerializer.h"
+#include "dawn/Support/Json.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+class PassProfilerTest : public ::testing::Test {
+protected:
+  std::unique_ptr<OptimizerContext> runOptimizer(DawnCompiler& compiler,
+                                                 std::string sirFilename) {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::shared_ptr<SIR> sir =
+        SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+    return compiler.runOptimizer(sir);
+  }
+
+  json::json readJson(const std::string& filename) {
+    std::ifstream file(filename);
+    json::json node;
+    file >> node;
+    return node;
+  }
+};
+
+TEST_F(PassProfilerTest, Disabled) {
+  DawnCompiler compiler;
+  auto optimizer = runOptimizer(compiler, "compute_extent_test_stencil_01.sir");
+  ASSERT_NE(optimizer, nullptr);
+  EXPECT_EQ(optimizer->getPassProfiler(), nullptr);
+}
+
+TEST_F(PassProfilerTest, Report) {
+  Options options;
+  options.ProfilePasses = "pass_profiler_test_report.json";
+  DawnCompiler compiler(&options);
+
+  auto optimizer = runOptimizer(compiler, "compute_extent_test_stencil_01.sir");
+  ASSERT_NE(optimizer, nullptr);
+  ASSERT_NE(optimizer->getPassProfiler(), nullptr);
+
+  // One run per registered pass, in the order of registration
+  const auto& profiles = optimizer->getPassProfiler()->getProfiles();
+  const auto& passes = optimizer->getPassManager().getPasses();
+  ASSERT_EQ(profiles.size(), passes.size());
+
+  auto passIt = passes.begin();
+  unsigned long numUpdates = 0;
+  for(const PassProfile& profile : profiles) {
+    EXPECT_EQ(profile.PassName, (*passIt++)->getName());
+    EXPECT_EQ(profile.InstantiationName, "compute_extent_test_stencil");
+    EXPECT_GE(profile.WallTime, 0);
+    EXPECT_GT(profile.NumNodesBefore, 0);
+    EXPECT_GT(profile.NumNodesAfter, 0);
+    numUpdates += profile.NumUpdateFromChildren;
+  }
+  EXPECT_GT(numUpdates, 0);
+
+  json::json report = readJson(options.ProfilePasses);
+  EXPECT_EQ(report["runs"].size(), profiles.size());
+  EXPECT_FALSE(report["summary"].empty());
+  std::remove(options.ProfilePasses.c_str());
+}
+
+TEST_F(PassProfilerTest, Trace) {
+  Options options;
+  options.ProfilePasses = "pass_profiler_test_trace.json";
+  options.ProfilePassesFormat = "trace";
+  DawnCompiler compiler(&options);
+
+  auto optimizer = runOptimizer(compiler, "compute_extent_test_stencil_01.sir");
+  ASSERT_NE(optimizer, nullptr);
+
+  json::json trace = readJson(options.ProfilePasses);
+  ASSERT_EQ(trace["traceEvents"].size(), optimizer->getPassProfiler()->getProfiles().size());
+  EXPECT_EQ(trace["traceEvents"][0]["ph"], "X");
+  std::remove(options.ProfilePasses.c_str());
+}
+
+TEST_F(PassProfilerTest, InvalidFormat) {
+  Options options;
+  options.ProfilePasses = "pass_profiler_test_invalid.json";
+  options.ProfilePassesFormat = "xml";
+  DawnCompiler compiler(&options);
+
+  EXPECT_EQ(runOptimizer(compiler, "compute_extent_test_stencil_01.sir"), nullptr);
+  EXPECT_TRUE(compiler.getDiagnostics().hasErrors());
+}
+
+} // anonymous namespace
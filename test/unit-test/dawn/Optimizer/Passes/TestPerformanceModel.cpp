@@ -0,0 +1,148 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PerformanceModel.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestUtils.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+class PerformanceModelTest : public OptimizerTest {
+protected:
+  /// @brief Build the stencil
+  ///
+  ///  performance_model_test_stencil {
+  ///    storage in, out;
+  ///
+  ///    vertical_region(start, end) {
+  ///      out = in[i+1] + in[i-1] * 2.0;
+  ///    }
+  ///  }
+  std::shared_ptr<SIR> makeSIR() {
+    using namespace dawn::astgen;
+
+    return makeStencilSIR(
+        "performance_model_test_stencil", {"in", "out"},
+        block(assign(field("out"), binop(field("in", {{1, 0, 0}}), "+",
+                                         binop(field("in", {{-1, 0, 0}}), "*", lit("2.0"))))));
+  }
+
+  json::json readJson(const std::string& filename) {
+    std::ifstream file(filename);
+    json::json node;
+    file >> node;
+    return node;
+  }
+};
+
+TEST_F(PerformanceModelTest, Estimate) {
+  DawnCompiler compiler;
+  std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(makeSIR());
+  ASSERT_NE(optimizer, nullptr);
+  const auto& instantiation =
+      optimizer->getStencilInstantiationMap().at("performance_model_test_stencil");
+  ASSERT_EQ(instantiation->getStencils().size(), 1);
+  const iir::Stencil& stencil = *instantiation->getStencils()[0];
+  ASSERT_EQ(stencil.getChildren().size(), 1);
+  const iir::MultiStage& multiStage = *stencil.getChildren().front();
+
+  EXPECT_EQ(computeFlopsPerGridPoint(*instantiation, multiStage), 2);
+
+  // `in` is read on a domain extended by one point in each i-direction
+  const double inBytes = 12 * 10 * 10 * 8;
+  const double outBytes = 10 * 10 * 10 * 8;
+
+  // Both fields of a k-level fit into the cache: every field is loaded only once
+  HardwareConfig machine;
+  PerformanceEstimate estimate = PerformanceModel(machine, {{10, 10, 10}}).estimate(*instantiation,
+                                                                                    multiStage);
+  EXPECT_TRUE(estimate.FitsInCache);
+  EXPECT_DOUBLE_EQ(estimate.Flops, 2 * 10 * 10 * 10);
+  EXPECT_DOUBLE_EQ(estimate.BytesRead, inBytes);
+  EXPECT_DOUBLE_EQ(estimate.BytesWritten, outBytes);
+  EXPECT_DOUBLE_EQ(estimate.CompulsoryBytes, inBytes + outBytes);
+  EXPECT_DOUBLE_EQ(estimate.getArithmeticIntensity(), 2000 / (inBytes + outBytes));
+  EXPECT_TRUE(estimate.isMemoryBound());
+  EXPECT_DOUBLE_EQ(estimate.getRuntime(), (inBytes + outBytes) / (machine.Bandwidth * 1e9));
+
+  // Without cache both offset reads of `in` go to main memory
+  machine.CacheSize = 1;
+  estimate = PerformanceModel(machine, {{10, 10, 10}}).estimate(*instantiation, multiStage);
+  EXPECT_FALSE(estimate.FitsInCache);
+  EXPECT_DOUBLE_EQ(estimate.BytesRead, 2 * inBytes);
+  EXPECT_DOUBLE_EQ(estimate.CompulsoryBytes, inBytes + outBytes);
+
+  // Slow arithmetic renders the stencil compute bound
+  machine.PeakFlops = 1e-6;
+  estimate = PerformanceModel(machine, {{10, 10, 10}}).estimate(*instantiation, stencil);
+  EXPECT_FALSE(estimate.isMemoryBound());
+  EXPECT_DOUBLE_EQ(estimate.getRuntime(), estimate.ComputeTime);
+}
+
+TEST_F(PerformanceModelTest, Report) {
+  Options options;
+  options.PerformanceModel = "performance_model_test_report.json";
+  options.PerformanceModelDomain = "64,32,16";
+  options.Machine = "bandwidth=50, peak-flops=500";
+  DawnCompiler compiler(&options);
+
+  std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(makeSIR());
+  ASSERT_NE(optimizer, nullptr);
+  EXPECT_EQ(optimizer->getHardwareConfiguration().Bandwidth, 50);
+  EXPECT_EQ(optimizer->getHardwareConfiguration().PeakFlops, 500);
+
+  json::json report = readJson(options.PerformanceModel);
+  EXPECT_EQ(report["machine"]["bandwidth_gbs"], 50);
+  EXPECT_EQ(report["machine"]["ridge_point"], 10);
+  EXPECT_EQ(report["domain"], json::json({64, 32, 16}));
+
+  ASSERT_EQ(report["stencil_instantiations"].size(), 1);
+  const json::json& instantiation = report["stencil_instantiations"][0];
+  EXPECT_EQ(instantiation["name"], "performance_model_test_stencil");
+  ASSERT_EQ(instantiation["stencils"].size(), 1);
+
+  const json::json& multiStages = instantiation["stencils"][0]["multistages"];
+  ASSERT_EQ(multiStages.size(), 1);
+  EXPECT_EQ(multiStages[0]["flops"], 2 * 64 * 32 * 16);
+  EXPECT_EQ(multiStages[0]["loop_order"], "parallel");
+  EXPECT_EQ(multiStages[0]["bound"], "memory");
+  EXPECT_EQ(instantiation["total"]["runtime_us"], multiStages[0]["runtime_us"]);
+  std::remove(options.PerformanceModel.c_str());
+}
+
+TEST_F(PerformanceModelTest, InvalidOptions) {
+  Options options;
+  options.Machine = "bandwith=10";
+  DawnCompiler compiler(&options);
+  EXPECT_EQ(compiler.runOptimizer(makeSIR()), nullptr);
+  EXPECT_TRUE(compiler.getDiagnostics().hasErrors());
+
+  options.Machine = "bandwidth=-1";
+  DawnCompiler negativeBandwidthCompiler(&options);
+  EXPECT_EQ(negativeBandwidthCompiler.runOptimizer(makeSIR()), nullptr);
+
+  options.Machine = "";
+  options.PerformanceModelDomain = "64,32";
+  DawnCompiler domainCompiler(&options);
+  EXPECT_EQ(domainCompiler.runOptimizer(makeSIR()), nullptr);
+  EXPECT_TRUE(domainCompiler.getDiagnostics().hasErrors());
+}
+
+} // anonymous namespace
@@ -0,0 +1,105 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/ReadBeforeWriteConflict.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/SIR/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+class ReadBeforeWriteConflictTrackerTest : public ::testing::TestWithParam<std::string> {
+protected:
+  std::unique_ptr<OptimizerContext> runOptimizer(const std::string& sirFilename) {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::shared_ptr<SIR> sir =
+        SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+    Options options;
+    DawnCompiler compiler(&options);
+    return compiler.runOptimizer(sir);
+  }
+};
+
+TEST_P(ReadBeforeWriteConflictTrackerTest, SameAsGraphTraversal) {
+  std::unique_ptr<OptimizerContext> optimizer = runOptimizer(GetParam());
+  ASSERT_NE(optimizer, nullptr);
+
+  const iir::LoopOrderKind loopOrders[] = {iir::LoopOrderKind::LK_Forward,
+                                           iir::LoopOrderKind::LK_Backward,
+                                           iir::LoopOrderKind::LK_Parallel};
+
+  for(const auto& instantiationPair : optimizer->getStencilInstantiationMap()) {
+    const auto& metaData = instantiationPair.second->getMetaData();
+
+    // Insert the statements of each multi-stage bottom to top (as the splitters do) and compare
+    // the tracked conflicts to the ones of the full graph traversal after every insertion
+    for(const auto& stencil : instantiationPair.second->getStencils()) {
+      for(const auto& multiStage : stencil->getChildren()) {
+        for(iir::LoopOrderKind loopOrder : loopOrders) {
+          iir::DependencyGraphAccesses graph(metaData), trackedGraph(metaData);
+          ReadBeforeWriteConflictTracker tracker(trackedGraph, loopOrder);
+
+          for(auto stageIt = multiStage->childrenRBegin(); stageIt != multiStage->childrenREnd();
+              ++stageIt) {
+            for(const auto& doMethod : (*stageIt)->getChildren()) {
+              const auto& stmts = doMethod->getChildren();
+              for(auto stmtIt = stmts.rbegin(); stmtIt != stmts.rend(); ++stmtIt) {
+                graph.insertStatementAccessesPair(*stmtIt);
+                tracker.insertStatementAccessesPair(*stmtIt);
+
+                // The traversal requires output vertices
+                if(graph.getOutputVertexIDs().empty())
+                  continue;
+
+                auto conflict = hasVerticalReadBeforeWriteConflict(&graph, loopOrder);
+                auto trackedConflict = tracker.getVerticalConflict();
+                EXPECT_EQ(trackedConflict.LoopOrderConflict, conflict.LoopOrderConflict);
+                EXPECT_EQ(trackedConflict.CounterLoopOrderConflict,
+                          conflict.CounterLoopOrderConflict);
+                EXPECT_EQ(tracker.hasHorizontalConflict(),
+                          hasHorizontalReadBeforeWriteConflict(&graph));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Stencils, ReadBeforeWriteConflictTrackerTest,
+    ::testing::Values("compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+                      "compute_extent_test_stencil_03.sir", "compute_extent_test_stencil_04.sir",
+                      "compute_extent_test_stencil_05.sir", "test_compute_maximum_extent_01.sir",
+                      "test_compute_ordered_do_methods.sir",
+                      "test_compute_read_access_interval_02.sir",
+                      "test_field_access_interval_03.sir", "boundary_condition_test_stencil_01.sir"));
+
+} // anonymous namespace
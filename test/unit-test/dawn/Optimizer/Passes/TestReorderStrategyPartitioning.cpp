@@ -0,0 +1,147 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/SIR/SIRSerializer.h"
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+class ReorderStrategyPartitioning : public ::testing::Test {
+protected:
+  struct Result {
+    int NumStages = 0;
+    int NumMultiStages = 0;
+    int NumAccesses = 0;
+  };
+
+  std::shared_ptr<SIR> loadSIR(const std::string& sirFilename) {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+  }
+
+  Result runOptimizer(const std::shared_ptr<SIR>& sir, const std::string& reorderStrategy) {
+    Options options;
+    options.ReorderStrategy = reorderStrategy;
+    DawnCompiler compiler(&options);
+
+    Result result;
+    std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(sir);
+    EXPECT_NE(optimizer, nullptr);
+    if(!optimizer)
+      return result;
+
+    for(const auto& instantiationPair : optimizer->getStencilInstantiationMap()) {
+      for(const auto& stencil : instantiationPair.second->getStencils()) {
+        result.NumStages += stencil->getNumStages();
+        for(const auto& multiStage : stencil->getChildren()) {
+          auto readAndWrite = computeReadWriteAccessesMetric(*instantiationPair.second, *multiStage);
+          result.NumMultiStages++;
+          result.NumAccesses += readAndWrite.first + readAndWrite.second;
+        }
+      }
+    }
+    return result;
+  }
+};
+
+class ReorderStrategyPartitioningStencils : public ReorderStrategyPartitioning,
+                                            public ::testing::WithParamInterface<std::string> {};
+
+TEST_P(ReorderStrategyPartitioningStencils, ComparedToGreedy) {
+  std::shared_ptr<SIR> sir = loadSIR(GetParam());
+  Result greedy = runOptimizer(sir, "greedy");
+  Result scut = runOptimizer(sir, "scut");
+
+  EXPECT_LE(scut.NumStages, greedy.NumStages);
+  EXPECT_LE(scut.NumMultiStages, greedy.NumMultiStages);
+  EXPECT_LE(scut.NumAccesses, greedy.NumAccesses);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Stencils, ReorderStrategyPartitioningStencils,
+    ::testing::Values("compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+                      "compute_extent_test_stencil_03.sir", "compute_extent_test_stencil_04.sir",
+                      "compute_extent_test_stencil_05.sir", "test_compute_maximum_extent_01.sir",
+                      "test_compute_ordered_do_methods.sir",
+                      "test_compute_read_access_interval_02.sir",
+                      "test_field_access_interval_03.sir", "boundary_condition_test_stencil_01.sir"));
+
+/// stencil keep_temporary_local {
+///   storage in, out, x, y;
+///   temporary_storage tmp;
+///
+///   vertical_region(start, end) forward { x = x[k-1]; }
+///   vertical_region(start, end) backward { y = y[k+1]; }
+///   vertical_region(start, end) {
+///     tmp = in;
+///     out = tmp[i+1] + y;
+///   }
+/// }
+///
+/// The greedy strategy moves the producer of `tmp` into the forward multi-stage of `x` while its
+/// consumer has to follow the backward multi-stage of `y`, hence `tmp` lives in main memory.
+/// Cutting after the forward multi-stage keeps `tmp` local to the backward one.
+TEST_F(ReorderStrategyPartitioning, KeepsTemporaryLocal) {
+  using namespace dawn::astgen;
+
+  auto stencil = std::make_shared<sir::Stencil>();
+  stencil->Name = "keep_temporary_local";
+  for(const char* name : {"in", "out", "x", "y", "tmp"})
+    stencil->Fields.emplace_back(std::make_shared<sir::Field>(name));
+  stencil->Fields.back()->IsTemporary = true;
+
+  auto makeVerticalRegion = [](const std::shared_ptr<BlockStmt>& body,
+                               sir::VerticalRegion::LoopOrderKind loopOrder) {
+    return verticalRegion(std::make_shared<sir::VerticalRegion>(
+        std::make_shared<AST>(body),
+        std::make_shared<sir::Interval>(sir::Interval::Start, sir::Interval::End), loopOrder));
+  };
+  stencil->StencilDescAst = std::make_shared<AST>(block(
+      makeVerticalRegion(block(assign(field("x"), field("x", Array3i{{0, 0, -1}}))),
+                         sir::VerticalRegion::LK_Forward),
+      makeVerticalRegion(block(assign(field("y"), field("y", Array3i{{0, 0, 1}}))),
+                         sir::VerticalRegion::LK_Backward),
+      makeVerticalRegion(
+          block(assign(field("tmp"), field("in")),
+                assign(field("out"), binop(field("tmp", Array3i{{1, 0, 0}}), "+", field("y")))),
+          sir::VerticalRegion::LK_Forward)));
+
+  auto sir = std::make_shared<SIR>();
+  sir->Stencils.emplace_back(stencil);
+
+  Result greedy = runOptimizer(sir, "greedy");
+  Result scut = runOptimizer(sir, "scut");
+
+  EXPECT_EQ(scut.NumStages, greedy.NumStages);
+  EXPECT_EQ(scut.NumMultiStages, greedy.NumMultiStages);
+  EXPECT_LT(scut.NumAccesses, greedy.NumAccesses);
+}
+
+} // anonymous namespace
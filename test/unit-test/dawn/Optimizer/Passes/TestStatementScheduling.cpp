@@ -0,0 +1,76 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Unittest/ASTSimplifier.h"
+#include "test/unit-test/dawn/Optimizer/TestUtils.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class StatementSchedulingTest : public OptimizerTest {
+protected:
+  /// @brief Build the stencil
+  ///
+  ///  scheduling_test_stencil {
+  ///    storage in, out1, out2, out3;
+  ///
+  ///    vertical_region(start, end) {
+  ///      double a = in[i+1];
+  ///      double b = in[i-1];
+  ///      double c = in;
+  ///      out1 = a;
+  ///      out2 = b;
+  ///      out3 = c + a;
+  ///    }
+  ///  }
+  std::shared_ptr<SIR> makeSIR() {
+    using namespace dawn::astgen;
+
+    return makeStencilSIR(
+        "scheduling_test_stencil", {"in", "out1", "out2", "out3"},
+        block(vardecl("double", "a", field("in", {{1, 0, 0}})),
+              vardecl("double", "b", field("in", {{-1, 0, 0}})),
+              vardecl("double", "c", field("in")),
+              assign(field("out1"), var("a")), assign(field("out2"), var("b")),
+              assign(field("out3"), binop(var("c"), "+", var("a")))));
+  }
+};
+
+TEST_F(StatementSchedulingTest, Disabled) {
+  std::vector<std::string> statements = runOptimizer(Options(), makeSIR());
+  ASSERT_EQ(statements.size(), 6);
+  EXPECT_EQ(find(statements, "b = "), 1);
+  EXPECT_EQ(find(statements, "out1"), 3);
+}
+
+TEST_F(StatementSchedulingTest, Schedule) {
+  Options options;
+  options.ScheduleStatements = true;
+  std::vector<std::string> statements = runOptimizer(options, makeSIR());
+  ASSERT_EQ(statements.size(), 6);
+
+  // `b` is only declared once `a` is consumed by `out1`, `c` once `b` is consumed by `out2`
+  EXPECT_EQ(find(statements, "a = "), 0);
+  EXPECT_EQ(find(statements, "out1"), 1);
+  EXPECT_EQ(find(statements, "b = "), 2);
+  EXPECT_EQ(find(statements, "out2"), 3);
+  EXPECT_EQ(find(statements, "c = "), 4);
+  EXPECT_EQ(find(statements, "out3"), 5);
+}
+
+} // anonymous namespace
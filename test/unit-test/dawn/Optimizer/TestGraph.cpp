@@ -150,4 +150,30 @@ TEST(GraphTest, computeIDsWithCycle) {
   EXPECT_TRUE((std::equal(ids.begin(), ids.end(), ref.begin())));
 }
 
+TEST(GraphTest, LargeSyntheticGraph) {
+  // Every vertex writes to the next `numEdges` vertices and every edge is inserted `numDuplicates`
+  // times (which are merged into the existing edge)
+  const int numVertices = 2000;
+  const int numEdges = 32;
+  const int numDuplicates = 4;
+
+  TestGraph graph;
+  for(int duplicate = 0; duplicate < numDuplicates; ++duplicate)
+    for(int from = 0; from < numVertices; ++from)
+      for(int i = 1; i <= numEdges; ++i)
+        graph.insertEdge(from, (from + i) % numVertices);
+
+  std::size_t numInsertedEdges = 0;
+  for(std::size_t VertexID = 0; VertexID < graph.getNumVertices(); ++VertexID) {
+    numInsertedEdges += graph.getAdjacencyList()[VertexID].size();
+    EXPECT_EQ(graph.getVertexIDFromValue(graph.getValueFromVertexID(VertexID)), VertexID);
+  }
+
+  EXPECT_EQ(graph.getNumVertices(), 2000u);
+  EXPECT_EQ(numInsertedEdges, 2000u * 32u);
+  EXPECT_TRUE(graph.hasEdge(0, numEdges));
+  EXPECT_FALSE(graph.hasEdge(0, numEdges + 1));
+  EXPECT_FALSE(graph.hasEdge(0, numVertices));
+}
+
 } // anonymous namespace
@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_TEST_UNITTEST_DAWN_OPTIMIZER_TESTUTILS_H
+#define DAWN_TEST_UNITTEST_DAWN_OPTIMIZER_TESTUTILS_H
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/SIR/ASTStringifier.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Unittest/ASTSimplifier.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+/// @brief Fixture of the tests running the optimizer on in-memory SIRs
+class OptimizerTest : public ::testing::Test {
+protected:
+  /// @brief Build a SIR of the stencil `name` consisting of a single vertical region over the
+  /// whole domain
+  ///
+  /// The fields listed in `temporaries` are declared as temporaries.
+  static std::shared_ptr<SIR> makeStencilSIR(const std::string& name,
+                                             const std::vector<std::string>& fields,
+                                             const std::shared_ptr<BlockStmt>& body,
+                                             const std::vector<std::string>& temporaries = {}) {
+    auto stencil = std::make_shared<sir::Stencil>();
+    stencil->Name = name;
+    for(const std::string& fieldName : fields)
+      stencil->Fields.emplace_back(std::make_shared<sir::Field>(fieldName));
+    for(const std::string& fieldName : temporaries) {
+      stencil->Fields.emplace_back(std::make_shared<sir::Field>(fieldName));
+      stencil->Fields.back()->IsTemporary = true;
+    }
+
+    auto vr = std::make_shared<sir::VerticalRegion>(
+        std::make_shared<AST>(body),
+        std::make_shared<sir::Interval>(sir::Interval::Start, sir::Interval::End),
+        sir::VerticalRegion::LK_Forward);
+    stencil->StencilDescAst = std::make_shared<AST>(astgen::block(astgen::verticalRegion(vr)));
+
+    auto sir = std::make_shared<SIR>();
+    sir->Stencils.emplace_back(stencil);
+    return sir;
+  }
+
+  /// @brief Stringified statements of all the Do-Methods of the (first) stencil of `sir`
+  /// optimized by `compiler`
+  ///
+  /// @returns an empty vector if the optimizer failed
+  static std::vector<std::string> runOptimizer(DawnCompiler& compiler,
+                                               const std::shared_ptr<SIR>& sir) {
+    std::unique_ptr<OptimizerContext> optimizer = compiler.runOptimizer(sir);
+    if(!optimizer)
+      return {};
+    const auto& instantiation =
+        optimizer->getStencilInstantiationMap().at(sir->Stencils.front()->Name);
+
+    std::vector<std::string> statements;
+    for(const auto& stmtAccessesPair :
+        iterateIIROver<iir::StatementAccessesPair>(*(instantiation->getIIR())))
+      statements.push_back(
+          ASTStringifer::toString(stmtAccessesPair->getStatement()->ASTStmt, 0, false));
+    return statements;
+  }
+
+  static std::vector<std::string> runOptimizer(const Options& options,
+                                               const std::shared_ptr<SIR>& sir) {
+    Options compilerOptions = options;
+    DawnCompiler compiler(&compilerOptions);
+    return runOptimizer(compiler, sir);
+  }
+
+  /// @brief Number of occurrences of `str` in `statements`
+  static int count(const std::vector<std::string>& statements, const std::string& str) {
+    int n = 0;
+    for(const auto& stmt : statements)
+      for(auto pos = stmt.find(str); pos != std::string::npos; pos = stmt.find(str, pos + 1))
+        ++n;
+    return n;
+  }
+
+  /// @brief Position of the first statement containing `str` (-1 if there is none)
+  static int find(const std::vector<std::string>& statements, const std::string& str) {
+    for(std::size_t i = 0; i < statements.size(); ++i)
+      if(statements[i].find(str) != std::string::npos)
+        return i;
+    return -1;
+  }
+};
+
+} // namespace dawn
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "dawn/SIR/AST.h"
 #include "dawn/SIR/ASTUtil.h"
+#include "dawn/Support/Arena.h"
 #include "dawn/Support/Casting.h"
 #include "dawn/Support/STLExtras.h"
 #include <gtest/gtest.h>
@@ -219,6 +220,37 @@ TEST_F(ASTTest, Clone) {
   EXPECT_NE(*expr_FieldAccessExpr, *expr_LiteralAccessExpr);
 }
 
+TEST_F(ASTTest, CloneInArena) {
+  Arena arena;
+  std::shared_ptr<Stmt> clone_IfStmt;
+  std::shared_ptr<Expr> clone_TernaryOperator;
+  {
+    ArenaScope scope(&arena);
+    clone_IfStmt = castAs<Stmt>(stmt_IfStmt)->clone();
+    clone_TernaryOperator = castAs<Expr>(expr_TernaryOperator)->clone();
+  }
+  EXPECT_GT(arena.getBytesInUse(), 0);
+  EXPECT_EQ(*stmt_IfStmt, *clone_IfStmt);
+  EXPECT_EQ(*expr_TernaryOperator, *clone_TernaryOperator);
+
+  // The released clones return their memory to the arena, the next clones reuse it
+  std::size_t chunks = arena.getNumChunks();
+  for(int i = 0; i < 1000; ++i) {
+    clone_IfStmt.reset();
+    clone_TernaryOperator.reset();
+    EXPECT_EQ(arena.getBytesInUse(), 0);
+
+    ArenaScope scope(&arena);
+    clone_IfStmt = castAs<Stmt>(stmt_IfStmt)->clone();
+    clone_TernaryOperator = castAs<Expr>(expr_TernaryOperator)->clone();
+  }
+  EXPECT_EQ(arena.getNumChunks(), chunks);
+  EXPECT_EQ(*stmt_IfStmt, *clone_IfStmt);
+  clone_IfStmt.reset();
+  clone_TernaryOperator.reset();
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+}
+
 TEST_F(ASTTest, ReplaceExpr) {
   auto foo_var = std::make_shared<VarAccessExpr>("foo");
 
@@ -0,0 +1,133 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/Arena.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+TEST(ArenaTest, Allocate) {
+  Arena arena(1024);
+  EXPECT_EQ(arena.getNumChunks(), 0);
+
+  void* p1 = arena.allocate(3, 1);
+  void* p2 = arena.allocate(8, 8);
+  void* p3 = arena.allocate(16, 16);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p2) % 8, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p3) % 16, 0);
+  EXPECT_NE(p1, p2);
+  EXPECT_NE(p2, p3);
+  EXPECT_EQ(arena.getBytesAllocated(), 27);
+  EXPECT_EQ(arena.getNumChunks(), 1);
+
+  arena.deallocate(p1, 3, 1);
+  arena.deallocate(p2, 8, 8);
+  arena.deallocate(p3, 16, 16);
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+  EXPECT_EQ(arena.getBytesAllocated(), 27);
+}
+
+TEST(ArenaTest, Oversized) {
+  Arena arena(1024);
+  char* small = static_cast<char*>(arena.allocate(16, 8));
+  void* oversized = arena.allocate(4096, 8);
+  EXPECT_EQ(arena.getNumChunks(), 2);
+
+  // The oversized chunk does not replace the current one
+  char* next = static_cast<char*>(arena.allocate(16, 8));
+  EXPECT_EQ(next, small + 16);
+  EXPECT_EQ(arena.getNumChunks(), 2);
+
+  // Exhausting the current chunk opens a new one
+  void* last = arena.allocate(1000, 8);
+  EXPECT_EQ(arena.getNumChunks(), 3);
+
+  arena.deallocate(small, 16, 8);
+  arena.deallocate(oversized, 4096, 8);
+  arena.deallocate(next, 16, 8);
+  arena.deallocate(last, 1000, 8);
+}
+
+TEST(ArenaTest, Recycle) {
+  Arena arena(1024);
+  void* p1 = arena.allocate(24, 8);
+  void* p2 = arena.allocate(40, 8);
+  EXPECT_EQ(arena.getBytesInUse(), 64);
+
+  // Released blocks are handed out again to allocations of the same size class
+  arena.deallocate(p1, 24, 8);
+  arena.deallocate(p2, 40, 8);
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+  EXPECT_EQ(arena.allocate(30, 16), p1);
+  EXPECT_EQ(arena.allocate(44, 4), p2);
+  void* p3 = arena.allocate(24, 8);
+  EXPECT_NE(p3, p1);
+
+  // Large blocks are not recycled
+  void* large = arena.allocate(Arena::MaxRecycledSize + 1, 8);
+  arena.deallocate(large, Arena::MaxRecycledSize + 1, 8);
+  void* large2 = arena.allocate(Arena::MaxRecycledSize + 1, 8);
+  EXPECT_NE(large2, large);
+  EXPECT_EQ(arena.getBytesInUse(), 30 + 44 + 24 + Arena::MaxRecycledSize + 1);
+  EXPECT_EQ(arena.getBytesAllocated(), 64 + 98 + 2 * (Arena::MaxRecycledSize + 1));
+
+  arena.deallocate(p1, 30, 16);
+  arena.deallocate(p2, 44, 4);
+  arena.deallocate(p3, 24, 8);
+  arena.deallocate(large2, Arena::MaxRecycledSize + 1, 8);
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+}
+
+TEST(ArenaTest, MakeArenaShared) {
+  std::shared_ptr<int> heapInt = makeArenaShared<int>(1);
+  EXPECT_EQ(*heapInt, 1);
+  EXPECT_FALSE(ArenaScope::getCurrentArena());
+
+  Arena arena;
+  std::shared_ptr<int> arenaInt;
+  {
+    ArenaScope scope(&arena);
+    EXPECT_EQ(ArenaScope::getCurrentArena(), &arena);
+    arenaInt = makeArenaShared<int>(2);
+    {
+      ArenaScope heapScope(nullptr);
+      EXPECT_FALSE(ArenaScope::getCurrentArena());
+      std::size_t bytes = arena.getBytesAllocated();
+      EXPECT_EQ(*makeArenaShared<int>(3), 3);
+      EXPECT_EQ(arena.getBytesAllocated(), bytes);
+    }
+    EXPECT_EQ(ArenaScope::getCurrentArena(), &arena);
+  }
+  EXPECT_FALSE(ArenaScope::getCurrentArena());
+  EXPECT_EQ(*arenaInt, 2);
+  EXPECT_GT(arena.getBytesInUse(), 0);
+
+  // Destroyed objects return their memory to the arena, which reuses it
+  std::size_t bytes = arena.getBytesInUse();
+  const int* address = arenaInt.get();
+  arenaInt.reset();
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+  {
+    ArenaScope scope(&arena);
+    arenaInt = makeArenaShared<int>(4);
+  }
+  EXPECT_EQ(arenaInt.get(), address);
+  EXPECT_EQ(arena.getBytesInUse(), bytes);
+  arenaInt.reset();
+}
+
+} // anonymous namespace
@@ -0,0 +1,93 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/SmallIntMap.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+template <typename MapType>
+std::vector<int> keys(const MapType& map) {
+  std::vector<int> res;
+  for(const auto& pair : map)
+    res.push_back(pair.first);
+  return res;
+}
+
+TEST(SmallIntMapTest, InsertAndFind) {
+  SmallIntMap<std::string, 2> map;
+  EXPECT_TRUE(map.empty());
+
+  EXPECT_TRUE(map.emplace(5, "five").second);
+  EXPECT_TRUE(map.emplace(1, "one").second);
+  EXPECT_TRUE(map.insert(std::make_pair(3, std::string("three"))).second);
+  EXPECT_FALSE(map.emplace(3, "drei").second);
+  map[7] = "seven";
+
+  EXPECT_EQ(map.size(), 4);
+  EXPECT_EQ(keys(map), (std::vector<int>{1, 3, 5, 7}));
+  EXPECT_EQ(map.at(3), "three");
+  EXPECT_EQ(map.count(5), 1);
+  EXPECT_EQ(map.count(4), 0);
+  EXPECT_TRUE(map.find(4) == map.end());
+
+  EXPECT_EQ(map.erase(5), 1);
+  EXPECT_EQ(map.erase(5), 0);
+  EXPECT_EQ(map.erase(map.find(1))->first, 3);
+  EXPECT_EQ(keys(map), (std::vector<int>{3, 7}));
+}
+
+TEST(SmallIntMapTest, InsertRange) {
+  SmallIntMap<int> map{{4, 40}, {2, 20}};
+  std::vector<std::pair<int, int>> unsorted{{3, 30}, {2, 0}, {1, 10}, {3, 0}};
+  map.insert(unsorted.begin(), unsorted.end());
+
+  // Existing keys and the first occurrence in the range win
+  EXPECT_EQ(keys(map), (std::vector<int>{1, 2, 3, 4}));
+  EXPECT_EQ(map.at(2), 20);
+  EXPECT_EQ(map.at(3), 30);
+
+  SmallIntMap<int> other{{0, 0}, {4, 0}, {5, 50}};
+  map.insert(other.begin(), other.end());
+  EXPECT_EQ(keys(map), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(map.at(4), 40);
+}
+
+TEST(SmallIntMapTest, Merge) {
+  SmallIntMap<int> map{{1, 1}, {3, 3}, {8, 8}};
+  SmallIntMap<int, 8> other{{0, 100}, {3, 300}, {5, 500}, {8, 800}, {9, 900}};
+  map.merge(other, [](int& a, const int& b) { a += b; });
+
+  EXPECT_EQ(keys(map), (std::vector<int>{0, 1, 3, 5, 8, 9}));
+  EXPECT_EQ(map.at(0), 100);
+  EXPECT_EQ(map.at(1), 1);
+  EXPECT_EQ(map.at(3), 303);
+  EXPECT_EQ(map.at(5), 500);
+  EXPECT_EQ(map.at(8), 808);
+  EXPECT_EQ(map.at(9), 900);
+
+  SmallIntMap<int> copy(map);
+  EXPECT_TRUE(copy == map);
+  copy.merge(SmallIntMap<int>(), [](int& a, const int& b) { a += b; });
+  EXPECT_TRUE(copy == map);
+  copy[1] = 2;
+  EXPECT_TRUE(copy != map);
+}
+
+} // anonymous namespace
@@ -0,0 +1,80 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#include "dawn/Support/UIDGenerator.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+TEST(UIDGeneratorTest, Unique) {
+  std::set<int> ids;
+  for(int i = 0; i < 100; ++i) {
+    int id = UIDGenerator::getInstance()->get();
+    EXPECT_GT(id, 0);
+    EXPECT_TRUE(ids.insert(id).second);
+  }
+}
+
+TEST(UIDGeneratorTest, Scope) {
+  int first = UIDGenerator::getInstance()->reserve(3);
+  {
+    UIDScope scope(first, 3);
+    EXPECT_EQ(UIDGenerator::getInstance()->get(), first);
+    {
+      // Nested ranges are reserved from the range of the current scope
+      int nestedFirst = UIDGenerator::getInstance()->reserve(1);
+      EXPECT_EQ(nestedFirst, first + 1);
+      UIDScope nestedScope(nestedFirst, 1);
+      EXPECT_EQ(UIDGenerator::getInstance()->get(), nestedFirst);
+      EXPECT_EQ(nestedScope.getNumRemaining(), 0);
+      EXPECT_FALSE(nestedScope.isExhausted());
+    }
+    EXPECT_EQ(UIDGenerator::getInstance()->get(), first + 2);
+    EXPECT_EQ(scope.getNumRemaining(), 0);
+    EXPECT_FALSE(scope.isExhausted());
+
+    // Exhausted scopes fall back to the shared counter
+    EXPECT_GE(UIDGenerator::getInstance()->get(), first + 3);
+    EXPECT_TRUE(scope.isExhausted());
+  }
+  EXPECT_GE(UIDGenerator::getInstance()->get(), first + 3);
+}
+
+TEST(UIDGeneratorTest, ConcurrentScopes) {
+  const int numThreads = 4, numIDs = 1000;
+  int first = UIDGenerator::getInstance()->reserve(numThreads * numIDs);
+
+  std::vector<std::vector<int>> ids(numThreads);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < numThreads; ++t)
+    threads.emplace_back([&, t]() {
+      UIDScope scope(first + t * numIDs, numIDs);
+      for(int i = 0; i < numIDs; ++i)
+        ids[t].push_back(UIDGenerator::getInstance()->get());
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  for(int t = 0; t < numThreads; ++t)
+    for(int i = 0; i < numIDs; ++i)
+      EXPECT_EQ(ids[t][i], first + t * numIDs + i);
+}
+
+} // anonymous namespace